@@ -31,6 +31,10 @@ uniform int entity_position_x;
 uniform int entity_position_z;
 uniform float opacity;
 uniform sampler2D tex_image;
+// tree materials share one texture array, texture_layer picks the image in it
+// and is -1 for everything drawn with tex_image
+uniform sampler2DArray tex_array;
+uniform int texture_layer;
 
 uniform bool use_texture;
 
@@ -61,6 +65,7 @@ struct ColorComponents {
 };
 
 vec4 calculateColor(vec3 ambientColor);
+vec4 sampleTexture();
 ColorComponents calculateColor(
     const vec3 light_dir,
     const vec3 light_color,
@@ -98,7 +103,7 @@ void main()
             break;
         case COLOR_UNLIT_TEXTURE:
                     //Does not give light effects
-            color = texture(tex_image, tex_coord);
+            color = sampleTexture();
             break;
         case COLOR_LIGHTING:
             // inspired by tutorial at: https://learnopengl.com/#!Lighting/Basic-Lighting
@@ -115,13 +120,13 @@ void main()
             break;
         case COLOR_SKY_TEXTURE:
             color = vec4(mix(
-                vec3(texture(tex_image, tex_coord)),
+                vec3(sampleTexture()),
                 fog_color,
                 nighttime_value * 0.2 + 0.8
             ), 1);
             break;
         case COLOR_FONT:
-            vec4 texel = texture(tex_image, tex_coord);
+            vec4 texel = sampleTexture();
             if(texel.a < 0.5)
                 discard;
             color = texel;
@@ -172,7 +177,7 @@ vec4 calculateColor(vec3 ambientColor){
     if (use_texture) {
        // multiply components against texture value but only if we've
        // got a texture!
-       vec3 tex3 = vec3(texture(tex_image, tex_coord));
+       vec3 tex3 = vec3(sampleTexture());
        ambientValue *= tex3;
        diffuseValue *= tex3;
     }
@@ -180,6 +185,13 @@ vec4 calculateColor(vec3 ambientColor){
     return vec4(mix(fog_color, ambientValue + diffuseValue + specularValue, fog), opacity);
 }
 
+vec4 sampleTexture(){
+    if (texture_layer >= 0) {
+        return texture(tex_array, vec3(tex_coord, texture_layer));
+    }
+    return texture(tex_image, tex_coord);
+}
+
 // compute the basic color without considering attenuation or texture multiplication
 ColorComponents calculateColor(
     const vec3 light_dir,
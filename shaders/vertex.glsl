@@ -3,23 +3,131 @@
 in vec3 v_position;
 in vec3 normal;
 in vec2 tex_coord_in;
+// per instance model matrix, see TreePrototypeCache::flush
+in mat4 instance_model;
 
 uniform mat4 mvp_matrix;
 uniform mat4 model;
+uniform mat4 view_projection;
+uniform bool use_instancing;
+uniform bool use_leaf_instancing;
+// per leaf placement on its tree, the three rows of a mat4x3 for each leaf, see LeafAB and
+// TreePrototypeCache::bindLeaves
+uniform samplerBuffer leaf_models;
+uniform int leaf_count;
+// rocks are one shared mesh each, shaped here by a seed of their own, see Rock and RockB
+uniform int displacement_type;
+uniform uint displacement_seed;
+
+const int DISPLACE_NONE = 0;
+const int DISPLACE_JITTER = 1;
+const int DISPLACE_RADIAL = 2;
+
+// noise lattice points per unit of the mesh. Rock's vertices are a quarter apart and sit on the
+// lattice, RockB's are a fifth to a third apart and mostly between lattice points
+const float JITTER_CELLS = 4.0;
+const float RADIAL_CELLS = 8.0;
 
 out vec3 pos;
 out vec3 worldPos;
 out vec3 worldNormal;
 out vec2 tex_coord;
 
+uint hash(uint x)
+{
+    x ^= x >> 16;
+    x *= 0x7feb352du;
+    x ^= x >> 15;
+    x *= 0x846ca68bu;
+    x ^= x >> 16;
+    return x;
+}
+
+// 0 to 1 for a lattice point, the same on every draw of the same seed
+float lattice(ivec3 point, uint channel)
+{
+    uint h = hash(displacement_seed ^ hash(uint(point.x) + hash(uint(point.y) + hash(uint(point.z) + channel))));
+    return float(h >> 8) / 16777216.0;
+}
+
+// the lattice values blended linearly, so a vertex on a lattice point gets exactly its value
+float valueNoise(vec3 p, uint channel)
+{
+    vec3 cell = floor(p);
+    vec3 t = p - cell;
+    ivec3 i = ivec3(cell);
+    float x00 = mix(lattice(i, channel), lattice(i + ivec3(1, 0, 0), channel), t.x);
+    float x10 = mix(lattice(i + ivec3(0, 1, 0), channel), lattice(i + ivec3(1, 1, 0), channel), t.x);
+    float x01 = mix(lattice(i + ivec3(0, 0, 1), channel), lattice(i + ivec3(1, 0, 1), channel), t.x);
+    float x11 = mix(lattice(i + ivec3(0, 1, 1), channel), lattice(i + ivec3(1, 1, 1), channel), t.x);
+    return mix(mix(x00, x10, t.y), mix(x01, x11, t.y), t.z);
+}
+
+float noiseCells()
+{
+    return displacement_type == DISPLACE_JITTER ? JITTER_CELLS : RADIAL_CELLS;
+}
+
+vec3 displace(vec3 p)
+{
+    vec3 cells = p * noiseCells();
+    if (displacement_type == DISPLACE_JITTER) {
+        // what Rock's rand() jitter was, -0.13 to 0.12 on each axis
+        vec3 jitter = vec3(valueNoise(cells, 0u), valueNoise(cells, 1u), valueNoise(cells, 2u));
+        return p + (jitter * 25.0 - 13.0) / 100.0;
+    }
+    // what RockB's rand() scale was, 0.5 to 0.7 and up to 1 on the negative x side
+    float scale = p.x * valueNoise(cells, 0u);
+    if (scale < 0.5 && scale > -0.5) {
+        scale = 0.5;
+    }
+    scale = abs(min(scale, 0.7));
+    return p * scale;
+}
+
 void main()
 {
-    pos = v_position;
-    worldPos = vec3(model * vec4(v_position, 1.0));
-    gl_Position = mvp_matrix * vec4(v_position, 1.0);
+    mat4 model_matrix = use_instancing ? instance_model : model;
+
+    // leaves are the shared leaf mesh placed on the tree first
+    vec3 local_position = v_position;
+    vec3 local_normal = normal;
+    if (displacement_type != DISPLACE_NONE) {
+        // the normal follows the displacement's jacobian, from central differences half a cell wide
+        float h = 0.5 / noiseCells();
+        mat3 jacobian = mat3(
+            displace(v_position + vec3(h, 0.0, 0.0)) - displace(v_position - vec3(h, 0.0, 0.0)),
+            displace(v_position + vec3(0.0, h, 0.0)) - displace(v_position - vec3(0.0, h, 0.0)),
+            displace(v_position + vec3(0.0, 0.0, h)) - displace(v_position - vec3(0.0, 0.0, h))
+        ) / (2.0 * h);
+        local_position = displace(v_position);
+        // where the noise folds the surface over, keep the side the normal was on
+        local_normal = sign(determinant(jacobian)) * (transpose(inverse(jacobian)) * normal);
+    }
+    if (use_leaf_instancing) {
+        // a tree's leaves are leaf_count consecutive instances, see TreePrototypeCache::flush
+        int leaf = gl_InstanceID % leaf_count * 3;
+        mat4x3 leaf_model = transpose(mat3x4(
+            texelFetch(leaf_models, leaf),
+            texelFetch(leaf_models, leaf + 1),
+            texelFetch(leaf_models, leaf + 2)
+        ));
+        mat3 leaf_axes = mat3(leaf_model);
+        local_position = leaf_model * vec4(v_position, 1.0);
+        // the axes aren't orthonormal and may mirror the leaf, keep the side it faces
+        local_normal = sign(determinant(leaf_axes)) * (transpose(inverse(leaf_axes)) * normal);
+    }
+
+    pos = local_position;
+    worldPos = vec3(model_matrix * vec4(local_position, 1.0));
+    if (use_instancing) {
+        gl_Position = view_projection * vec4(worldPos, 1.0);
+    } else {
+        gl_Position = mvp_matrix * vec4(local_position, 1.0);
+    }
 
     // transform normal to world space coordinates
     // https://learnopengl.com/#!Lighting/Basic-Lighting
-    worldNormal = mat3(transpose(inverse(model))) * normal;
+    worldNormal = mat3(transpose(inverse(model_matrix))) * local_normal;
     tex_coord = tex_coord_in;
 }
@@ -5,6 +5,7 @@
 #include <iostream>
 
 #include "entities/DrawableEntity.hpp"
+#include "MeshBounds.hpp"
 #include "HitBox2d.hpp"
 
 HitBox2d::HitBox2d(const DrawableEntity& entity, const float& min_y, const float& max_y)
@@ -12,6 +13,12 @@ HitBox2d::HitBox2d(const DrawableEntity& entity, const float& min_y, const float
 {
 	glm::vec3 v;
 	const glm::mat4& model_matrix = entity.getModelMatrix();
+	const MeshBounds* bounds = entity.getMeshBounds();
+	if (bounds) {
+		bounds->extend(model_matrix, min_y, max_y,
+		               &this->world_min_x, &this->world_min_z, &this->world_max_x, &this->world_max_z);
+		return;
+	}
     for (const glm::vec3& vertex : entity.getVertices()) {
         	v = glm::vec3(model_matrix * glm::vec4(vertex, 1.0f));
         	if (v.y < min_y || v.y > max_y) {
@@ -47,6 +54,14 @@ bool HitBox2d::collidesWith(const HitBox2d& box) const
 	return r;
 }
 
+void HitBox2d::translate(const float& x, const float& z)
+{
+	this->world_min_x += x;
+	this->world_min_z += z;
+	this->world_max_x += x;
+	this->world_max_z += z;
+}
+
 std::ostream& operator<<(std::ostream& os, const HitBox2d& box)
 {
 	os << "BL: (" << box.world_min_x << ", " << box.world_min_z << "), ";
@@ -15,6 +15,8 @@
 
 class HitBox2d {
 	friend std::ostream& operator<<(std::ostream& os, const HitBox2d& box);
+	friend class HitBoxGrid;
+	friend class HitBoxBatch;
 private:
 	float world_min_x;
 	float world_min_z;
@@ -24,6 +26,7 @@ public:
 	explicit HitBox2d(const DrawableEntity& entity, const float& min_y = -FLT_MAX, const float& max_y = FLT_MAX);
 	HitBox2d(const float& min_x, const float& min_z, const float& max_x, const float& max_z);
 	bool collidesWith(const HitBox2d& box) const;
+	void translate(const float& x, const float& z);
 };
 
 
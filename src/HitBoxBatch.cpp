@@ -0,0 +1,183 @@
+#include <glm/glm.hpp>
+#include <algorithm>
+#include <vector>
+#include <cstddef>
+#include <cfloat>
+#include <cmath>
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+#include "HitBox2d.hpp"
+#include "HitBoxBatch.hpp"
+
+constexpr size_t HitBoxBatch::lanes;
+
+void HitBoxBatch::pad(const size_t& i)
+{
+	// an inside out box, every test against it is false
+	this->min_x[i] = FLT_MAX;
+	this->min_z[i] = FLT_MAX;
+	this->max_x[i] = -FLT_MAX;
+	this->max_z[i] = -FLT_MAX;
+}
+
+void HitBoxBatch::add(const HitBox2d& box)
+{
+	if (this->count == this->min_x.size()) {
+		const size_t padded = this->count + HitBoxBatch::lanes;
+		this->min_x.resize(padded);
+		this->min_z.resize(padded);
+		this->max_x.resize(padded);
+		this->max_z.resize(padded);
+		for (size_t i = this->count; i < padded; i++) {
+			this->pad(i);
+		}
+	}
+	this->min_x[this->count] = box.world_min_x;
+	this->min_z[this->count] = box.world_min_z;
+	this->max_x[this->count] = box.world_max_x;
+	this->max_z[this->count] = box.world_max_z;
+	this->count++;
+}
+
+void HitBoxBatch::erase(const size_t& i)
+{
+	const size_t last = --this->count;
+	this->min_x[i] = this->min_x[last];
+	this->min_z[i] = this->min_z[last];
+	this->max_x[i] = this->max_x[last];
+	this->max_z[i] = this->max_z[last];
+	this->pad(last);
+	if (this->min_x.size() - this->count >= 2 * HitBoxBatch::lanes) {
+		const size_t padded = this->min_x.size() - HitBoxBatch::lanes;
+		this->min_x.resize(padded);
+		this->min_z.resize(padded);
+		this->max_x.resize(padded);
+		this->max_z.resize(padded);
+	}
+}
+
+size_t HitBoxBatch::size() const
+{
+	return this->count;
+}
+
+bool HitBoxBatch::empty() const
+{
+	return this->count == 0;
+}
+
+unsigned int HitBoxBatch::hitMask(const HitBox2d& box, const size_t& first) const
+{
+#ifdef __SSE2__
+	const __m128 hit = _mm_and_ps(
+		_mm_and_ps(_mm_cmplt_ps(_mm_loadu_ps(&this->min_x[first]), _mm_set1_ps(box.world_max_x)),
+		           _mm_cmpgt_ps(_mm_loadu_ps(&this->max_x[first]), _mm_set1_ps(box.world_min_x))),
+		_mm_and_ps(_mm_cmplt_ps(_mm_loadu_ps(&this->min_z[first]), _mm_set1_ps(box.world_max_z)),
+		           _mm_cmpgt_ps(_mm_loadu_ps(&this->max_z[first]), _mm_set1_ps(box.world_min_z)))
+	);
+	return (unsigned int)_mm_movemask_ps(hit);
+#else
+	unsigned int mask = 0;
+	for (size_t lane = 0; lane < HitBoxBatch::lanes; lane++) {
+		const size_t i = first + lane;
+		const bool hit = this->min_x[i] < box.world_max_x &&
+				this->max_x[i] > box.world_min_x &&
+				this->min_z[i] < box.world_max_z &&
+				this->max_z[i] > box.world_min_z;
+		mask |= (unsigned int)hit << lane;
+	}
+	return mask;
+#endif
+}
+
+size_t HitBoxBatch::firstHit(const HitBox2d& box, const size_t& from) const
+{
+	for (size_t first = from - from % HitBoxBatch::lanes; first < this->count; first += HitBoxBatch::lanes) {
+		// lanes before from don't count
+		unsigned int mask = this->hitMask(box, first);
+		if (first < from) {
+			mask &= ~0u << (from - first);
+		}
+		if (mask) {
+			size_t lane = 0;
+			while (!(mask >> lane & 1u)) {
+				lane++;
+			}
+			// padding never hits, so this is below count
+			return first + lane;
+		}
+	}
+	return this->count;
+}
+
+namespace {
+
+// when (as a fraction of motion) box_min..box_max starts and stops overlapping min..max along one
+// axis, false if it never does
+bool slab(
+	const float& box_min,
+	const float& box_max,
+	const float& min,
+	const float& max,
+	const float& motion,
+	float* entry,
+	float* exit
+) {
+	if (motion > 0.0f) {
+		*entry = (min - box_max) / motion;
+		*exit = (max - box_min) / motion;
+	} else if (motion < 0.0f) {
+		*entry = (max - box_min) / motion;
+		*exit = (min - box_max) / motion;
+	} else if (box_min < max && box_max > min) {
+		*entry = -INFINITY;
+		*exit = INFINITY;
+	} else {
+		return false;
+	}
+	return true;
+}
+
+}
+
+float HitBoxBatch::sweep(const HitBox2d& box, const glm::vec2& motion, glm::vec2* normal, const float& before) const
+{
+	float first = before;
+	for (size_t i = 0; i < this->count; i++) {
+		float entry_x, exit_x, entry_z, exit_z;
+		if (!slab(box.world_min_x, box.world_max_x, this->min_x[i], this->max_x[i], motion.x, &entry_x, &exit_x) ||
+		    !slab(box.world_min_z, box.world_max_z, this->min_z[i], this->max_z[i], motion.y, &entry_z, &exit_z)) {
+			continue;
+		}
+		const float entry = std::max(entry_x, entry_z);
+		const float exit = std::min(exit_x, exit_z);
+		// only touching (like HitBox2d::collidesWith), past it or not reached this step
+		if (entry >= exit || exit <= 0.0f || entry >= first) {
+			continue;
+		}
+
+		if (entry > 0.0f) {
+			first = entry;
+			*normal = entry_x > entry_z ? glm::vec2(motion.x > 0.0f ? -1.0f : 1.0f, 0.0f)
+			                            : glm::vec2(0.0f, motion.y > 0.0f ? -1.0f : 1.0f);
+			continue;
+		}
+
+		// already in it: out through the nearest side is allowed, anything else stops here
+		const float out_x = std::min(box.world_max_x - this->min_x[i], this->max_x[i] - box.world_min_x);
+		const float out_z = std::min(box.world_max_z - this->min_z[i], this->max_z[i] - box.world_min_z);
+		glm::vec2 side;
+		if (out_x < out_z) {
+			side = glm::vec2(box.world_max_x - this->min_x[i] < this->max_x[i] - box.world_min_x ? -1.0f : 1.0f, 0.0f);
+		} else {
+			side = glm::vec2(0.0f, box.world_max_z - this->min_z[i] < this->max_z[i] - box.world_min_z ? -1.0f : 1.0f);
+		}
+		if (motion.x * side.x + motion.y * side.y < 0.0f) {
+			first = 0.0f;
+			*normal = side;
+		}
+	}
+	return first;
+}
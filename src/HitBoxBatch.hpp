@@ -0,0 +1,45 @@
+#ifndef PROCEDURALWORLD_HITBOXBATCH_HPP
+#define PROCEDURALWORLD_HITBOXBATCH_HPP
+
+#include <glm/glm.hpp>
+#include <vector>
+#include <cstddef>
+
+#include "HitBox2d.hpp"
+
+// Hit boxes kept as one array per side, so that a box can be tested against four of them at a
+// time (SSE2, one at a time without it). The arrays are padded to a multiple of four with boxes
+// nothing collides with, which the tests run over like any other.
+
+class HitBoxBatch {
+public:
+	static constexpr size_t lanes = 4;
+
+	void add(const HitBox2d& box);
+	// moves the last box into i, so the order of the boxes isn't kept
+	void erase(const size_t& i);
+	size_t size() const;
+	bool empty() const;
+
+	// index of the first box from `from` on that collides with box (as HitBox2d::collidesWith),
+	// size() if none does
+	size_t firstHit(const HitBox2d& box, const size_t& from = 0) const;
+	// bit i set for each of the boxes at first + i, i < lanes, that collides with box.
+	// first has to be a multiple of lanes
+	unsigned int hitMask(const HitBox2d& box, const size_t& first) const;
+	// how far along motion (0 to 1) box gets before it runs into one of the boxes, or before `before`
+	// if that's sooner. when it runs into one, normal is set to the x-z side it hit (pointing
+	// back at box). a box that box already overlaps only stops it, at 0, if motion goes further in
+	float sweep(const HitBox2d& box, const glm::vec2& motion, glm::vec2* normal, const float& before = 1.0f) const;
+
+private:
+	std::vector<float> min_x;
+	std::vector<float> min_z;
+	std::vector<float> max_x;
+	std::vector<float> max_z;
+	size_t count = 0;
+
+	void pad(const size_t& i);
+};
+
+#endif //PROCEDURALWORLD_HITBOXBATCH_HPP
@@ -0,0 +1,163 @@
+#include <glm/glm.hpp>
+#include <algorithm>
+#include <vector>
+#include <unordered_map>
+#include <cstdint>
+#include <cmath>
+
+#include "HitBox2d.hpp"
+#include "HitBoxBatch.hpp"
+#include "HitBoxGrid.hpp"
+
+constexpr float HitBoxGrid::default_cell_size;
+
+HitBoxGrid::HitBoxGrid(const float& cell_size) : cell_size(cell_size) {}
+
+int64_t HitBoxGrid::cellKey(const int& x, const int& z)
+{
+	return (int64_t)((uint64_t)(uint32_t)x << 32 | (uint32_t)z);
+}
+
+bool HitBoxGrid::cellRange(const HitBox2d& box, int* min_x, int* min_z, int* max_x, int* max_z) const
+{
+	// HitBox2d::collidesWith is strict, a box without area on either axis never hits
+	if (!(box.world_min_x < box.world_max_x && box.world_min_z < box.world_max_z)) {
+		return false;
+	}
+	*min_x = (int)std::floor(box.world_min_x / this->cell_size);
+	*min_z = (int)std::floor(box.world_min_z / this->cell_size);
+	*max_x = (int)std::floor(box.world_max_x / this->cell_size);
+	*max_z = (int)std::floor(box.world_max_z / this->cell_size);
+	return true;
+}
+
+void HitBoxGrid::insert(const HitBox2d& box, const void* owner)
+{
+	int min_x, min_z, max_x, max_z;
+	if (!this->cellRange(box, &min_x, &min_z, &max_x, &max_z)) {
+		return;
+	}
+	std::vector<int64_t>& keys = this->owner_cells[owner];
+	for (int x = min_x; x <= max_x; x++) {
+		for (int z = min_z; z <= max_z; z++) {
+			const int64_t key = HitBoxGrid::cellKey(x, z);
+			Cell& cell = this->cells[key];
+			cell.boxes.add(box);
+			cell.owners.push_back(owner);
+			keys.push_back(key);
+		}
+	}
+}
+
+void HitBoxGrid::remove(const void* owner)
+{
+	auto found = this->owner_cells.find(owner);
+	if (found == this->owner_cells.end()) {
+		return;
+	}
+	for (const int64_t& key : found->second) {
+		auto cell = this->cells.find(key);
+		if (cell == this->cells.end()) {
+			// already emptied by an earlier key
+			continue;
+		}
+		std::vector<const void*>& owners = cell->second.owners;
+		for (size_t i = owners.size(); i-- > 0;) {
+			if (owners[i] == owner) {
+				cell->second.boxes.erase(i);
+				owners[i] = owners.back();
+				owners.pop_back();
+			}
+		}
+		if (owners.empty()) {
+			this->cells.erase(cell);
+		}
+	}
+	this->owner_cells.erase(found);
+}
+
+bool HitBoxGrid::collidesWith(const HitBox2d& box) const
+{
+	return this->collidesWith(box, nullptr, true);
+}
+
+bool HitBoxGrid::collidesWith(const HitBox2d& box, const void* owner) const
+{
+	return this->collidesWith(box, owner, false);
+}
+
+bool HitBoxGrid::collidesWith(const HitBox2d& box, const void* owner, const bool& any_owner) const
+{
+	int min_x, min_z, max_x, max_z;
+	if (!this->cellRange(box, &min_x, &min_z, &max_x, &max_z)) {
+		return false;
+	}
+
+	// a box spanning more cells than there are in use is quicker to test against all of them
+	const double span = ((double)max_x - min_x + 1) * ((double)max_z - min_z + 1);
+	if (span > (double)this->cells.size()) {
+		for (const auto& cell : this->cells) {
+			if (HitBoxGrid::collidesWith(cell.second, box, owner, any_owner)) {
+				return true;
+			}
+		}
+		return false;
+	}
+
+	for (int x = min_x; x <= max_x; x++) {
+		for (int z = min_z; z <= max_z; z++) {
+			auto cell = this->cells.find(HitBoxGrid::cellKey(x, z));
+			if (cell != this->cells.end() && HitBoxGrid::collidesWith(cell->second, box, owner, any_owner)) {
+				return true;
+			}
+		}
+	}
+	return false;
+}
+
+bool HitBoxGrid::collidesWith(const Cell& cell, const HitBox2d& box, const void* owner, const bool& any_owner)
+{
+	for (size_t i = cell.boxes.firstHit(box); i < cell.boxes.size(); i = cell.boxes.firstHit(box, i + 1)) {
+		if (any_owner || cell.owners[i] == owner) {
+			return true;
+		}
+	}
+	return false;
+}
+
+float HitBoxGrid::sweep(const HitBox2d& box, const glm::vec2& motion, glm::vec2* normal) const
+{
+	// every cell the box passes over on the way
+	HitBox2d path = box;
+	path.world_min_x = std::min(box.world_min_x, box.world_min_x + motion.x);
+	path.world_min_z = std::min(box.world_min_z, box.world_min_z + motion.y);
+	path.world_max_x = std::max(box.world_max_x, box.world_max_x + motion.x);
+	path.world_max_z = std::max(box.world_max_z, box.world_max_z + motion.y);
+	int min_x, min_z, max_x, max_z;
+	if (!this->cellRange(path, &min_x, &min_z, &max_x, &max_z)) {
+		return 1.0f;
+	}
+
+	float first = 1.0f;
+	const double span = ((double)max_x - min_x + 1) * ((double)max_z - min_z + 1);
+	if (span > (double)this->cells.size()) {
+		for (const auto& cell : this->cells) {
+			first = cell.second.boxes.sweep(box, motion, normal, first);
+		}
+		return first;
+	}
+	for (int x = min_x; x <= max_x; x++) {
+		for (int z = min_z; z <= max_z; z++) {
+			auto cell = this->cells.find(HitBoxGrid::cellKey(x, z));
+			if (cell != this->cells.end()) {
+				first = cell->second.boxes.sweep(box, motion, normal, first);
+			}
+		}
+	}
+	return first;
+}
+
+size_t HitBoxGrid::getCellCount() const
+{
+	return this->cells.size();
+}
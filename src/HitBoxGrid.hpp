@@ -0,0 +1,54 @@
+#ifndef PROCEDURALWORLD_HITBOXGRID_HPP
+#define PROCEDURALWORLD_HITBOXGRID_HPP
+
+#include <glm/glm.hpp>
+#include <vector>
+#include <unordered_map>
+#include <cstdint>
+
+#include "HitBox2d.hpp"
+#include "HitBoxBatch.hpp"
+
+// World space x-z hash grid of hit boxes. A box is kept in every cell it overlaps, tagged with
+// whatever owns it (a WorldTile), so that everything an owner put in can be taken out when it
+// goes away. Queries only look at the cells the queried box overlaps.
+
+class HitBoxGrid {
+public:
+	// cell edge in world units, a tile is 1 x 1
+	static constexpr float default_cell_size = 1.0f / 8.0f;
+
+	explicit HitBoxGrid(const float& cell_size = default_cell_size);
+
+	void insert(const HitBox2d& box, const void* owner);
+	void remove(const void* owner);
+
+	bool collidesWith(const HitBox2d& box) const;
+	// only against the boxes owner put in
+	bool collidesWith(const HitBox2d& box, const void* owner) const;
+	// box moved by motion against every box it passes, see HitBoxBatch::sweep. 1 if nothing is
+	// in the way
+	float sweep(const HitBox2d& box, const glm::vec2& motion, glm::vec2* normal) const;
+
+	size_t getCellCount() const;
+
+private:
+	// owners[i] put in the i-th box
+	struct Cell {
+		HitBoxBatch boxes;
+		std::vector<const void*> owners;
+	};
+
+	float cell_size;
+	std::unordered_map<int64_t, Cell> cells;
+	// keys of the cells each owner has boxes in, can repeat
+	std::unordered_map<const void*, std::vector<int64_t>> owner_cells;
+
+	static int64_t cellKey(const int& x, const int& z);
+	// false for a box that can't collide with anything (an empty mesh's)
+	bool cellRange(const HitBox2d& box, int* min_x, int* min_z, int* max_x, int* max_z) const;
+	bool collidesWith(const HitBox2d& box, const void* owner, const bool& any_owner) const;
+	static bool collidesWith(const Cell& cell, const HitBox2d& box, const void* owner, const bool& any_owner);
+};
+
+#endif //PROCEDURALWORLD_HITBOXGRID_HPP
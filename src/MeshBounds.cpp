@@ -0,0 +1,287 @@
+#include <glm/glm.hpp>
+#include <algorithm>
+#include <vector>
+#include <limits>
+#include <cfloat>
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+#include "MeshBounds.hpp"
+
+constexpr int MeshBounds::default_slice_count;
+
+namespace {
+
+float crossXZ(const glm::vec3& o, const glm::vec3& a, const glm::vec3& b)
+{
+	return (a.x - o.x) * (b.z - o.z) - (a.z - o.z) * (b.x - o.x);
+}
+
+// monotone chain over x-z, appends the hull of points (counter clockwise) to hull
+void appendHullXZ(std::vector<glm::vec3>& points, std::vector<glm::vec3>& hull)
+{
+	std::sort(points.begin(), points.end(), [](const glm::vec3& a, const glm::vec3& b) {
+		return a.x < b.x || (a.x == b.x && a.z < b.z);
+	});
+	if (points.size() < 3) {
+		hull.insert(hull.end(), points.begin(), points.end());
+		return;
+	}
+
+	const size_t base = hull.size();
+	for (size_t i = 0; i < points.size(); i++) {
+		while (hull.size() >= base + 2 && crossXZ(hull[hull.size() - 2], hull.back(), points[i]) <= 0) {
+			hull.pop_back();
+		}
+		hull.push_back(points[i]);
+	}
+	const size_t lower = hull.size() + 1;
+	for (size_t i = points.size() - 1; i-- > 0;) {
+		while (hull.size() >= lower && crossXZ(hull[hull.size() - 2], hull.back(), points[i]) <= 0) {
+			hull.pop_back();
+		}
+		hull.push_back(points[i]);
+	}
+	// the first point was pushed again to close the loop
+	hull.pop_back();
+}
+
+}
+
+MeshBounds::MeshBounds(const std::vector<glm::vec3>& vertices, const int& slice_count)
+{
+	if (vertices.empty() || slice_count < 1) {
+		return;
+	}
+
+	float mesh_min_y = FLT_MAX;
+	float mesh_max_y = -FLT_MAX;
+	for (const glm::vec3& vertex : vertices) {
+		mesh_min_y = std::min(mesh_min_y, vertex.y);
+		mesh_max_y = std::max(mesh_max_y, vertex.y);
+	}
+	const float height = mesh_max_y - mesh_min_y;
+	const float slices_per_unit = height > 0.0f ? slice_count / height : 0.0f;
+
+	// first pass: which slice each vertex is in, the slice's y range and its extreme points in
+	// eight directions around y (x, x+z, z, z-x, -x, -x-z, -z, x-z). the x-z box falls out of
+	// the extremes
+	struct Extremes {
+		float best[8];
+		unsigned int vertex[8];
+		unsigned int count;
+	};
+	std::vector<Slice> boxes(slice_count);
+	std::vector<Extremes> extremes(slice_count);
+	for (int i = 0; i < slice_count; i++) {
+		boxes[i].min_y = FLT_MAX;
+		boxes[i].max_y = -FLT_MAX;
+		std::fill(extremes[i].best, extremes[i].best + 8, -FLT_MAX);
+		std::fill(extremes[i].vertex, extremes[i].vertex + 8, 0);
+		extremes[i].count = 0;
+	}
+	std::vector<unsigned short> slice_of(vertices.size());
+	for (size_t v = 0; v < vertices.size(); v++) {
+		const glm::vec3& vertex = vertices[v];
+		const int i = std::min(slice_count - 1, (int)((vertex.y - mesh_min_y) * slices_per_unit));
+		slice_of[v] = (unsigned short)i;
+		Slice& box = boxes[i];
+		box.min_y = std::min(box.min_y, vertex.y);
+		box.max_y = std::max(box.max_y, vertex.y);
+		Extremes& e = extremes[i];
+		e.count++;
+#ifdef __SSE2__
+		const __m128 along = _mm_setr_ps(vertex.x, vertex.x + vertex.z, vertex.z, vertex.z - vertex.x);
+		const __m128 against = _mm_sub_ps(_mm_setzero_ps(), along);
+		const __m128i index = _mm_set1_epi32((int)v);
+		for (int half = 0; half < 2; half++) {
+			const __m128 candidate = half == 0 ? along : against;
+			const __m128 best = _mm_loadu_ps(e.best + half * 4);
+			const __m128i further = _mm_castps_si128(_mm_cmpgt_ps(candidate, best));
+			__m128i* best_vertex = (__m128i*)(e.vertex + half * 4);
+			_mm_storeu_ps(e.best + half * 4, _mm_max_ps(candidate, best));
+			_mm_storeu_si128(best_vertex, _mm_or_si128(_mm_and_si128(further, index),
+			                                           _mm_andnot_si128(further, _mm_loadu_si128(best_vertex))));
+		}
+#else
+		const float sum = vertex.x + vertex.z;
+		const float difference = vertex.x - vertex.z;
+		const float along[8] = {vertex.x, sum, vertex.z, -difference, -vertex.x, -sum, -vertex.z, difference};
+		for (int d = 0; d < 8; d++) {
+			if (along[d] > e.best[d]) {
+				e.best[d] = along[d];
+				e.vertex[d] = (unsigned int)v;
+			}
+		}
+#endif
+	}
+	for (int i = 0; i < slice_count; i++) {
+		boxes[i].max_x = extremes[i].best[0];
+		boxes[i].max_z = extremes[i].best[2];
+		boxes[i].min_x = -extremes[i].best[4];
+		boxes[i].min_z = -extremes[i].best[6];
+	}
+
+	// the polygon through each slice's extreme points as edge lines, a*x + b*z + c > 0 inside.
+	// always eight of them so the test below has a fixed trip count, repeated extreme points
+	// give an edge everything is inside of
+	struct Edges {
+		float a[8];
+		float b[8];
+		float c[8];
+	};
+	std::vector<Edges> edges(slice_count);
+	for (int i = 0; i < slice_count; i++) {
+		Edges& edge = edges[i];
+		int distinct = 0;
+		for (int d = 0; d < 8; d++) {
+			edge.a[d] = 0.0f;
+			edge.b[d] = 0.0f;
+			edge.c[d] = 1.0f;
+			if (extremes[i].count == 0) {
+				continue;
+			}
+			const unsigned int from = extremes[i].vertex[d];
+			const unsigned int to = extremes[i].vertex[(d + 1) % 8];
+			if (from == to) {
+				continue;
+			}
+			// crossXZ(from, to, p) written out as a line in p
+			edge.a[d] = -(vertices[to].z - vertices[from].z);
+			edge.b[d] = vertices[to].x - vertices[from].x;
+			edge.c[d] = -(edge.a[d] * vertices[from].x + edge.b[d] * vertices[from].z);
+			distinct++;
+		}
+		if (distinct < 3) {
+			// not a polygon, keep every vertex of the slice
+			edge.a[0] = 0.0f;
+			edge.b[0] = 0.0f;
+			edge.c[0] = -1.0f;
+		}
+	}
+
+	// second pass: a vertex strictly inside the polygon of its slice's extreme points can't be
+	// on the hull, which leaves only a small part of a dense mesh to sort
+	std::vector<std::vector<glm::vec3>> candidates(slice_count);
+	for (size_t v = 0; v < vertices.size(); v++) {
+		const glm::vec3& vertex = vertices[v];
+		const Edges& edge = edges[slice_of[v]];
+#ifdef __SSE2__
+		const __m128 x = _mm_set1_ps(vertex.x);
+		const __m128 z = _mm_set1_ps(vertex.z);
+		int outside = 0;
+		for (int half = 0; half < 8; half += 4) {
+			const __m128 side = _mm_add_ps(_mm_add_ps(_mm_mul_ps(_mm_loadu_ps(edge.a + half), x),
+			                                          _mm_mul_ps(_mm_loadu_ps(edge.b + half), z)),
+			                               _mm_loadu_ps(edge.c + half));
+			outside |= _mm_movemask_ps(_mm_cmple_ps(side, _mm_setzero_ps()));
+		}
+		const bool inside = outside == 0;
+#else
+		bool inside = true;
+		for (int d = 0; d < 8; d++) {
+			inside &= edge.a[d] * vertex.x + edge.b[d] * vertex.z + edge.c[d] > 0.0f;
+		}
+#endif
+		if (!inside) {
+			candidates[slice_of[v]].push_back(vertex);
+		}
+	}
+
+	for (int i = 0; i < slice_count; i++) {
+		if (extremes[i].count == 0) {
+			continue;
+		}
+		Slice slice = boxes[i];
+		slice.first = (unsigned int)hull_points.size();
+		appendHullXZ(candidates[i], hull_points);
+		slice.count = (unsigned int)hull_points.size() - slice.first;
+		slices.push_back(slice);
+	}
+	// widest slices first, so that extend can skip the ones already inside the box
+	std::stable_sort(slices.begin(), slices.end(), [](const Slice& a, const Slice& b) {
+		return (a.max_x - a.min_x) * (a.max_z - a.min_z) > (b.max_x - b.min_x) * (b.max_z - b.min_z);
+	});
+	slices.shrink_to_fit();
+	hull_points.shrink_to_fit();
+}
+
+void MeshBounds::extend(
+	const glm::mat4& model_matrix,
+	const float& min_y,
+	const float& max_y,
+	float* world_min_x,
+	float* world_min_z,
+	float* world_max_x,
+	float* world_max_z
+) const {
+	// world y of a local point is linear, so a slice's world y range comes from its local box
+	const float yx = model_matrix[0][1];
+	const float yy = model_matrix[1][1];
+	const float yz = model_matrix[2][1];
+	const float yw = model_matrix[3][1];
+	const float xx = model_matrix[0][0];
+	const float xy = model_matrix[1][0];
+	const float xz = model_matrix[2][0];
+	const float xw = model_matrix[3][0];
+	const float zx = model_matrix[0][2];
+	const float zy = model_matrix[1][2];
+	const float zz = model_matrix[2][2];
+	const float zw = model_matrix[3][2];
+	const bool tilted = xy != 0.0f || zy != 0.0f;
+
+	for (const Slice& slice : slices) {
+		const float slice_min_y = yw + std::min(yx * slice.min_x, yx * slice.max_x)
+		                             + std::min(yy * slice.min_y, yy * slice.max_y)
+		                             + std::min(yz * slice.min_z, yz * slice.max_z);
+		const float slice_max_y = yw + std::max(yx * slice.min_x, yx * slice.max_x)
+		                             + std::max(yy * slice.min_y, yy * slice.max_y)
+		                             + std::max(yz * slice.min_z, yz * slice.max_z);
+		if (slice_max_y < min_y || slice_min_y > max_y) {
+			continue;
+		}
+		// the slice's box placed the same way (its 8 corners), the hull can't reach past it
+		const float box_min_x = xw + std::min(xx * slice.min_x, xx * slice.max_x)
+		                           + std::min(xy * slice.min_y, xy * slice.max_y)
+		                           + std::min(xz * slice.min_z, xz * slice.max_z);
+		const float box_max_x = xw + std::max(xx * slice.min_x, xx * slice.max_x)
+		                           + std::max(xy * slice.min_y, xy * slice.max_y)
+		                           + std::max(xz * slice.min_z, xz * slice.max_z);
+		const float box_min_z = zw + std::min(zx * slice.min_x, zx * slice.max_x)
+		                           + std::min(zy * slice.min_y, zy * slice.max_y)
+		                           + std::min(zz * slice.min_z, zz * slice.max_z);
+		const float box_max_z = zw + std::max(zx * slice.min_x, zx * slice.max_x)
+		                           + std::max(zy * slice.min_y, zy * slice.max_y)
+		                           + std::max(zz * slice.min_z, zz * slice.max_z);
+		if (box_min_x >= *world_min_x && box_max_x <= *world_max_x &&
+		    box_min_z >= *world_min_z && box_max_z <= *world_max_z) {
+			continue;
+		}
+		if (tilted) {
+			// the hulls are only x-z, once local y reaches world x or z the box is what's known
+			*world_min_x = std::min(box_min_x, *world_min_x);
+			*world_min_z = std::min(box_min_z, *world_min_z);
+			*world_max_x = std::max(box_max_x, *world_max_x);
+			*world_max_z = std::max(box_max_z, *world_max_z);
+			continue;
+		}
+		for (unsigned int i = slice.first; i < slice.first + slice.count; i++) {
+			const glm::vec3 v = glm::vec3(model_matrix * glm::vec4(hull_points[i], 1.0f));
+			*world_min_x = std::min(v.x, *world_min_x);
+			*world_min_z = std::min(v.z, *world_min_z);
+			*world_max_x = std::max(v.x, *world_max_x);
+			*world_max_z = std::max(v.z, *world_max_z);
+		}
+	}
+}
+
+bool MeshBounds::empty() const
+{
+	return slices.empty();
+}
+
+size_t MeshBounds::getBytes() const
+{
+	return slices.capacity() * sizeof(Slice) + hull_points.capacity() * sizeof(glm::vec3);
+}
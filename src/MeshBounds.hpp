@@ -0,0 +1,54 @@
+#ifndef PROCEDURALWORLD_MESHBOUNDS_HPP
+#define PROCEDURALWORLD_MESHBOUNDS_HPP
+
+#include <glm/glm.hpp>
+#include <vector>
+#include <cstddef>
+
+// A few kilobytes that stand in for a mesh's vertices when all that's needed is its x-z extent
+// over a y range (see HitBox2d). The mesh is cut into horizontal slices and each slice keeps
+// only the x-z convex hull of its vertices, which bounds the slice the same as every vertex
+// would under any rotation about y.
+
+class MeshBounds {
+public:
+	static constexpr int default_slice_count = 32;
+
+	MeshBounds() = default;
+	explicit MeshBounds(const std::vector<glm::vec3>& vertices, const int& slice_count = default_slice_count);
+
+	// grows the given world box by every slice that reaches into [min_y, max_y] after model_matrix.
+	// a slice only partly in the range counts whole, so the box can be slightly larger than one
+	// built from the vertices themselves. a model_matrix that tilts local y into world x or z
+	// (like the player's) gets each slice's box instead of its hull
+	void extend(
+		const glm::mat4& model_matrix,
+		const float& min_y,
+		const float& max_y,
+		float* world_min_x,
+		float* world_min_z,
+		float* world_max_x,
+		float* world_max_z
+	) const;
+
+	bool empty() const;
+	size_t getBytes() const;
+
+private:
+	struct Slice {
+		float min_y;
+		float max_y;
+		float min_x;
+		float max_x;
+		float min_z;
+		float max_z;
+		// range of hull_points
+		unsigned int first;
+		unsigned int count;
+	};
+
+	std::vector<Slice> slices;
+	std::vector<glm::vec3> hull_points;
+};
+
+#endif //PROCEDURALWORLD_MESHBOUNDS_HPP
@@ -0,0 +1,88 @@
+#include <glm/glm.hpp>
+#include <algorithm>
+#include <cmath>
+#include <vector>
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+#include "MeshNormals.hpp"
+
+namespace {
+
+// angle between the edges from a corner, both non zero
+float cornerAngle(const glm::vec3& from, const glm::vec3& to)
+{
+	const float cosine = glm::dot(from, to) / std::sqrt(glm::dot(from, from) * glm::dot(to, to));
+	return std::acos(std::max(-1.0f, std::min(1.0f, cosine)));
+}
+
+}
+
+void MeshNormals::compute(
+	const std::vector<glm::vec3>& vertices,
+	const std::vector<GLuint>& elements,
+	std::vector<glm::vec3>* normals,
+	const Weighting& weighting
+) {
+	if (normals->size() < vertices.size()) {
+		normals->resize(vertices.size(), glm::vec3(0.0f));
+	}
+
+	std::vector<glm::vec3> sums(vertices.size(), glm::vec3(0.0f));
+	std::vector<unsigned char> used(vertices.size(), 0);
+
+	for (size_t i = 0; i + 2 < elements.size(); i += 3) {
+		const GLuint a = elements[i], b = elements[i + 1], c = elements[i + 2];
+		const glm::vec3 ab = vertices[b] - vertices[a];
+		const glm::vec3 ac = vertices[c] - vertices[a];
+		const glm::vec3 face = glm::cross(ab, ac);
+
+		if (weighting == Weighting::area) {
+			sums[a] += face;
+			sums[b] += face;
+			sums[c] += face;
+		} else {
+			const float length = glm::length(face);
+			if (length > 0.0f) {
+				const glm::vec3 unit = face / length;
+				const glm::vec3 bc = vertices[c] - vertices[b];
+				sums[a] += unit * cornerAngle(ab, ac);
+				sums[b] += unit * cornerAngle(-ab, bc);
+				sums[c] += unit * cornerAngle(-ac, -bc);
+			}
+		}
+		used[a] = used[b] = used[c] = 1;
+	}
+
+	normalize(sums.data(), sums.size());
+
+	for (size_t v = 0; v < vertices.size(); v++) {
+		if (used[v]) {
+			(*normals)[v] = sums[v];
+		}
+	}
+}
+
+void MeshNormals::normalize(glm::vec3* vectors, const size_t& count)
+{
+	size_t v = 0;
+#ifdef __SSE2__
+	// four vec3s are three registers, the four scales get spread over them to match
+	float* floats = reinterpret_cast<float*>(vectors);
+	for (; v + 4 <= count; v += 4) {
+		const glm::vec3* q = vectors + v;
+		const __m128 square_length = _mm_setr_ps(glm::dot(q[0], q[0]), glm::dot(q[1], q[1]),
+		                                         glm::dot(q[2], q[2]), glm::dot(q[3], q[3]));
+		const __m128 scale = _mm_div_ps(_mm_set1_ps(1.0f), _mm_sqrt_ps(square_length));
+
+		float* f = floats + v * 3;
+		_mm_storeu_ps(f, _mm_mul_ps(_mm_loadu_ps(f), _mm_shuffle_ps(scale, scale, _MM_SHUFFLE(1, 0, 0, 0))));
+		_mm_storeu_ps(f + 4, _mm_mul_ps(_mm_loadu_ps(f + 4), _mm_shuffle_ps(scale, scale, _MM_SHUFFLE(2, 2, 1, 1))));
+		_mm_storeu_ps(f + 8, _mm_mul_ps(_mm_loadu_ps(f + 8), _mm_shuffle_ps(scale, scale, _MM_SHUFFLE(3, 3, 3, 2))));
+	}
+#endif
+	for (; v < count; v++) {
+		vectors[v] = glm::normalize(vectors[v]);
+	}
+}
@@ -0,0 +1,36 @@
+#ifndef PROCEDURALWORLD_MESHNORMALS_HPP
+#define PROCEDURALWORLD_MESHNORMALS_HPP
+
+#ifdef __APPLE__
+#include <OpenGL/gl3.h>
+#else
+#include <GL/glew.h>
+#endif
+
+#include <glm/glm.hpp>
+#include <vector>
+
+// Smooth normals for an indexed triangle list. Every vertex a triangle uses gets the normalised
+// sum of the (counter clockwise) face normals of the triangles it is in, found in one pass over
+// the triangles instead of searching the elements once per vertex.
+
+class MeshNormals {
+public:
+	// area: each face normal counts by the triangle's area, as the unnormalised cross product does.
+	// angle: by the triangle's angle at the vertex, so splitting a face doesn't tilt its corners
+	enum class Weighting { area, angle };
+
+	// vertices no triangle uses keep whatever normals already holds for them, normals grows to
+	// one per vertex if it is shorter
+	static void compute(
+		const std::vector<glm::vec3>& vertices,
+		const std::vector<GLuint>& elements,
+		std::vector<glm::vec3>* normals,
+		const Weighting& weighting = Weighting::area
+	);
+
+	// normalises count vectors in place, four at a time where there's SSE
+	static void normalize(glm::vec3* vectors, const size_t& count);
+};
+
+#endif //PROCEDURALWORLD_MESHNORMALS_HPP
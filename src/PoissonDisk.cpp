@@ -0,0 +1,102 @@
+#include <glm/glm.hpp>
+#include <algorithm>
+#include <vector>
+#include <functional>
+#include <random>
+#include <cmath>
+#include <cstdint>
+
+#include "PoissonDisk.hpp"
+
+constexpr int PoissonDisk::default_attempts;
+
+namespace {
+
+// uniform in [0, 1), the same for the same seed everywhere (unlike std::uniform_real_distribution)
+float unit(std::minstd_rand& random)
+{
+	return (float)((double)(random() - std::minstd_rand::min()) /
+	               ((double)std::minstd_rand::max() - std::minstd_rand::min() + 1.0));
+}
+
+}
+
+std::vector<glm::vec2> PoissonDisk::sample(
+	const float& spacing,
+	const uint32_t& seed,
+	const std::function<bool(const glm::vec2&)>& accept,
+	const int& attempts
+) {
+	std::vector<glm::vec2> points;
+	const float margin = spacing / 2.0f;
+	const float side = 1.0f - spacing;
+	if (!(spacing > 0.0f) || side <= 0.0f) {
+		return points;
+	}
+
+	// at most one point per cell, a point's neighbours are within two cells of it
+	const float cell_size = spacing / std::sqrt(2.0f);
+	const int cells = (int)std::ceil(side / cell_size);
+	std::vector<int> grid((size_t)(cells * cells), -1);
+	const float min_distance2 = spacing * spacing;
+
+	std::minstd_rand random(seed);
+
+	auto cellOf = [&](const float& v) {
+		return std::min(cells - 1, (int)((v - margin) / cell_size));
+	};
+	auto fits = [&](const glm::vec2& p) {
+		if (p.x < margin || p.y < margin || p.x > margin + side || p.y > margin + side) {
+			return false;
+		}
+		const int cx = cellOf(p.x);
+		const int cz = cellOf(p.y);
+		for (int z = std::max(0, cz - 2); z <= std::min(cells - 1, cz + 2); z++) {
+			for (int x = std::max(0, cx - 2); x <= std::min(cells - 1, cx + 2); x++) {
+				const int other = grid[z * cells + x];
+				if (other >= 0) {
+					const glm::vec2 d = points[other] - p;
+					if (d.x * d.x + d.y * d.y < min_distance2) {
+						return false;
+					}
+				}
+			}
+		}
+		return !accept || accept(p);
+	};
+
+	std::vector<int> active;
+	auto add = [&](const glm::vec2& p) {
+		grid[cellOf(p.y) * cells + cellOf(p.x)] = (int)points.size();
+		active.push_back((int)points.size());
+		points.push_back(p);
+	};
+
+	for (int i = 0; i < attempts && points.empty(); i++) {
+		const glm::vec2 p(margin + unit(random) * side, margin + unit(random) * side);
+		if (fits(p)) {
+			add(p);
+		}
+	}
+
+	while (!active.empty()) {
+		const size_t slot = random() % active.size();
+		const glm::vec2 around = points[active[slot]];
+		bool placed = false;
+		for (int i = 0; i < attempts && !placed; i++) {
+			// uniform over the ring between spacing and twice spacing
+			const float angle = unit(random) * 6.2831853f;
+			const float distance = spacing * std::sqrt(1.0f + 3.0f * unit(random));
+			const glm::vec2 p = around + glm::vec2(std::cos(angle), std::sin(angle)) * distance;
+			if (fits(p)) {
+				add(p);
+				placed = true;
+			}
+		}
+		if (!placed) {
+			active[slot] = active.back();
+			active.pop_back();
+		}
+	}
+	return points;
+}
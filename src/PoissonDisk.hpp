@@ -0,0 +1,30 @@
+#ifndef PROCEDURALWORLD_POISSONDISK_HPP
+#define PROCEDURALWORLD_POISSONDISK_HPP
+
+#include <glm/glm.hpp>
+#include <vector>
+#include <functional>
+#include <cstdint>
+
+// Points spread evenly over a tile (Bridson's Poisson disk sampling): each new point is tried
+// around one already placed, and a grid of cells spacing / sqrt(2) wide holds at most one point
+// each, so checking a candidate only looks at the cells around it.
+
+class PoissonDisk {
+public:
+	// candidates tried around a point before it is done with
+	static constexpr int default_attempts = 30;
+
+	// points in the unit square, none closer than spacing to each other and none closer than
+	// spacing / 2 to an edge, so the points of two squares side by side are spacing apart too
+	// without either knowing the other's. the same seed gives the same points. a candidate that
+	// accept returns false for is dropped like one that's too close
+	static std::vector<glm::vec2> sample(
+		const float& spacing,
+		const uint32_t& seed,
+		const std::function<bool(const glm::vec2&)>& accept = nullptr,
+		const int& attempts = default_attempts
+	);
+};
+
+#endif //PROCEDURALWORLD_POISSONDISK_HPP
@@ -0,0 +1,464 @@
+#ifdef __APPLE__
+#include <OpenGL/gl3.h>
+#include <OpenGL/gl3ext.h>
+#else
+#include <GL/glew.h> // include GL Extension Wrangler
+#endif
+
+#include <map>
+#include <deque>
+#include <memory>
+#include <string>
+#include <tuple>
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <cstring>
+#include <stdexcept>
+
+#include "TextureManager.hpp"
+#include "loadTexture.hpp"
+
+// Same sized material textures packed into one GL_TEXTURE_2D_ARRAY so that the
+// trees of a whole tile draw without rebinding. Every entry must decode (or bake)
+// to the same size and format, the layer index is the position in this list.
+static const std::vector<std::string> MATERIAL_TEXTURES = {
+		"../textures/TreeATexture.jpg",
+		"../textures/TreeATexture - Alternative.jpg",
+		"../textures/TreeBTexture.jpg",
+		"../textures/TreeCTexture.jpg"
+};
+
+// One image on its way from disk to a texture
+struct DecodeJob {
+	std::weak_ptr<Texture> texture;
+	int layer; // material array layer, -1 for a plain texture
+	std::string path;
+	bool vert_align_flip;
+	bool allow_compressed;
+	DecodedImage image;
+	std::string error;
+};
+
+struct TextureManager::Loader {
+	std::mutex mutex;
+	std::condition_variable work_available;
+	std::deque<DecodeJob> queued;
+	std::deque<DecodeJob> decoded;
+	std::vector<std::thread> workers;
+	size_t decoding = 0;
+	bool stopping = false;
+
+	void start()
+	{
+		if (!workers.empty()) return;
+		unsigned int count = std::thread::hardware_concurrency();
+		if (count < 1) count = 1;
+		if (count > 2) count = 2;
+		for (unsigned int i = 0; i < count; i++) {
+			workers.emplace_back(&Loader::work, this);
+		}
+	}
+
+	void work()
+	{
+		for (;;) {
+			DecodeJob job;
+			{
+				std::unique_lock<std::mutex> lock(mutex);
+				work_available.wait(lock, [this] { return stopping || !queued.empty(); });
+				if (stopping) return;
+				job = std::move(queued.front());
+				queued.pop_front();
+				decoding++;
+			}
+			try {
+				decodeImage(job.path, job.vert_align_flip, job.allow_compressed, &job.image);
+			} catch (const std::runtime_error& e) {
+				job.error = e.what();
+			}
+			std::lock_guard<std::mutex> lock(mutex);
+			decoded.push_back(std::move(job));
+			decoding--;
+		}
+	}
+
+	void stop()
+	{
+		{
+			std::lock_guard<std::mutex> lock(mutex);
+			stopping = true;
+		}
+		work_available.notify_all();
+		for (auto& worker : workers) {
+			worker.join();
+		}
+		workers.clear();
+	}
+
+	~Loader()
+	{
+		stop();
+	}
+};
+
+std::map<TextureManager::Key, std::weak_ptr<Texture>> TextureManager::textures;
+size_t TextureManager::resident_bytes = 0;
+bool TextureManager::context_alive = true;
+GLuint TextureManager::pixel_buffer = 0;
+GLuint TextureManager::bound_texture = 0;
+GLuint TextureManager::bound_array = 0;
+GLuint TextureManager::material_array = 0;
+std::vector<DecodedImage> TextureManager::material_layers;
+size_t TextureManager::material_layers_decoded = 0;
+
+TextureManager::Loader& TextureManager::loader()
+{
+	static Loader loader;
+	return loader;
+}
+
+Texture::Texture(const GLuint& id) : id(id), bytes(0), resident(false)
+{
+}
+
+Texture::~Texture()
+{
+	TextureManager::resident_bytes -= bytes;
+	if (TextureManager::context_alive) {
+		glDeleteTextures(1, &this->id);
+	}
+	// GL unbinds a deleted texture, and the name may be handed out again
+	if (TextureManager::bound_texture == this->id) {
+		TextureManager::bound_texture = 0;
+	}
+}
+
+GLuint Texture::getId() const
+{
+	return this->id;
+}
+
+size_t Texture::getBytes() const
+{
+	return this->bytes;
+}
+
+bool Texture::isResident() const
+{
+	return this->resident;
+}
+
+bool TextureManager::Key::operator<(const Key& other) const
+{
+	return std::tie(path, min_filter, mag_filter, wrap_s, wrap_t, vert_align_flip)
+	       < std::tie(other.path, other.min_filter, other.mag_filter, other.wrap_s, other.wrap_t, other.vert_align_flip);
+}
+
+TextureHandle TextureManager::get(
+		const std::string& path,
+		const GLint& min_filter,
+		const GLint& mag_filter
+) {
+	return get(path, min_filter, mag_filter, GL_MIRRORED_REPEAT, GL_MIRRORED_REPEAT, false);
+}
+
+TextureHandle TextureManager::get(
+		const std::string& path,
+		const GLint& min_filter,
+		const GLint& mag_filter,
+		const bool vert_align_flip
+) {
+	return get(path, min_filter, mag_filter, GL_MIRRORED_REPEAT, GL_MIRRORED_REPEAT, vert_align_flip);
+}
+
+TextureHandle TextureManager::get(
+		const std::string& path,
+		const GLint& min_filter,
+		const GLint& mag_filter,
+		const GLint& wrap_s,
+		const GLint& wrap_t,
+		const bool vert_align_flip
+) {
+	Key key = {path, min_filter, mag_filter, wrap_s, wrap_t, vert_align_flip};
+
+	TextureHandle texture = textures[key].lock();
+	if (texture) {
+		return texture;
+	}
+
+	GLuint id;
+	glGenTextures(1, &id);
+	bind(GL_TEXTURE_2D, id);
+
+	//set wrapping params
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, wrap_s);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, wrap_t);
+
+	//set texture filtering params
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, min_filter);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, mag_filter);
+
+	// neutral grey stand-in, a single texel is a complete mip chain on its own
+	const unsigned char placeholder[4] = {128, 128, 128, 255};
+	glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, 1, 1, 0, GL_RGBA, GL_UNSIGNED_BYTE, placeholder);
+
+	texture = std::make_shared<Texture>(id);
+	textures[key] = texture;
+
+	queueDecode(texture, -1, path, vert_align_flip);
+
+	return texture;
+}
+
+void TextureManager::queueDecode(
+		const std::weak_ptr<Texture>& texture,
+		const int& layer,
+		const std::string& path,
+		const bool vert_align_flip
+) {
+	// the decode workers can't ask GL, so check once here on the GL thread
+	static bool compressed_supported = compressedTexturesSupported();
+
+	Loader& l = loader();
+	{
+		std::lock_guard<std::mutex> lock(l.mutex);
+		DecodeJob job;
+		job.texture = texture;
+		job.layer = layer;
+		job.path = path;
+		job.vert_align_flip = vert_align_flip;
+		job.allow_compressed = compressed_supported;
+		l.queued.push_back(std::move(job));
+		l.start();
+	}
+	l.work_available.notify_one();
+}
+
+int TextureManager::getMaterialLayer(const std::string& path)
+{
+	int layer = -1;
+	for (size_t i = 0; i < MATERIAL_TEXTURES.size(); i++) {
+		if (MATERIAL_TEXTURES[i] == path) {
+			layer = i;
+			break;
+		}
+	}
+	if (layer < 0) {
+		throw std::runtime_error("Not a material array texture: \'" + path + "\'");
+	}
+
+	if (material_array == 0) {
+		glGenTextures(1, &material_array);
+		bind(GL_TEXTURE_2D_ARRAY, material_array);
+
+		glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_S, GL_MIRRORED_REPEAT);
+		glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_T, GL_MIRRORED_REPEAT);
+		// the trees all used nearest minification and linear magnification
+		glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+		glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+
+		// neutral grey stand-in in every layer until the real images are in
+		std::vector<unsigned char> placeholder(MATERIAL_TEXTURES.size() * 4, 128);
+		glTexImage3D(
+				GL_TEXTURE_2D_ARRAY,
+				0,
+				GL_RGBA,
+				1,
+				1,
+				MATERIAL_TEXTURES.size(),
+				0,
+				GL_RGBA,
+				GL_UNSIGNED_BYTE,
+				placeholder.data()
+		);
+
+		material_layers.resize(MATERIAL_TEXTURES.size());
+		for (size_t i = 0; i < MATERIAL_TEXTURES.size(); i++) {
+			queueDecode(std::weak_ptr<Texture>(), i, MATERIAL_TEXTURES[i], false);
+		}
+	}
+
+	return layer;
+}
+
+GLuint TextureManager::getMaterialArrayId()
+{
+	return material_array;
+}
+
+void TextureManager::bind(const GLenum& target, const GLuint& id)
+{
+	if (target == GL_TEXTURE_2D_ARRAY) {
+		if (bound_array == id) return;
+		// a different sampler type can't share unit 0 with tex_image
+		glActiveTexture(GL_TEXTURE1);
+		glBindTexture(GL_TEXTURE_2D_ARRAY, id);
+		glActiveTexture(GL_TEXTURE0);
+		bound_array = id;
+	} else {
+		if (bound_texture == id) return;
+		glBindTexture(GL_TEXTURE_2D, id);
+		bound_texture = id;
+	}
+}
+
+void TextureManager::uploadMaterialArray()
+{
+	const DecodedImage& first = material_layers.front();
+	for (const DecodedImage& image : material_layers) {
+		if (!isSameShape(first, image)) {
+			throw std::runtime_error("Material array textures must all have the same size and format");
+		}
+	}
+
+	bind(GL_TEXTURE_2D_ARRAY, material_array);
+	glActiveTexture(GL_TEXTURE1);
+
+	// no pixel buffer may be bound while allocating, or null would read from it
+	glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+	allocateImageArray(first, material_layers.size());
+
+	size_t layer_bytes = imageUploadBytes(first);
+	GLsizeiptr size = layer_bytes * material_layers.size();
+	glBindBuffer(GL_PIXEL_UNPACK_BUFFER, pixel_buffer);
+	glBufferData(GL_PIXEL_UNPACK_BUFFER, size, nullptr, GL_STREAM_DRAW);
+	unsigned char* mapped = (unsigned char*)glMapBufferRange(
+			GL_PIXEL_UNPACK_BUFFER,
+			0,
+			size,
+			GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_BUFFER_BIT
+	);
+	if (mapped != nullptr) {
+		for (const DecodedImage& image : material_layers) {
+			for (const BakedTextureLevel& level : image.levels) {
+				std::memcpy(mapped, level.data.data(), level.data.size());
+				mapped += level.data.size();
+			}
+		}
+		glUnmapBuffer(GL_PIXEL_UNPACK_BUFFER);
+	} else {
+		glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+	}
+	for (size_t i = 0; i < material_layers.size(); i++) {
+		uploadImageLayer(material_layers[i], i, mapped != nullptr, i * layer_bytes);
+	}
+	glBindBuffer(GL_PIXEL_UNPACK_BUFFER, pixel_buffer);
+
+	finishImageArray(first);
+	glActiveTexture(GL_TEXTURE0);
+
+	resident_bytes += imageBytes(first) * material_layers.size();
+	material_layers.clear();
+	material_layers.shrink_to_fit();
+}
+
+void TextureManager::update()
+{
+	std::vector<DecodeJob> ready;
+	{
+		Loader& l = loader();
+		std::lock_guard<std::mutex> lock(l.mutex);
+		while (!l.decoded.empty() && ready.size() < max_uploads_per_update) {
+			ready.push_back(std::move(l.decoded.front()));
+			l.decoded.pop_front();
+		}
+	}
+	if (ready.empty()) return;
+
+	if (pixel_buffer == 0) {
+		glGenBuffers(1, &pixel_buffer);
+	}
+
+	glBindBuffer(GL_PIXEL_UNPACK_BUFFER, pixel_buffer);
+	for (DecodeJob& job : ready) {
+		if (!job.error.empty()) {
+			glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+			throw std::runtime_error(job.error);
+		}
+
+		if (job.layer >= 0) {
+			material_layers[job.layer] = std::move(job.image);
+			if (++material_layers_decoded == material_layers.size()) {
+				uploadMaterialArray();
+			}
+			continue;
+		}
+
+		// nobody is holding the texture anymore, drop the pixels
+		TextureHandle texture = job.texture.lock();
+		if (!texture) continue;
+
+		// orphan the previous contents so the driver doesn't wait on the last upload
+		GLsizeiptr size = imageUploadBytes(job.image);
+		glBufferData(GL_PIXEL_UNPACK_BUFFER, size, nullptr, GL_STREAM_DRAW);
+		unsigned char* mapped = (unsigned char*)glMapBufferRange(
+				GL_PIXEL_UNPACK_BUFFER,
+				0,
+				size,
+				GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_BUFFER_BIT
+		);
+		if (mapped == nullptr) {
+			glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+			bind(GL_TEXTURE_2D, texture->id);
+			uploadImage(job.image, false);
+			glBindBuffer(GL_PIXEL_UNPACK_BUFFER, pixel_buffer);
+		} else {
+			// levels go in back to back, the order uploadImage reads them in
+			for (const BakedTextureLevel& level : job.image.levels) {
+				std::memcpy(mapped, level.data.data(), level.data.size());
+				mapped += level.data.size();
+			}
+			glUnmapBuffer(GL_PIXEL_UNPACK_BUFFER);
+			bind(GL_TEXTURE_2D, texture->id);
+			uploadImage(job.image, true);
+		}
+
+		texture->bytes = imageBytes(job.image);
+		texture->resident = true;
+		resident_bytes += texture->bytes;
+	}
+	glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+}
+
+size_t TextureManager::getResidentBytes()
+{
+	return resident_bytes;
+}
+
+size_t TextureManager::getResidentCount()
+{
+	size_t count = 0;
+	for (auto it = textures.begin(); it != textures.end(); ++it) {
+		TextureHandle texture = it->second.lock();
+		if (texture && texture->isResident()) {
+			count++;
+		}
+	}
+	if (material_array != 0 && material_layers_decoded == MATERIAL_TEXTURES.size()) {
+		count++;
+	}
+	return count;
+}
+
+size_t TextureManager::getPendingCount()
+{
+	Loader& l = loader();
+	std::lock_guard<std::mutex> lock(l.mutex);
+	return l.queued.size() + l.decoding + l.decoded.size();
+}
+
+void TextureManager::shutdown()
+{
+	loader().stop();
+	if (material_array != 0) {
+		glDeleteTextures(1, &material_array);
+		material_array = 0;
+	}
+	if (pixel_buffer != 0) {
+		glDeleteBuffers(1, &pixel_buffer);
+		pixel_buffer = 0;
+	}
+	context_alive = false;
+}
@@ -0,0 +1,117 @@
+#ifndef PROCEDURALWORLD_TEXTUREMANAGER_HPP
+#define PROCEDURALWORLD_TEXTUREMANAGER_HPP
+
+#ifdef __APPLE__
+#include <OpenGL/gl3.h>
+#include <OpenGL/gl3ext.h>
+#else
+#include <GL/glew.h> // include GL Extension Wrangler
+#endif
+
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+#include <cstddef>
+
+#include "loadTexture.hpp"
+
+// A GL texture shared by every entity that asked for the same image with the same
+// sampler parameters. The GL name is deleted when the last handle lets go of it.
+// Until the image has been decoded and uploaded the name holds a 1x1 placeholder,
+// so the id handed to entities never changes.
+class Texture {
+private:
+	GLuint id;
+	size_t bytes;
+	bool resident;
+	friend class TextureManager;
+public:
+	explicit Texture(const GLuint& id);
+	~Texture();
+	Texture(const Texture&) = delete;
+	Texture& operator=(const Texture&) = delete;
+	GLuint getId() const;
+	size_t getBytes() const;
+	bool isResident() const;
+};
+
+typedef std::shared_ptr<Texture> TextureHandle;
+
+// Decodes and uploads each (path, sampler) combination once per process and hands
+// out reference counted handles to it. Images are decoded on worker threads and
+// uploaded through a pixel buffer by update(), which must run on the GL thread.
+// Tree materials share a single texture array instead, see getMaterialLayer.
+class TextureManager {
+private:
+	struct Key {
+		std::string path;
+		GLint min_filter;
+		GLint mag_filter;
+		GLint wrap_s;
+		GLint wrap_t;
+		bool vert_align_flip;
+		bool operator<(const Key& other) const;
+	};
+	struct Loader;
+	static Loader& loader();
+	static std::map<Key, std::weak_ptr<Texture>> textures;
+	static size_t resident_bytes;
+	static bool context_alive;
+	static GLuint pixel_buffer;
+	static GLuint bound_texture;
+	static GLuint bound_array;
+	static GLuint material_array;
+	static std::vector<DecodedImage> material_layers;
+	static size_t material_layers_decoded;
+	static void queueDecode(
+			const std::weak_ptr<Texture>& texture,
+			const int& layer,
+			const std::string& path,
+			const bool vert_align_flip
+	);
+	static void uploadMaterialArray();
+	friend class Texture;
+public:
+	// Uploads at most this many decoded images per call to update()
+	static constexpr int max_uploads_per_update = 2;
+
+	static TextureHandle get(
+			const std::string& path,
+			const GLint& min_filter,
+			const GLint& mag_filter
+	);
+	static TextureHandle get(
+			const std::string& path,
+			const GLint& min_filter,
+			const GLint& mag_filter,
+			const bool vert_align_flip
+	);
+	static TextureHandle get(
+			const std::string& path,
+			const GLint& min_filter,
+			const GLint& mag_filter,
+			const GLint& wrap_s,
+			const GLint& wrap_t,
+			const bool vert_align_flip
+	);
+	// Layer of path in the shared material GL_TEXTURE_2D_ARRAY, see MATERIAL_TEXTURES
+	// in TextureManager.cpp. The array holds a grey placeholder in every layer until
+	// all of them have been decoded.
+	static int getMaterialLayer(const std::string& path);
+	static GLuint getMaterialArrayId();
+	// Binds GL_TEXTURE_2D on unit 0 or GL_TEXTURE_2D_ARRAY on unit 1, skipping the
+	// call when that texture is bound already
+	static void bind(const GLenum& target, const GLuint& id);
+	// Moves finished decodes into their textures. Rethrows decode failures.
+	static void update();
+	static size_t getResidentBytes();
+	static size_t getResidentCount();
+	static size_t getPendingCount();
+	// Call before the GL context goes away. Stops the decode workers, and handles
+	// held by function-local statics are destroyed after glfwTerminate so they must
+	// not touch GL any more.
+	static void shutdown();
+};
+
+#endif //PROCEDURALWORLD_TEXTUREMANAGER_HPP
@@ -1,16 +1,95 @@
 #include "TreeRandom.hpp"
+#include <climits>
 #include <cmath>
 #include <cstdio>
-int TreeRandom::k = 777;
+constexpr int TreeRandom::k;
+constexpr uint64_t TreeRandom::branchStream;
+constexpr uint64_t TreeRandom::oddEvenStream;
+constexpr uint64_t TreeRandom::jaggednessStream;
+
+TreeRandom::Mode TreeRandom::mode = TreeRandom::Mode::Compatible;
+
+namespace {
+
+//splitmix64's output function
+uint64_t mix(uint64_t z) {
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
+}
+
+const uint64_t golden = 0x9E3779B97F4A7C15ULL;
+
+//cvttss2si gives INT_MIN for nan and anything out of range, a plain cast is undefined there
+int truncate(float value) {
+    return value >= -2147483648.0f && value < 2147483648.0f ? (int)value : INT_MIN;
+}
+
+int wrappingMultiply(int a, int b) {
+    return (int)((uint32_t)a * (uint32_t)b);
+}
+
+int modulo(float trunkDiameter) {
+    //a diameter of 0 used to divide by 0
+    const int m = TreeRandom::k * 10 * truncate(std::ceil(trunkDiameter));
+    return m == 0 ? 1 : m;
+}
+
+}
+
+void TreeRandom::setMode(const Mode& mode) {
+    TreeRandom::mode = mode;
+}
+
+TreeRandom::Mode TreeRandom::getMode() {
+    return mode;
+}
+
+uint64_t TreeRandom::hash(uint64_t stream, uint64_t counter) {
+    return mix(mix(stream) + (counter + 1) * golden);
+}
+
+void TreeRandom::hashBatch(uint64_t stream, uint64_t firstCounter, uint64_t* out, size_t count) {
+    const uint64_t mixed = mix(stream);
+    for (size_t i = 0; i < count; i++) {
+        out[i] = mix(mixed + (firstCounter + i + 1) * golden);
+    }
+}
+
+int TreeRandom::hashRange(uint64_t hash, int min, int max) {
+    const uint64_t span = (uint64_t)((int64_t)max - min);
+    return (int)(min + (int64_t)(((hash >> 32) * span) >> 32));
+}
+
+uint64_t TreeRandom::key(float a, float b) {
+    union { float f; uint32_t u; } x, y;
+    x.f = a;
+    y.f = b;
+    return ((uint64_t)x.u << 32) | y.u;
+}
+
+int TreeRandom::compatibleRandom(float trunkDiameter, float seed, float lineHeight, int modulo) {
+    const int height = wrappingMultiply(truncate(lineHeight) % 10, truncate(lineHeight * 7)) % 100;
+    return truncate(trunkDiameter * seed * ((height + 1) * 10) * 3) % modulo;
+}
 
 int TreeRandom::treeRandom(float trunkDiameter, float seed, float lineHeight) {
-    int randomSeedValue = ((int)(trunkDiameter * seed * (((int)lineHeight % 10 * (int)(lineHeight*7) % 100 + 1 ) * 10) * 3)) % (k*10 * (int)ceil(trunkDiameter));
+    int randomSeedValue;
+    if (mode == Mode::Compatible) {
+        randomSeedValue = compatibleRandom(trunkDiameter, seed, lineHeight, modulo(trunkDiameter));
+    } else {
+        randomSeedValue = hashRange(hash(key(trunkDiameter, seed) + branchStream * golden, key(lineHeight, 0)),
+                                    0, modulo(trunkDiameter));
+    }
     if (randomSeedValue % 2 == 0) randomSeedValue = -(randomSeedValue + 1);
     return randomSeedValue;
 }
 int TreeRandom::treeOddEvenRandom(float trunkDiameter, float seed, float lineHeight) {
-    int randomSeedValue = ((int)(trunkDiameter * seed * (((int)lineHeight % 10 * (int)(lineHeight*7) % 100 + 1 ) * 10) * 3)) % (k*10 * (int)ceil(trunkDiameter+1));
-    return randomSeedValue;
+    if (mode == Mode::Compatible) {
+        return compatibleRandom(trunkDiameter, seed, lineHeight, modulo(trunkDiameter + 1));
+    }
+    return hashRange(hash(key(trunkDiameter, seed) + oddEvenStream * golden, key(lineHeight, 0)),
+                     0, modulo(trunkDiameter + 1));
 }
 int TreeRandom::branchAngleFromRandom(float trunkDiameter, float seed, float lineHeight,
                                       int maxYBranchAngle , int minYBranchAngle) {
@@ -21,11 +100,10 @@ int TreeRandom::trunkAngleFromRandom(float trunkDiameter, float seed, float line
     return treeRandom(trunkDiameter, seed, lineHeight) % (maxYTrunkAngle - minYTrunkAngle) + minYTrunkAngle;
 }
 
-#include <iostream>
 unsigned long TreeRandom::middleSquareRange(int seed, float max, float min){
-    long _max = max, _min = min, _seed = pow(seed, 2);
-//    std::cout << "Rand " <<  (unsigned long)(_seed) % (int)(_max - _min) + _min << " " << _max << " "<< _min << "\n";
+    //the square pow(seed, 2) gave, without the call
+    long _max = max, _min = min, _seed = (double)seed * seed;
     long modulo = (_max * 100 - _min * 100);
     unsigned long rand  = (unsigned long)(_seed) % (int)( modulo == 0 ? 991 : modulo) + _min * 100;
     return rand / 100;
-}
\ No newline at end of file
+}
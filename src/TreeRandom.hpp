@@ -5,15 +5,45 @@
 #ifndef PROCEDURALWORLD_TREERANDOM_H
 #define PROCEDURALWORLD_TREERANDOM_H
 
+#include <cstddef>
+#include <cstdint>
+
 class TreeRandom {
 public:
-    static int k;
+    static constexpr int k = 777;
+
+    //Compatible reproduces the forests the float and modulo arithmetic always made.
+    //Hashed draws every value from hash() instead. Pick one before any tree is generated,
+    //prototypes already in the cache keep the mode they were made with
+    enum class Mode { Compatible, Hashed };
+    static void setMode(const Mode& mode);
+    static Mode getMode();
+
+    //what each value is drawn for, so the same inputs give unrelated values
+    static constexpr uint64_t branchStream = 1;
+    static constexpr uint64_t oddEvenStream = 2;
+    static constexpr uint64_t jaggednessStream = 3;
+
+    //counter based: value number counter of a stream, any order, no state. no branches
+    static uint64_t hash(uint64_t stream, uint64_t counter);
+    //out[i] = hash(stream, firstCounter + i), the stream is only mixed once
+    static void hashBatch(uint64_t stream, uint64_t firstCounter, uint64_t* out, size_t count);
+    //a hash to [min, max) with a multiply instead of a modulo
+    static int hashRange(uint64_t hash, int min, int max);
+    //two floats as one key, by their bits
+    static uint64_t key(float a, float b);
 
     static int treeRandom(float trunkDiameter, float seed, float lineHeight);
     static int treeOddEvenRandom(float trunkDiameter, float seed, float lineHeight);
     static int branchAngleFromRandom(float trunkDiameter, float seed, float lineHeight, int maxYBranchAngle , int minYBranchAngle);
     static int trunkAngleFromRandom(float trunkDiameter, float seed, float lineHeight, int maxYTrunkAngle ,int minYTrunkAngle);
     static unsigned long middleSquareRange(int seed, float max, float min);
+
+private:
+    static Mode mode;
+
+    //the old formula, with the out of range casts and the int overflow pinned to what x86 did
+    static int compatibleRandom(float trunkDiameter, float seed, float lineHeight, int modulo);
 };
 
 #endif //PROCEDURALWORLD_TREERANDOM_H
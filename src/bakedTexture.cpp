@@ -0,0 +1,341 @@
+#include <string>
+#include <vector>
+#include <fstream>
+#include <stdexcept>
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+
+#include "bakedTexture.hpp"
+
+static const char BAKED_TEXTURE_MAGIC[4] = {'P', 'W', 'T', 'X'};
+static const uint32_t BAKED_TEXTURE_VERSION = 1;
+
+std::string bakedTexturePath(const std::string& source_path)
+{
+	size_t dot = source_path.find_last_of('.');
+	size_t slash = source_path.find_last_of("/\\");
+	if (dot == std::string::npos || (slash != std::string::npos && dot < slash)) {
+		return source_path + BAKED_TEXTURE_EXTENSION;
+	}
+	return source_path.substr(0, dot) + BAKED_TEXTURE_EXTENSION;
+}
+
+bool isCompressed(const BakedTextureFormat& format)
+{
+	return format == BAKED_BC1 || format == BAKED_BC3;
+}
+
+static uint32_t readU32(std::ifstream& in)
+{
+	unsigned char b[4];
+	if (!in.read((char*)b, 4)) {
+		throw std::runtime_error("Baked texture is truncated");
+	}
+	return (uint32_t)b[0] | ((uint32_t)b[1] << 8) | ((uint32_t)b[2] << 16) | ((uint32_t)b[3] << 24);
+}
+
+static void writeU32(std::ofstream& out, const uint32_t& value)
+{
+	unsigned char b[4] = {
+			(unsigned char)(value & 0xFF),
+			(unsigned char)((value >> 8) & 0xFF),
+			(unsigned char)((value >> 16) & 0xFF),
+			(unsigned char)((value >> 24) & 0xFF)
+	};
+	out.write((const char*)b, 4);
+}
+
+static size_t levelBytes(const BakedTextureFormat& format, const uint32_t& width, const uint32_t& height)
+{
+	size_t blocks = (size_t)((width + 3) / 4) * ((height + 3) / 4);
+	switch (format) {
+		case BAKED_RGB8:
+			return (size_t)width * height * 3;
+		case BAKED_RGBA8:
+			return (size_t)width * height * 4;
+		case BAKED_BC1:
+			return blocks * 8;
+		case BAKED_BC3:
+			return blocks * 16;
+	}
+	return 0;
+}
+
+bool readBakedTexture(const std::string& path, BakedTexture* texture)
+{
+	std::ifstream in(path, std::ios::in | std::ios::binary);
+	if (!in.is_open()) {
+		return false;
+	}
+
+	char magic[4];
+	if (!in.read(magic, 4) || !std::equal(magic, magic + 4, BAKED_TEXTURE_MAGIC)) {
+		throw std::runtime_error("Not a baked texture: \'" + path + "\'");
+	}
+	if (readU32(in) != BAKED_TEXTURE_VERSION) {
+		throw std::runtime_error("Unsupported baked texture version: \'" + path + "\'");
+	}
+
+	uint32_t format = readU32(in);
+	if (format > BAKED_BC3) {
+		throw std::runtime_error("Unknown baked texture format: \'" + path + "\'");
+	}
+	texture->format = (BakedTextureFormat)format;
+	readU32(in); // width, repeated by the first level
+	readU32(in); // height
+	uint32_t level_count = readU32(in);
+	texture->flipped = readU32(in) != 0;
+
+	texture->levels.resize(level_count);
+	for (BakedTextureLevel& level : texture->levels) {
+		level.width = readU32(in);
+		level.height = readU32(in);
+		uint32_t size = readU32(in);
+		if (size != levelBytes(texture->format, level.width, level.height)) {
+			throw std::runtime_error("Baked texture level has the wrong size: \'" + path + "\'");
+		}
+		level.data.resize(size);
+		if (!in.read((char*)level.data.data(), size)) {
+			throw std::runtime_error("Baked texture is truncated: \'" + path + "\'");
+		}
+	}
+	if (texture->levels.empty()) {
+		throw std::runtime_error("Baked texture has no levels: \'" + path + "\'");
+	}
+
+	return true;
+}
+
+void writeBakedTexture(const std::string& path, const BakedTexture& texture)
+{
+	std::ofstream out(path, std::ios::out | std::ios::binary);
+	if (!out.is_open()) {
+		throw std::runtime_error("Could not write \'" + path + "\'");
+	}
+
+	out.write(BAKED_TEXTURE_MAGIC, 4);
+	writeU32(out, BAKED_TEXTURE_VERSION);
+	writeU32(out, texture.format);
+	writeU32(out, texture.levels.front().width);
+	writeU32(out, texture.levels.front().height);
+	writeU32(out, texture.levels.size());
+	writeU32(out, texture.flipped ? 1 : 0);
+	for (const BakedTextureLevel& level : texture.levels) {
+		writeU32(out, level.width);
+		writeU32(out, level.height);
+		writeU32(out, level.data.size());
+		out.write((const char*)level.data.data(), level.data.size());
+	}
+}
+
+// 8:8:8 -> 5:6:5
+static uint16_t packColor(const int* rgb)
+{
+	return (uint16_t)(((rgb[0] * 31 + 127) / 255) << 11 | ((rgb[1] * 63 + 127) / 255) << 5 | ((rgb[2] * 31 + 127) / 255));
+}
+
+static void unpackColor(const uint16_t& color, int* rgb)
+{
+	int r = (color >> 11) & 31;
+	int g = (color >> 5) & 63;
+	int b = color & 31;
+	rgb[0] = (r << 3) | (r >> 2);
+	rgb[1] = (g << 2) | (g >> 4);
+	rgb[2] = (b << 3) | (b >> 2);
+}
+
+// block holds 16 RGBA texels row by row. Endpoints come from the block's colour
+// bounding box inset by 1/16th, which is cheap and good enough for photo textures.
+static void encodeColorBlock(const unsigned char* block, unsigned char* out)
+{
+	int min_c[3] = {255, 255, 255};
+	int max_c[3] = {0, 0, 0};
+	for (int i = 0; i < 16; i++) {
+		for (int c = 0; c < 3; c++) {
+			min_c[c] = std::min(min_c[c], (int)block[i * 4 + c]);
+			max_c[c] = std::max(max_c[c], (int)block[i * 4 + c]);
+		}
+	}
+	for (int c = 0; c < 3; c++) {
+		int inset = (max_c[c] - min_c[c]) >> 4;
+		min_c[c] += inset;
+		max_c[c] -= inset;
+	}
+
+	uint16_t c0 = packColor(max_c);
+	uint16_t c1 = packColor(min_c);
+	if (c0 < c1) std::swap(c0, c1);
+
+	uint32_t indices = 0;
+	if (c0 != c1) {
+		// c0 > c1 selects the four colour mode
+		int palette[4][3];
+		unpackColor(c0, palette[0]);
+		unpackColor(c1, palette[1]);
+		for (int c = 0; c < 3; c++) {
+			palette[2][c] = (2 * palette[0][c] + palette[1][c]) / 3;
+			palette[3][c] = (palette[0][c] + 2 * palette[1][c]) / 3;
+		}
+		for (int i = 0; i < 16; i++) {
+			int best = 0;
+			int best_distance = INT32_MAX;
+			for (int p = 0; p < 4; p++) {
+				int distance = 0;
+				for (int c = 0; c < 3; c++) {
+					int d = (int)block[i * 4 + c] - palette[p][c];
+					distance += d * d;
+				}
+				if (distance < best_distance) {
+					best_distance = distance;
+					best = p;
+				}
+			}
+			indices |= (uint32_t)best << (i * 2);
+		}
+	}
+
+	out[0] = (unsigned char)(c0 & 0xFF);
+	out[1] = (unsigned char)(c0 >> 8);
+	out[2] = (unsigned char)(c1 & 0xFF);
+	out[3] = (unsigned char)(c1 >> 8);
+	for (int i = 0; i < 4; i++) {
+		out[4 + i] = (unsigned char)((indices >> (i * 8)) & 0xFF);
+	}
+}
+
+static void encodeAlphaBlock(const unsigned char* block, unsigned char* out)
+{
+	int a0 = 0;
+	int a1 = 255;
+	for (int i = 0; i < 16; i++) {
+		a0 = std::max(a0, (int)block[i * 4 + 3]);
+		a1 = std::min(a1, (int)block[i * 4 + 3]);
+	}
+
+	uint64_t indices = 0;
+	if (a0 != a1) {
+		// a0 > a1 selects eight interpolated alpha values
+		int palette[8];
+		palette[0] = a0;
+		palette[1] = a1;
+		for (int p = 2; p < 8; p++) {
+			palette[p] = ((8 - p) * a0 + (p - 1) * a1) / 7;
+		}
+		for (int i = 0; i < 16; i++) {
+			int best = 0;
+			int best_distance = 256;
+			for (int p = 0; p < 8; p++) {
+				int distance = std::abs((int)block[i * 4 + 3] - palette[p]);
+				if (distance < best_distance) {
+					best_distance = distance;
+					best = p;
+				}
+			}
+			indices |= (uint64_t)best << (i * 3);
+		}
+	}
+
+	out[0] = (unsigned char)a0;
+	out[1] = (unsigned char)a1;
+	for (int i = 0; i < 6; i++) {
+		out[2 + i] = (unsigned char)((indices >> (i * 8)) & 0xFF);
+	}
+}
+
+static void encodeLevel(
+		const std::vector<unsigned char>& rgba,
+		const uint32_t& width,
+		const uint32_t& height,
+		const BakedTextureFormat& format,
+		BakedTextureLevel* level
+) {
+	level->width = width;
+	level->height = height;
+	level->data.resize(levelBytes(format, width, height));
+
+	if (!isCompressed(format)) {
+		int channels = format == BAKED_RGBA8 ? 4 : 3;
+		for (size_t i = 0; i < (size_t)width * height; i++) {
+			for (int c = 0; c < channels; c++) {
+				level->data[i * channels + c] = rgba[i * 4 + c];
+			}
+		}
+		return;
+	}
+
+	unsigned char* out = level->data.data();
+	unsigned char block[16 * 4];
+	for (uint32_t by = 0; by < height; by += 4) {
+		for (uint32_t bx = 0; bx < width; bx += 4) {
+			// edge blocks repeat the last row/column
+			for (uint32_t y = 0; y < 4; y++) {
+				for (uint32_t x = 0; x < 4; x++) {
+					uint32_t sx = std::min(bx + x, width - 1);
+					uint32_t sy = std::min(by + y, height - 1);
+					std::copy(&rgba[(sy * width + sx) * 4], &rgba[(sy * width + sx) * 4] + 4, &block[(y * 4 + x) * 4]);
+				}
+			}
+			if (format == BAKED_BC3) {
+				encodeAlphaBlock(block, out);
+				out += 8;
+			}
+			encodeColorBlock(block, out);
+			out += 8;
+		}
+	}
+}
+
+void bakeMipChain(
+		const unsigned char* pixels,
+		const int& width,
+		const int& height,
+		const int& channels,
+		const BakedTextureFormat& format,
+		BakedTexture* texture
+) {
+	texture->format = format;
+	texture->levels.clear();
+
+	// widen everything to RGBA so one filter and one encoder cover all inputs
+	std::vector<unsigned char> rgba((size_t)width * height * 4);
+	for (size_t i = 0; i < (size_t)width * height; i++) {
+		const unsigned char* texel = pixels + i * channels;
+		unsigned char* dst = &rgba[i * 4];
+		if (channels < 3) {
+			dst[0] = dst[1] = dst[2] = texel[0];
+			dst[3] = channels == 2 ? texel[1] : 255;
+		} else {
+			dst[0] = texel[0];
+			dst[1] = texel[1];
+			dst[2] = texel[2];
+			dst[3] = channels == 4 ? texel[3] : 255;
+		}
+	}
+
+	uint32_t w = width;
+	uint32_t h = height;
+	for (;;) {
+		texture->levels.emplace_back();
+		encodeLevel(rgba, w, h, format, &texture->levels.back());
+		if (w == 1 && h == 1) break;
+
+		uint32_t next_w = std::max(w / 2, 1u);
+		uint32_t next_h = std::max(h / 2, 1u);
+		std::vector<unsigned char> next((size_t)next_w * next_h * 4);
+		for (uint32_t y = 0; y < next_h; y++) {
+			for (uint32_t x = 0; x < next_w; x++) {
+				uint32_t x0 = std::min(x * 2, w - 1), x1 = std::min(x * 2 + 1, w - 1);
+				uint32_t y0 = std::min(y * 2, h - 1), y1 = std::min(y * 2 + 1, h - 1);
+				for (int c = 0; c < 4; c++) {
+					int sum = rgba[(y0 * w + x0) * 4 + c] + rgba[(y0 * w + x1) * 4 + c]
+					          + rgba[(y1 * w + x0) * 4 + c] + rgba[(y1 * w + x1) * 4 + c];
+					next[(y * next_w + x) * 4 + c] = (unsigned char)((sum + 2) / 4);
+				}
+			}
+		}
+		rgba.swap(next);
+		w = next_w;
+		h = next_h;
+	}
+}
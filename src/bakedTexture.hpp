@@ -0,0 +1,59 @@
+#ifndef PROCEDURALWORLD_BAKEDTEXTURE_HPP
+#define PROCEDURALWORLD_BAKEDTEXTURE_HPP
+
+#include <string>
+#include <vector>
+#include <cstdint>
+
+// Textures baked ahead of time by bake_textures sit next to their source image with
+// this extension, e.g. stoneC.jpg -> stoneC.pwtex. The container is a small header
+// followed by every mip level, largest first:
+//
+//   "PWTX" | version | format | width | height | level count | flipped
+//   per level: width | height | byte count | bytes
+//
+// All fields are little endian uint32.
+const std::string BAKED_TEXTURE_EXTENSION = ".pwtex";
+
+enum BakedTextureFormat : uint32_t {
+	BAKED_RGB8 = 0,
+	BAKED_RGBA8 = 1,
+	BAKED_BC1 = 2, // DXT1, 4 bits per texel, no alpha
+	BAKED_BC3 = 3  // DXT5, 8 bits per texel, interpolated alpha
+};
+
+struct BakedTextureLevel {
+	uint32_t width;
+	uint32_t height;
+	std::vector<unsigned char> data;
+};
+
+struct BakedTexture {
+	BakedTextureFormat format;
+	bool flipped;
+	std::vector<BakedTextureLevel> levels;
+};
+
+// stoneC.jpg -> stoneC.pwtex
+std::string bakedTexturePath(const std::string& source_path);
+
+// Returns false when there is no baked file, throws std::runtime_error when there
+// is one but it is malformed.
+bool readBakedTexture(const std::string& path, BakedTexture* texture);
+
+void writeBakedTexture(const std::string& path, const BakedTexture& texture);
+
+bool isCompressed(const BakedTextureFormat& format);
+
+// Box filters pixels (tightly packed, channels per texel) down to a full mip chain
+// and encodes each level into format. RGB8/RGBA8 keep the data as is.
+void bakeMipChain(
+		const unsigned char* pixels,
+		const int& width,
+		const int& height,
+		const int& channels,
+		const BakedTextureFormat& format,
+		BakedTexture* texture
+);
+
+#endif //PROCEDURALWORLD_BAKEDTEXTURE_HPP
@@ -13,6 +13,11 @@ static const int COLOR_TREE = 6;
 static const int COLOR_SKY_TEXTURE = 7;
 static const int COLOR_FONT = 8;
 
+// how the vertex shader shapes a shared mesh, see Rock and RockB
+static const int DISPLACE_NONE = 0;
+static const int DISPLACE_JITTER = 1;
+static const int DISPLACE_RADIAL = 2;
+
 static unsigned int FONT_STYLE_MYTHOS = 1;
 static unsigned int FONT_STYLE_OUTLINE = 2;
 
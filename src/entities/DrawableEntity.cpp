@@ -17,6 +17,8 @@
 #include "Light.h"
 #include "Entity.hpp"
 #include "DrawableEntity.hpp"
+#include "../TextureManager.hpp"
+#include "../constants.hpp"
 
 DrawableEntity::DrawableEntity(const GLuint &shader_program, Entity *parent) : Entity(parent) {
     static std::string invalid_program_error = "Must supply valid shader program id.";
@@ -63,17 +65,31 @@ GLuint DrawableEntity::getTextureId()
     return texture_id;
 }
 
-void DrawableEntity::draw(
+int DrawableEntity::getTextureLayer()
+{
+    return -1;
+}
+
+const MeshBounds* DrawableEntity::getMeshBounds() const
+{
+    return nullptr;
+}
+
+int DrawableEntity::getDisplacementType()
+{
+    return DISPLACE_NONE;
+}
+
+GLuint DrawableEntity::getDisplacementSeed()
+{
+    return 0;
+}
+
+void DrawableEntity::prepareDraw(
     const glm::mat4& view_matrix,
     const glm::mat4& projection_matrix,
     const Light& light
 ) {
-	Entity::draw(view_matrix, projection_matrix, light);
-
-	if (this->isHidden()) {
-		return;
-	}
-
 	auto mvp_matrix_loc = (GLuint)glGetUniformLocation(this->shader_program, "mvp_matrix");
     auto model_loc = (GLuint)glGetUniformLocation(this->shader_program, "model");
     auto color_type_loc = (GLuint)glGetUniformLocation(this->shader_program, "color_type");
@@ -94,6 +110,12 @@ void DrawableEntity::draw(
 	auto point_light_color_loc = (GLuint)glGetUniformLocation(this->shader_program, "pointLight.color");
 
 	auto use_texture_loc = (GLuint)glGetUniformLocation(this->shader_program, "use_texture");
+	auto texture_layer_loc = (GLuint)glGetUniformLocation(this->shader_program, "texture_layer");
+	auto tex_array_loc = (GLuint)glGetUniformLocation(this->shader_program, "tex_array");
+	auto leaf_models_loc = (GLuint)glGetUniformLocation(this->shader_program, "leaf_models");
+
+	auto displacement_type_loc = (GLuint)glGetUniformLocation(this->shader_program, "displacement_type");
+	auto displacement_seed_loc = (GLuint)glGetUniformLocation(this->shader_program, "displacement_seed");
 
 	auto fog_color_loc = (GLuint)glGetUniformLocation(this->shader_program, "fog_color");
 	auto daytime_value_loc = (GLuint)glGetUniformLocation(this->shader_program, "daytime_value");
@@ -134,13 +156,44 @@ void DrawableEntity::draw(
 	glUniform1f(daytime_value_loc, light.daytime_value);
 	glUniform1f(nighttime_value_loc, light.nighttime_value);
 
+	glUniform1i(displacement_type_loc, this->getDisplacementType());
+	glUniform1ui(displacement_seed_loc, this->getDisplacementSeed());
+
 	GLuint texture_id = this->getTextureId();
-	glUniform1i(use_texture_loc, texture_id != UINT_MAX);
+	int texture_layer = this->getTextureLayer();
+	glUniform1i(use_texture_loc, texture_id != UINT_MAX || texture_layer >= 0);
+	glUniform1i(texture_layer_loc, texture_layer);
+	// the material array lives on texture unit 1, see TextureManager::bind
+	glUniform1i(tex_array_loc, 1);
+	// and the tree leaves on unit 2, see TreePrototypeCache::bindLeaves
+	glUniform1i(leaf_models_loc, 2);
 
 	// TODO: figure out why the commented-out code below fails on macOS
 	// glUniform1i(tex_image_loc, GL_TEXTURE0);
 	// glActiveTexture(GL_TEXTURE0);
 
+	// consecutive draws with the same texture (e.g. all the trees of a tile)
+	// don't rebind it
+	if (texture_layer >= 0) {
+		TextureManager::bind(GL_TEXTURE_2D_ARRAY, TextureManager::getMaterialArrayId());
+	} else if (texture_id != UINT_MAX) {
+		TextureManager::bind(GL_TEXTURE_2D, texture_id);
+	}
+}
+
+void DrawableEntity::draw(
+    const glm::mat4& view_matrix,
+    const glm::mat4& projection_matrix,
+    const Light& light
+) {
+	Entity::draw(view_matrix, projection_matrix, light);
+
+	if (this->isHidden()) {
+		return;
+	}
+
+	this->prepareDraw(view_matrix, projection_matrix, light);
+
 	// Draw
 	glBindVertexArray(this->getVAO());
 	GLenum draw_mode = this->getDrawMode();
@@ -149,8 +202,6 @@ void DrawableEntity::draw(
 		// it's inefficient and useless to use glDrawElements for a point cloud
 		glDrawArrays(draw_mode, 0, (GLuint) this->getVertices().size());
 	} else {
-		glBindTexture(GL_TEXTURE_2D, texture_id);
-
 		int element_buffer_array_size;
 		glGetBufferParameteriv(GL_ELEMENT_ARRAY_BUFFER, GL_BUFFER_SIZE,
 		                       &element_buffer_array_size);
@@ -13,6 +13,8 @@
 #include "Light.h"
 #include "Entity.hpp"
 
+class MeshBounds;
+
 // Abstract class
 
 class DrawableEntity : public Entity {
@@ -71,7 +73,20 @@ public:
 	virtual const int getColorType() = 0;
 	// end pure virtual functions
 	virtual GLuint getTextureId();
+	// layer in the shared material texture array, used instead of getTextureId when >= 0
+	virtual int getTextureLayer();
+	// sliced stand-in for getVertices() used by hit boxes, for meshes that don't keep their vertices
+	virtual const MeshBounds* getMeshBounds() const;
+	// DISPLACE_NONE, or how the vertex shader moves this entity's vertices and normals with the seed
+	virtual int getDisplacementType();
+	virtual GLuint getDisplacementSeed();
 	GLenum getDrawMode();
+	// binds the shader program and sets every uniform and texture the entity is drawn with
+	void prepareDraw(
+		const glm::mat4& view_matrix,
+		const glm::mat4& projection_matrix,
+		const Light& light
+	);
 	void draw(
 		const glm::mat4& view_matrix,
 		const glm::mat4& projection_matrix,
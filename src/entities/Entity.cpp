@@ -8,9 +8,12 @@
 #include <glm/glm.hpp>
 #include <glm/gtc/matrix_transform.hpp>
 #include <glm/gtc/type_ptr.hpp>
+#include <glm/gtc/quaternion.hpp>
 #include <vector>
+#include <cmath>
 
 #include "Entity.hpp"
+#include "TransformSystem.hpp"
 #include "../utils.hpp"
 
 Entity::Entity(Entity* parent)
@@ -25,6 +28,8 @@ Entity::Entity(Entity* parent)
 	if (parent) {
 		parent->children.push_back(this);
 	}
+	this->transform = TransformSystem::create(
+			this, parent ? parent->transform : TransformSystem::no_handle);
 
 	this->opacity = 1.0f;
 
@@ -32,23 +37,20 @@ Entity::Entity(Entity* parent)
 	this->hidden = false;
 }
 
-const glm::mat4 Entity::getModelMatrix() const
+Entity::~Entity()
 {
-	static glm::mat4 identity;
-
-	// if we have a parent entity we want to adjust our transformation
-	// to incorporate the context of the parent's transformation
-	glm::mat4 parent_model_matrix = this->parent ? this->parent->getModelMatrix() : identity;
+	TransformSystem::destroy(this->transform);
+}
 
-	return (parent_model_matrix *
-			this->translation_matrix * this->getBaseTranslation() *
-			this->rotation_matrix * this->getBaseRotation() *
-			this->scale_matrix * this->getBaseScale());
+const glm::mat4 Entity::getModelMatrix() const
+{
+	// the parent's model matrix times our own, kept up to date by TransformSystem::update
+	return TransformSystem::getWorldMatrix(this->transform);
 }
 
 glm::vec3 Entity::getPosition() const
 {
-	return utils::getTranslationVector(this->translation_matrix);
+	return TransformSystem::getPosition(this->transform);
 }
 
 float Entity::getOpacity()
@@ -58,7 +60,7 @@ float Entity::getOpacity()
 
 glm::vec3 Entity::getScale() const
 {
-	return utils::getScaleVector(this->scale_matrix);
+	return TransformSystem::getScale(this->transform);
 }
 
 bool Entity::isHidden()
@@ -69,28 +71,27 @@ bool Entity::isHidden()
 
 void Entity::scale(const float& scalar)
 {
-	this->scale_matrix = glm::scale(this->scale_matrix, glm::vec3(scalar));
+	this->scale(glm::vec3(scalar));
 }
 
 void Entity::scale(const glm::vec3& scale_vector){
-    this->scale_matrix = glm::scale(this->scale_matrix, scale_vector);
+    TransformSystem::setScale(this->transform, TransformSystem::getScale(this->transform) * scale_vector);
 }
 
 void Entity::rotate(const float& angle, const glm::vec3& axis)
 {
 	// rotation angle is in radians
-	this->rotation_matrix = glm::rotate(this->rotation_matrix, angle, axis);
+	TransformSystem::setRotation(this->transform, glm::normalize(
+			TransformSystem::getRotation(this->transform) * glm::angleAxis(angle, glm::normalize(axis))));
 }
 
 void Entity::resetRotation()
 {
-	static glm::mat4 identity;
-	this->rotation_matrix = identity;
+	TransformSystem::setRotation(this->transform, glm::quat());
 }
 
 void Entity::translate(const glm::vec3& translation_vec) {
-    this->translation_matrix = glm::translate(
-            this->translation_matrix, translation_vec);
+    TransformSystem::setPosition(this->transform, TransformSystem::getPosition(this->transform) + translation_vec);
 }
 
 void Entity::moveForward(const glm::vec3& view_vec, const glm::vec3& up_vec, const float& units)
@@ -98,10 +99,7 @@ void Entity::moveForward(const glm::vec3& view_vec, const glm::vec3& up_vec, con
 	glm::vec3 left_vec = glm::cross(up_vec, view_vec);
 	glm::vec3 forward_vec = glm::cross(left_vec, up_vec);
 
-	this->translation_matrix = glm::translate(
-			this->translation_matrix,
-			(float)units * glm::normalize(forward_vec)
-	);
+	this->translate((float)units * glm::normalize(forward_vec));
 	this->orient(forward_vec);
 }
 
@@ -109,30 +107,21 @@ void Entity::moveBack(const glm::vec3& view_vec, const glm::vec3& up_vec, const
 {
 	glm::vec3 left_vec = glm::cross(up_vec, view_vec);
 	glm::vec3 back_vec = -1.0f * glm::cross(left_vec, up_vec);
-	this->translation_matrix = glm::translate(
-			this->translation_matrix,
-			(float)units * glm::normalize(back_vec)
-	);
+	this->translate((float)units * glm::normalize(back_vec));
 	this->orient(back_vec);
 }
 
 void Entity::moveLeft(const glm::vec3& view_vec, const glm::vec3& up_vec, const float& units)
 {
 	glm::vec3 left_vec = glm::cross(up_vec, view_vec);
-	this->translation_matrix = glm::translate(
-			this->translation_matrix,
-			(float)units * glm::normalize(left_vec)
-	);
+	this->translate((float)units * glm::normalize(left_vec));
 	this->orient(left_vec);
 }
 
 void Entity::moveRight(const glm::vec3& view_vec, const glm::vec3& up_vec, const float& units)
 {
 	glm::vec3 right_vec = -1.0f * glm::cross(up_vec, view_vec);
-	this->translation_matrix = glm::translate(
-			this->translation_matrix,
-			(float)units * glm::normalize(right_vec)
-	);
+	this->translate((float)units * glm::normalize(right_vec));
 	this->orient(right_vec);
 }
 
@@ -145,10 +134,7 @@ void Entity::moveForwardLeft(
 	glm::vec3 forward_vec = glm::cross(left_vec, up_vec);
 	glm::vec3 forward_left_vec = forward_vec + left_vec;
 
-	this->translation_matrix = glm::translate(
-		this->translation_matrix,
-		(float)units * glm::normalize(forward_left_vec)
-	);
+	this->translate((float)units * glm::normalize(forward_left_vec));
 	this->orient(forward_left_vec);
 }
 
@@ -161,10 +147,7 @@ void Entity::moveForwardRight(
 	glm::vec3 forward_vec = glm::cross(left_vec, up_vec);
 	glm::vec3 forward_right_vec = forward_vec - left_vec;
 
-	this->translation_matrix = glm::translate(
-		this->translation_matrix,
-		(float)units * glm::normalize(forward_right_vec)
-	);
+	this->translate((float)units * glm::normalize(forward_right_vec));
 	this->orient(forward_right_vec);
 }
 
@@ -177,10 +160,7 @@ void Entity::moveBackLeft(
 	glm::vec3 forward_vec = glm::cross(left_vec, up_vec);
 	glm::vec3 back_left_vec = -1.0f * forward_vec + left_vec;
 
-	this->translation_matrix = glm::translate(
-		this->translation_matrix,
-		(float)units * glm::normalize(back_left_vec)
-	);
+	this->translate((float)units * glm::normalize(back_left_vec));
 	this->orient(back_left_vec);
 }
 
@@ -193,18 +173,13 @@ void Entity::moveBackRight(
 	glm::vec3 forward_vec = glm::cross(left_vec, up_vec);
 	glm::vec3 back_right_vec = -1.0f * (forward_vec + left_vec);
 
-	this->translation_matrix = glm::translate(
-		this->translation_matrix,
-		(float)units * glm::normalize(back_right_vec)
-	);
+	this->translate((float)units * glm::normalize(back_right_vec));
 	this->orient(back_right_vec);
 }
 
 void Entity::setPosition(const glm::vec3& position)
 {
-	static glm::mat4 identity;
-
-	this->translation_matrix = glm::translate(identity, position);
+	TransformSystem::setPosition(this->transform, position);
 }
 
 void Entity::setOpacity(const float& opacity)
@@ -248,16 +223,22 @@ void Entity::draw(
 
 void Entity::orient(const glm::vec3& new_face_vec)
 {
-	static glm::mat4 identity;
+	const glm::vec3 face_vec = glm::normalize(this->getDefaultFaceVector());
+	const glm::vec3 to_vec = glm::normalize(new_face_vec);
+	// compute the angle between the default face vector and our new face vector
+	const float cos_angle = glm::clamp(glm::dot(face_vec, to_vec), -1.0f, 1.0f);
+	// compute the cross product as the rotation axis
+	glm::vec3 axis = glm::cross(face_vec, to_vec);
+	if (glm::length(axis) < 1e-6f) {
+		// facing straight toward or away from it, any axis across the face vector turns it around
+		axis = glm::cross(face_vec, glm::vec3(1.0f, 0.0f, 0.0f));
+		if (glm::length(axis) < 1e-6f) {
+			axis = glm::cross(face_vec, glm::vec3(0.0f, 1.0f, 0.0f));
+		}
+	}
 
-	// re-write our rotation matrix to orient our model toward the given vector
-	this->rotation_matrix = glm::rotate(
-			identity,
-			// compute the angle between the default face vector and our new face vector
-			(float)acos(glm::dot(glm::normalize(this->getDefaultFaceVector()), glm::normalize(new_face_vec))),
-			// compute the cross product as the rotation axis
-			glm::cross(this->getDefaultFaceVector(), new_face_vec)
-	);
+	// re-write our rotation to orient our model toward the given vector
+	TransformSystem::setRotation(this->transform, glm::angleAxis((float)acos(cos_angle), glm::normalize(axis)));
 }
 
 // derived classes should override this if the model
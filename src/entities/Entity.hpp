@@ -9,17 +9,16 @@
 #endif
 
 #include "Light.h"
+#include "TransformSystem.hpp"
 #include <glm/glm.hpp>
 #include <vector>
 
+// An entity's position, rotation and scale live in the TransformSystem, it only keeps a handle to them
 class Entity {
 private:
 	Entity* parent;
 	std::vector<Entity*> children;
-	glm::mat4 scale_matrix;
-	glm::mat4 rotation_matrix;
-    glm::mat4 translation_matrix;
-	glm::mat4 model_matrix;
+	TransformSystem::Handle transform;
 	float opacity;
 	bool hidden;
 	void orient(const glm::vec3& forward_vec);
@@ -32,11 +31,14 @@ protected:
 	// this method is NOT responsible for freeing memory
 	// and does NOT remove the parent pointer from the child
 	void detachChild(Entity* const& child);
+	friend class TransformSystem;
 
 public:
 	Entity() : Entity(nullptr) {}
 	explicit Entity(Entity* parent);
-	virtual ~Entity() = default;
+	virtual ~Entity();
+	Entity(const Entity&) = delete;
+	Entity& operator=(const Entity&) = delete;
 	const glm::mat4 getModelMatrix() const;
 	glm::vec3 getPosition() const;
 	glm::vec3 getScale() const;
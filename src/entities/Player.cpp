@@ -12,6 +12,7 @@
 #include "Entity.hpp"
 #include "DrawableEntity.hpp"
 #include "Player.hpp"
+#include "../MeshBounds.hpp"
 #include "../objloader.hpp"
 #include "../constants.hpp"
 
@@ -26,6 +27,7 @@ Player::Player(const GLuint& shader_program, Entity* parent) : DrawableEntity(sh
 
 	// get the vertices from the pacman.obj file (ignore the rest)
 	loadOBJ("../models/pumpkin.obj", &this->vertices, &normals, &UVs, &elements);
+	this->bounds = MeshBounds(this->vertices);
 
 	this->vao = this->initVertexArray(
 		this->vertices,
@@ -45,6 +47,11 @@ const std::vector<glm::vec3>& Player::getVertices() const
 	return this->vertices;
 }
 
+const MeshBounds* Player::getMeshBounds() const
+{
+	return &this->bounds;
+}
+
 GLuint Player::getVAO()
 {
 	return this->vao;
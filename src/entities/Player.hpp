@@ -13,6 +13,7 @@
 
 #include "Entity.hpp"
 #include "DrawableEntity.hpp"
+#include "../MeshBounds.hpp"
 
 class Player: public DrawableEntity {
 private:
@@ -22,21 +23,17 @@ private:
 	const glm::mat4& getBaseScale() const override;
 	const glm::vec3& getDefaultFaceVector() const override;
 	std::vector<glm::vec3> vertices;
+	// for the hit box built on every move
+	MeshBounds bounds;
 	GLuint vao;
 
 public:
 	explicit Player(const GLuint& shader_program) : Player(shader_program, nullptr) {}
 	Player(const GLuint& shader_program, Entity* parent);
 	const std::vector<glm::vec3>& getVertices() const override;
+	const MeshBounds* getMeshBounds() const override;
 	GLuint getVAO() override;
 	const int getColorType() override;
-
-	static constexpr int deadMax = 20;
-	int deadTime =  deadMax;
-	glm::vec3 oldPosition;
-
-	void updateDeadtime();
-	bool fore, back, left, right;
 };
 
 #endif // COMP371_PLAYER_HPP
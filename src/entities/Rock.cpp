@@ -15,9 +15,13 @@
 #include "Rock.hpp"
 
 #include "../constants.hpp"
-#include "../loadTexture.hpp"
+#include "../TextureManager.hpp"
 #include "../utils.hpp"
+#include "../MeshNormals.hpp"
 
+constexpr float Rock::min_jitter;
+constexpr float Rock::max_jitter;
+Rock::Shape Rock::shape;
 
 Rock::Rock(
     const GLuint &shader_program,
@@ -27,6 +31,39 @@ Rock::Rock(
     const float &z_span,
     Entity *parent
 ) : DrawableEntity(shader_program, parent)
+{
+    this->draw_mode = GL_TRIANGLES;
+
+    // modified obsidian material from
+    // Advanced Graphics Programming Using OpenGL
+    // by Tom McReynolds and David Blythe
+    // and copied from slides from COMP371 at Concordia:
+    // http://poullis.org/courses/2017/Fall/COMP371/resources/COMP371F17_LightingandShading.pdf
+
+    float ambientR =  utils::randomFloat(0.02f, 0.7f);
+    float ambientG = utils::randomFloat(0.02f, 0.07f);
+    float ambientB = utils::randomFloat(0.05f, 0.1f);
+
+    float diffuseR = utils::randomFloat(0.65f, 0.75f);
+    float diffuseG = utils::randomFloat(0.65f, 0.75f);
+    float diffuseB = utils::randomFloat(0.7f, 0.85f);
+
+    float shininess = utils::randomFloat(38.4f, 42.8f);
+
+	this->setMaterial(
+		glm::vec3(ambientR, ambientG, ambientB),
+		glm::vec3(diffuseR, diffuseG, diffuseB),
+		glm::vec3(0.332741, 0.328634, 0.346435),
+		shininess
+	);
+
+    this->seed = utils::hashLocation(world_x_location, world_z_location);
+    if (shape.vao == 0) {
+        buildShape();
+    }
+}
+
+void Rock::buildShape()
 {
     static const std::vector<GLuint> elements = {
         24, 19, 18, 23, 24, 18, 23, 18, 17, 22, 23, 17, 22, 17, 16, 21, 22, 16, 21, 16, 15, 20, 21, 15, 19, 14, 13, 18, 19, 13, 18, 13, 12, 17, 18, 12, 17, 12, 11, 16, 17, 11, 16, 11, 10, 15, 16, 10, 14, 9, 8, 13, 14, 8, 13, 8, 7, 12, 13, 7, 12, 7, 6, 11, 12, 6, 11, 6, 5, 10, 11, 5, 9, 4, 3, 8, 9, 3, 8, 3, 2, 7, 8, 2, 7, 2, 1, 6, 7, 1, 6, 1, 0, 5, 6, 0,
@@ -233,312 +270,255 @@ Rock::Rock(
             glm::vec2(1.00f, 1.00f)
     };
 
-    this->draw_mode = GL_TRIANGLES;
-
-    // modified obsidian material from
-    // Advanced Graphics Programming Using OpenGL
-    // by Tom McReynolds and David Blythe
-    // and copied from slides from COMP371 at Concordia:
-    // http://poullis.org/courses/2017/Fall/COMP371/resources/COMP371F17_LightingandShading.pdf
-
-    float ambientR =  utils::randomFloat(0.02f, 0.7f);
-    float ambientG = utils::randomFloat(0.02f, 0.07f);
-    float ambientB = utils::randomFloat(0.05f, 0.1f);
-
-    float diffuseR = utils::randomFloat(0.65f, 0.75f);
-    float diffuseG = utils::randomFloat(0.65f, 0.75f);
-    float diffuseB = utils::randomFloat(0.7f, 0.85f);
-
-    float shininess = utils::randomFloat(38.4f, 42.8f);
-
-	this->setMaterial(
-		glm::vec3(ambientR, ambientG, ambientB),
-		glm::vec3(diffuseR, diffuseG, diffuseB),
-		glm::vec3(0.332741, 0.328634, 0.346435),
-		shininess
-	);
-
     //bottom face (5x5 between 0 - 1)
-    this->vertices.emplace_back(0.00f, 0.00f, 0.00f);
-    this->vertices.emplace_back(0.25f, 0.00f, 0.00f);
-    this->vertices.emplace_back(0.50f, 0.00f, 0.00f);
-    this->vertices.emplace_back(0.75f, 0.00f, 0.00f);
-    this->vertices.emplace_back(1.00f, 0.00f, 0.00f);
-
-    this->vertices.emplace_back(0.00f, 0.00f, -0.25f);
-    this->vertices.emplace_back(0.25f, 0.00f, -0.25f);
-    this->vertices.emplace_back(0.50f, 0.00f, -0.25f);
-    this->vertices.emplace_back(0.75f, 0.00f, -0.25f);
-    this->vertices.emplace_back(1.00f, 0.00f, -0.25f);
-
-    this->vertices.emplace_back(0.00f, 0.00f, -0.50f);
-    this->vertices.emplace_back(0.25f, 0.00f, -0.50f);
-    this->vertices.emplace_back(0.50f, 0.00f, -0.50f);
-    this->vertices.emplace_back(0.75f, 0.00f, -0.50f);
-    this->vertices.emplace_back(1.00f, 0.00f, -0.50f);
-
-    this->vertices.emplace_back(0.00f, 0.00f, -0.75f);
-    this->vertices.emplace_back(0.25f, 0.00f, -0.75f);
-    this->vertices.emplace_back(0.50f, 0.00f, -0.75f);
-    this->vertices.emplace_back(0.75f, 0.00f, -0.75f);
-    this->vertices.emplace_back(1.00f, 0.00f, -0.75f);
-
-    this->vertices.emplace_back(0.00f, 0.00f, -1.0f);
-    this->vertices.emplace_back(0.25f, 0.00f, -1.0f);
-    this->vertices.emplace_back(0.50f, 0.00f, -1.0f);
-    this->vertices.emplace_back(0.75f, 0.00f, -1.0f);
-    this->vertices.emplace_back(1.00f, 0.00f, -1.0f);
+    shape.vertices.emplace_back(0.00f, 0.00f, 0.00f);
+    shape.vertices.emplace_back(0.25f, 0.00f, 0.00f);
+    shape.vertices.emplace_back(0.50f, 0.00f, 0.00f);
+    shape.vertices.emplace_back(0.75f, 0.00f, 0.00f);
+    shape.vertices.emplace_back(1.00f, 0.00f, 0.00f);
+
+    shape.vertices.emplace_back(0.00f, 0.00f, -0.25f);
+    shape.vertices.emplace_back(0.25f, 0.00f, -0.25f);
+    shape.vertices.emplace_back(0.50f, 0.00f, -0.25f);
+    shape.vertices.emplace_back(0.75f, 0.00f, -0.25f);
+    shape.vertices.emplace_back(1.00f, 0.00f, -0.25f);
+
+    shape.vertices.emplace_back(0.00f, 0.00f, -0.50f);
+    shape.vertices.emplace_back(0.25f, 0.00f, -0.50f);
+    shape.vertices.emplace_back(0.50f, 0.00f, -0.50f);
+    shape.vertices.emplace_back(0.75f, 0.00f, -0.50f);
+    shape.vertices.emplace_back(1.00f, 0.00f, -0.50f);
+
+    shape.vertices.emplace_back(0.00f, 0.00f, -0.75f);
+    shape.vertices.emplace_back(0.25f, 0.00f, -0.75f);
+    shape.vertices.emplace_back(0.50f, 0.00f, -0.75f);
+    shape.vertices.emplace_back(0.75f, 0.00f, -0.75f);
+    shape.vertices.emplace_back(1.00f, 0.00f, -0.75f);
+
+    shape.vertices.emplace_back(0.00f, 0.00f, -1.0f);
+    shape.vertices.emplace_back(0.25f, 0.00f, -1.0f);
+    shape.vertices.emplace_back(0.50f, 0.00f, -1.0f);
+    shape.vertices.emplace_back(0.75f, 0.00f, -1.0f);
+    shape.vertices.emplace_back(1.00f, 0.00f, -1.0f);
 
     //left (side) face
-    this->vertices.emplace_back(0.00f, 0.00f, 0.00f);
-    this->vertices.emplace_back(0.00f, 0.00f, -0.25f);
-    this->vertices.emplace_back(0.00f, 0.00f, -0.50f);
-    this->vertices.emplace_back(0.00f, 0.00f, -0.75f);
-    this->vertices.emplace_back(0.00f, 0.00f, -1.00f);
-
-    this->vertices.emplace_back(0.00f, 0.25f, 0.00f);
-    this->vertices.emplace_back(0.00f, 0.25f, -0.25f);
-    this->vertices.emplace_back(0.00f, 0.25f, -0.50f);
-    this->vertices.emplace_back(0.00f, 0.25f, -0.75f);
-    this->vertices.emplace_back(0.00f, 0.25f, -1.00f);
-
-    this->vertices.emplace_back(0.00f, 0.50f, 0.00f);
-    this->vertices.emplace_back(0.00f, 0.50f, -0.25f);
-    this->vertices.emplace_back(0.00f, 0.50f, -0.50f);
-    this->vertices.emplace_back(0.00f, 0.50f, -0.75f);
-    this->vertices.emplace_back(0.00f, 0.50f, -1.00f);
-
-    this->vertices.emplace_back(0.00f, 0.75f, 0.00f);
-    this->vertices.emplace_back(0.00f, 0.75f, -0.25f);
-    this->vertices.emplace_back(0.00f, 0.75f, -0.50f);
-    this->vertices.emplace_back(0.00f, 0.75f, -0.75f);
-    this->vertices.emplace_back(0.00f, 0.75f, -1.00f);
-
-    this->vertices.emplace_back(0.00f, 1.00f, 0.00f);
-    this->vertices.emplace_back(0.00f, 1.00f, -0.25f);
-    this->vertices.emplace_back(0.00f, 1.00f, -0.50f);
-    this->vertices.emplace_back(0.00f, 1.00f, -0.75f);
-    this->vertices.emplace_back(0.00f, 1.00f, -1.00f);
+    shape.vertices.emplace_back(0.00f, 0.00f, 0.00f);
+    shape.vertices.emplace_back(0.00f, 0.00f, -0.25f);
+    shape.vertices.emplace_back(0.00f, 0.00f, -0.50f);
+    shape.vertices.emplace_back(0.00f, 0.00f, -0.75f);
+    shape.vertices.emplace_back(0.00f, 0.00f, -1.00f);
+
+    shape.vertices.emplace_back(0.00f, 0.25f, 0.00f);
+    shape.vertices.emplace_back(0.00f, 0.25f, -0.25f);
+    shape.vertices.emplace_back(0.00f, 0.25f, -0.50f);
+    shape.vertices.emplace_back(0.00f, 0.25f, -0.75f);
+    shape.vertices.emplace_back(0.00f, 0.25f, -1.00f);
+
+    shape.vertices.emplace_back(0.00f, 0.50f, 0.00f);
+    shape.vertices.emplace_back(0.00f, 0.50f, -0.25f);
+    shape.vertices.emplace_back(0.00f, 0.50f, -0.50f);
+    shape.vertices.emplace_back(0.00f, 0.50f, -0.75f);
+    shape.vertices.emplace_back(0.00f, 0.50f, -1.00f);
+
+    shape.vertices.emplace_back(0.00f, 0.75f, 0.00f);
+    shape.vertices.emplace_back(0.00f, 0.75f, -0.25f);
+    shape.vertices.emplace_back(0.00f, 0.75f, -0.50f);
+    shape.vertices.emplace_back(0.00f, 0.75f, -0.75f);
+    shape.vertices.emplace_back(0.00f, 0.75f, -1.00f);
+
+    shape.vertices.emplace_back(0.00f, 1.00f, 0.00f);
+    shape.vertices.emplace_back(0.00f, 1.00f, -0.25f);
+    shape.vertices.emplace_back(0.00f, 1.00f, -0.50f);
+    shape.vertices.emplace_back(0.00f, 1.00f, -0.75f);
+    shape.vertices.emplace_back(0.00f, 1.00f, -1.00f);
 
 
     //back face (5x5 between 0 - 1)
-    this->vertices.emplace_back(0.00f, 0.00f, -1.00f);
-    this->vertices.emplace_back(0.25f, 0.00f, -1.00f);
-    this->vertices.emplace_back(0.50f, 0.00f, -1.00f);
-    this->vertices.emplace_back(0.75f, 0.00f, -1.00f);
-    this->vertices.emplace_back(1.00f, 0.00f, -1.00f);
-
-    this->vertices.emplace_back(0.00f, 0.25f, -1.00f);
-    this->vertices.emplace_back(0.25f, 0.25f, -1.00f);
-    this->vertices.emplace_back(0.50f, 0.25f, -1.00f);
-    this->vertices.emplace_back(0.75f, 0.25f, -1.00f);
-    this->vertices.emplace_back(1.00f, 0.25f, -1.00f);
-
-    this->vertices.emplace_back(0.00f, 0.50f, -1.00f);
-    this->vertices.emplace_back(0.25f, 0.50f, -1.00f);
-    this->vertices.emplace_back(0.50f, 0.50f, -1.00f);
-    this->vertices.emplace_back(0.75f, 0.50f, -1.00f);
-    this->vertices.emplace_back(1.00f, 0.50f, -1.00f);
-
-    this->vertices.emplace_back(0.00f, 0.75f, -1.00f);
-    this->vertices.emplace_back(0.25f, 0.75f, -1.00f);
-    this->vertices.emplace_back(0.50f, 0.75f, -1.00f);
-    this->vertices.emplace_back(0.75f, 0.75f, -1.00f);
-    this->vertices.emplace_back(1.00f, 0.75f, -1.00f);
-
-    this->vertices.emplace_back(0.00f, 1.00f, -1.0f);
-    this->vertices.emplace_back(0.25f, 1.00f, -1.0f);
-    this->vertices.emplace_back(0.50f, 1.00f, -1.0f);
-    this->vertices.emplace_back(0.75f, 1.00f, -1.0f);
-    this->vertices.emplace_back(1.00f, 1.00f, -1.0f);
+    shape.vertices.emplace_back(0.00f, 0.00f, -1.00f);
+    shape.vertices.emplace_back(0.25f, 0.00f, -1.00f);
+    shape.vertices.emplace_back(0.50f, 0.00f, -1.00f);
+    shape.vertices.emplace_back(0.75f, 0.00f, -1.00f);
+    shape.vertices.emplace_back(1.00f, 0.00f, -1.00f);
+
+    shape.vertices.emplace_back(0.00f, 0.25f, -1.00f);
+    shape.vertices.emplace_back(0.25f, 0.25f, -1.00f);
+    shape.vertices.emplace_back(0.50f, 0.25f, -1.00f);
+    shape.vertices.emplace_back(0.75f, 0.25f, -1.00f);
+    shape.vertices.emplace_back(1.00f, 0.25f, -1.00f);
+
+    shape.vertices.emplace_back(0.00f, 0.50f, -1.00f);
+    shape.vertices.emplace_back(0.25f, 0.50f, -1.00f);
+    shape.vertices.emplace_back(0.50f, 0.50f, -1.00f);
+    shape.vertices.emplace_back(0.75f, 0.50f, -1.00f);
+    shape.vertices.emplace_back(1.00f, 0.50f, -1.00f);
+
+    shape.vertices.emplace_back(0.00f, 0.75f, -1.00f);
+    shape.vertices.emplace_back(0.25f, 0.75f, -1.00f);
+    shape.vertices.emplace_back(0.50f, 0.75f, -1.00f);
+    shape.vertices.emplace_back(0.75f, 0.75f, -1.00f);
+    shape.vertices.emplace_back(1.00f, 0.75f, -1.00f);
+
+    shape.vertices.emplace_back(0.00f, 1.00f, -1.0f);
+    shape.vertices.emplace_back(0.25f, 1.00f, -1.0f);
+    shape.vertices.emplace_back(0.50f, 1.00f, -1.0f);
+    shape.vertices.emplace_back(0.75f, 1.00f, -1.0f);
+    shape.vertices.emplace_back(1.00f, 1.00f, -1.0f);
 
     //right (side) face
-    this->vertices.emplace_back(1.00f, 0.00f, 0.00f);
-    this->vertices.emplace_back(1.00f, 0.00f, -0.25f);
-    this->vertices.emplace_back(1.00f, 0.00f, -0.50f);
-    this->vertices.emplace_back(1.00f, 0.00f, -0.75f);
-    this->vertices.emplace_back(1.00f, 0.00f, -1.00f);
-
-    this->vertices.emplace_back(1.00f, 0.25f, 0.00f);
-    this->vertices.emplace_back(1.00f, 0.25f, -0.25f);
-    this->vertices.emplace_back(1.00f, 0.25f, -0.50f);
-    this->vertices.emplace_back(1.00f, 0.25f, -0.75f);
-    this->vertices.emplace_back(1.00f, 0.25f, -1.00f);
-
-    this->vertices.emplace_back(1.00f, 0.50f, 0.00f);
-    this->vertices.emplace_back(1.00f, 0.50f, -0.25f);
-    this->vertices.emplace_back(1.00f, 0.50f, -0.50f);
-    this->vertices.emplace_back(1.00f, 0.50f, -0.75f);
-    this->vertices.emplace_back(1.00f, 0.50f, -1.00f);
-
-    this->vertices.emplace_back(1.00f, 0.75f, 0.00f);
-    this->vertices.emplace_back(1.00f, 0.75f, -0.25f);
-    this->vertices.emplace_back(1.00f, 0.75f, -0.50f);
-    this->vertices.emplace_back(1.00f, 0.75f, -0.75f);
-    this->vertices.emplace_back(1.00f, 0.75f, -1.00f);
-
-    this->vertices.emplace_back(1.00f, 1.00f, 0.00f);
-    this->vertices.emplace_back(1.00f, 1.00f, -0.25f);
-    this->vertices.emplace_back(1.00f, 1.00f, -0.50f);
-    this->vertices.emplace_back(1.00f, 1.00f, -0.75f);
-    this->vertices.emplace_back(1.00f, 1.00f, -1.00f);
+    shape.vertices.emplace_back(1.00f, 0.00f, 0.00f);
+    shape.vertices.emplace_back(1.00f, 0.00f, -0.25f);
+    shape.vertices.emplace_back(1.00f, 0.00f, -0.50f);
+    shape.vertices.emplace_back(1.00f, 0.00f, -0.75f);
+    shape.vertices.emplace_back(1.00f, 0.00f, -1.00f);
+
+    shape.vertices.emplace_back(1.00f, 0.25f, 0.00f);
+    shape.vertices.emplace_back(1.00f, 0.25f, -0.25f);
+    shape.vertices.emplace_back(1.00f, 0.25f, -0.50f);
+    shape.vertices.emplace_back(1.00f, 0.25f, -0.75f);
+    shape.vertices.emplace_back(1.00f, 0.25f, -1.00f);
+
+    shape.vertices.emplace_back(1.00f, 0.50f, 0.00f);
+    shape.vertices.emplace_back(1.00f, 0.50f, -0.25f);
+    shape.vertices.emplace_back(1.00f, 0.50f, -0.50f);
+    shape.vertices.emplace_back(1.00f, 0.50f, -0.75f);
+    shape.vertices.emplace_back(1.00f, 0.50f, -1.00f);
+
+    shape.vertices.emplace_back(1.00f, 0.75f, 0.00f);
+    shape.vertices.emplace_back(1.00f, 0.75f, -0.25f);
+    shape.vertices.emplace_back(1.00f, 0.75f, -0.50f);
+    shape.vertices.emplace_back(1.00f, 0.75f, -0.75f);
+    shape.vertices.emplace_back(1.00f, 0.75f, -1.00f);
+
+    shape.vertices.emplace_back(1.00f, 1.00f, 0.00f);
+    shape.vertices.emplace_back(1.00f, 1.00f, -0.25f);
+    shape.vertices.emplace_back(1.00f, 1.00f, -0.50f);
+    shape.vertices.emplace_back(1.00f, 1.00f, -0.75f);
+    shape.vertices.emplace_back(1.00f, 1.00f, -1.00f);
 
     //front face (5x5 between 0 - 1)
-    this->vertices.emplace_back(0.00f, 0.00f, 0.00f);
-    this->vertices.emplace_back(0.25f, 0.00f, 0.00f);
-    this->vertices.emplace_back(0.50f, 0.00f, 0.00f);
-    this->vertices.emplace_back(0.75f, 0.00f, 0.00f);
-    this->vertices.emplace_back(1.00f, 0.00f, 0.00f);
-
-    this->vertices.emplace_back(0.00f, 0.25f, 0.00f);
-    this->vertices.emplace_back(0.25f, 0.25f, 0.00f);
-    this->vertices.emplace_back(0.50f, 0.25f, 0.00f);
-    this->vertices.emplace_back(0.75f, 0.25f, 0.00f);
-    this->vertices.emplace_back(1.00f, 0.25f, 0.00f);
-
-    this->vertices.emplace_back(0.00f, 0.50f, 0.00f);
-    this->vertices.emplace_back(0.25f, 0.50f, 0.00f);
-    this->vertices.emplace_back(0.50f, 0.50f, 0.00f);
-    this->vertices.emplace_back(0.75f, 0.50f, 0.00f);
-    this->vertices.emplace_back(1.00f, 0.50f, 0.00f);
-
-    this->vertices.emplace_back(0.00f, 0.75f, 0.00f);
-    this->vertices.emplace_back(0.25f, 0.75f, 0.00f);
-    this->vertices.emplace_back(0.50f, 0.75f, 0.00f);
-    this->vertices.emplace_back(0.75f, 0.75f, 0.00f);
-    this->vertices.emplace_back(1.00f, 0.75f, 0.00f);
-
-    this->vertices.emplace_back(0.00f, 1.00f, 0.0f);
-    this->vertices.emplace_back(0.25f, 1.00f, 0.0f);
-    this->vertices.emplace_back(0.50f, 1.00f, 0.0f);
-    this->vertices.emplace_back(0.75f, 1.00f, 0.0f);
-    this->vertices.emplace_back(1.00f, 1.00f, 0.0f);
+    shape.vertices.emplace_back(0.00f, 0.00f, 0.00f);
+    shape.vertices.emplace_back(0.25f, 0.00f, 0.00f);
+    shape.vertices.emplace_back(0.50f, 0.00f, 0.00f);
+    shape.vertices.emplace_back(0.75f, 0.00f, 0.00f);
+    shape.vertices.emplace_back(1.00f, 0.00f, 0.00f);
+
+    shape.vertices.emplace_back(0.00f, 0.25f, 0.00f);
+    shape.vertices.emplace_back(0.25f, 0.25f, 0.00f);
+    shape.vertices.emplace_back(0.50f, 0.25f, 0.00f);
+    shape.vertices.emplace_back(0.75f, 0.25f, 0.00f);
+    shape.vertices.emplace_back(1.00f, 0.25f, 0.00f);
+
+    shape.vertices.emplace_back(0.00f, 0.50f, 0.00f);
+    shape.vertices.emplace_back(0.25f, 0.50f, 0.00f);
+    shape.vertices.emplace_back(0.50f, 0.50f, 0.00f);
+    shape.vertices.emplace_back(0.75f, 0.50f, 0.00f);
+    shape.vertices.emplace_back(1.00f, 0.50f, 0.00f);
+
+    shape.vertices.emplace_back(0.00f, 0.75f, 0.00f);
+    shape.vertices.emplace_back(0.25f, 0.75f, 0.00f);
+    shape.vertices.emplace_back(0.50f, 0.75f, 0.00f);
+    shape.vertices.emplace_back(0.75f, 0.75f, 0.00f);
+    shape.vertices.emplace_back(1.00f, 0.75f, 0.00f);
+
+    shape.vertices.emplace_back(0.00f, 1.00f, 0.0f);
+    shape.vertices.emplace_back(0.25f, 1.00f, 0.0f);
+    shape.vertices.emplace_back(0.50f, 1.00f, 0.0f);
+    shape.vertices.emplace_back(0.75f, 1.00f, 0.0f);
+    shape.vertices.emplace_back(1.00f, 1.00f, 0.0f);
 
     //top face (5x5 between 0 - 1)
-    this->vertices.emplace_back(0.00f, 1.00f, 0.00f);
-    this->vertices.emplace_back(0.25f, 1.00f, 0.00f);
-    this->vertices.emplace_back(0.50f, 1.00f, 0.00f);
-    this->vertices.emplace_back(0.75f, 1.00f, 0.00f);
-    this->vertices.emplace_back(1.00f, 1.00f, 0.00f);
-
-    this->vertices.emplace_back(0.00f, 1.00f, -0.25f);
-    this->vertices.emplace_back(0.25f, 1.00f, -0.25f);
-    this->vertices.emplace_back(0.50f, 1.00f, -0.25f);
-    this->vertices.emplace_back(0.75f, 1.00f, -0.25f);
-    this->vertices.emplace_back(1.00f, 1.00f, -0.25f);
-
-    this->vertices.emplace_back(0.00f, 1.00f, -0.50f);
-    this->vertices.emplace_back(0.25f, 1.00f, -0.50f);
-    this->vertices.emplace_back(0.50f, 1.00f, -0.50f);
-    this->vertices.emplace_back(0.75f, 1.00f, -0.50f);
-    this->vertices.emplace_back(1.00f, 1.00f, -0.50f);
-
-    this->vertices.emplace_back(0.00f, 1.00f, -0.75f);
-    this->vertices.emplace_back(0.25f, 1.00f, -0.75f);
-    this->vertices.emplace_back(0.50f, 1.00f, -0.75f);
-    this->vertices.emplace_back(0.75f, 1.00f, -0.75f);
-    this->vertices.emplace_back(1.00f, 1.00f, -0.75f);
-
-    this->vertices.emplace_back(0.00f, 1.00f, -1.0f);
-    this->vertices.emplace_back(0.25f, 1.00f, -1.0f);
-    this->vertices.emplace_back(0.50f, 1.00f, -1.0f);
-    this->vertices.emplace_back(0.75f, 1.00f, -1.0f);
-    this->vertices.emplace_back(1.00f, 1.00f, -1.0f);
-
-    for (int i=0; i<this->vertices.size(); i++){
-
-        //random number between 0-1 , multiplied by 25 (the space between vertices is 0.25, - 13 (to have it go around zero
-        // divided be 100 to put it back to 0.xx
-        float jitterX = ((((float) rand())/(RAND_MAX))*25 - 13)/100;
-        float jitterY = ((((float) rand())/(RAND_MAX))*25 - 13)/100;
-        float jitterZ = ((((float) rand())/(RAND_MAX))*25 - 13)/100;
-
-        this->vertices[i] = this->vertices[i] + glm::vec3(jitterX, jitterY, jitterZ);
-
-    }
+    shape.vertices.emplace_back(0.00f, 1.00f, 0.00f);
+    shape.vertices.emplace_back(0.25f, 1.00f, 0.00f);
+    shape.vertices.emplace_back(0.50f, 1.00f, 0.00f);
+    shape.vertices.emplace_back(0.75f, 1.00f, 0.00f);
+    shape.vertices.emplace_back(1.00f, 1.00f, 0.00f);
+
+    shape.vertices.emplace_back(0.00f, 1.00f, -0.25f);
+    shape.vertices.emplace_back(0.25f, 1.00f, -0.25f);
+    shape.vertices.emplace_back(0.50f, 1.00f, -0.25f);
+    shape.vertices.emplace_back(0.75f, 1.00f, -0.25f);
+    shape.vertices.emplace_back(1.00f, 1.00f, -0.25f);
+
+    shape.vertices.emplace_back(0.00f, 1.00f, -0.50f);
+    shape.vertices.emplace_back(0.25f, 1.00f, -0.50f);
+    shape.vertices.emplace_back(0.50f, 1.00f, -0.50f);
+    shape.vertices.emplace_back(0.75f, 1.00f, -0.50f);
+    shape.vertices.emplace_back(1.00f, 1.00f, -0.50f);
+
+    shape.vertices.emplace_back(0.00f, 1.00f, -0.75f);
+    shape.vertices.emplace_back(0.25f, 1.00f, -0.75f);
+    shape.vertices.emplace_back(0.50f, 1.00f, -0.75f);
+    shape.vertices.emplace_back(0.75f, 1.00f, -0.75f);
+    shape.vertices.emplace_back(1.00f, 1.00f, -0.75f);
+
+    shape.vertices.emplace_back(0.00f, 1.00f, -1.0f);
+    shape.vertices.emplace_back(0.25f, 1.00f, -1.0f);
+    shape.vertices.emplace_back(0.50f, 1.00f, -1.0f);
+    shape.vertices.emplace_back(0.75f, 1.00f, -1.0f);
+    shape.vertices.emplace_back(1.00f, 1.00f, -1.0f);
 
     // calculate normals
     //------------------
 
     //step 0: fill normals with a unit normal so the vector is the right size and hidden vertices will still have a default normal.
 
-    for(int i=0; i<this->vertices.size(); i++){
-        this->normals.emplace_back(1.0f,1.0f,1.0f);
-    }
-
-    //step 1: find the surface normal for each triangle in the element buffer
-
-    std::vector<glm::vec3>surfaceNormals;
-
-    for(int i=3; i<elements.size()+1; i++){
-        if(i%3 == 0){// then element at i-1 is the third vertex of the triangle
-            // vertex A is at i-3, vertex B is i-2, vertex C is i-1
-            glm::vec3 line_seg_BA = this->vertices[elements[i-2]] - this->vertices[elements[i-3]];
-            glm::vec3 line_seg_BC = this->vertices[elements[i-2]] - this->vertices[elements[i-1]];
-            //  this is right or this cube, but if the normals look inverted in another application, just switch the order of the cross product operation: cross(line_seg_BA, line_seg_BC)
-            glm::vec3 normal = glm::cross(line_seg_BC, line_seg_BA);
-            surfaceNormals.emplace_back(normal);
-        }
-    }
-
-    //step 2: find the average of the surface normals of the surfaces this vertex is part of
+    std::vector<glm::vec3> normals(shape.vertices.size(), glm::vec3(1.0f, 1.0f, 1.0f));
 
-    std::vector<glm::vec3>connectedSurfaces;
+    //step 1: every vertex a triangle uses gets the average of the surface normals around it, the vertex
+    //shader turns them with the jitter
 
-    for(int i=0; i<this->vertices.size(); i++){
-        // vector that will hold all normals of all the surfaces this vertex is part of
-        connectedSurfaces.clear();
-        for(int j=0; j<elements.size(); j++){
-            if(i==elements[j]){//the vertice is being drawn
-                //j/3 gives us the location of this surface normal
-                connectedSurfaces.emplace_back(surfaceNormals[j/3]);
-            }
-        }
+    MeshNormals::compute(shape.vertices, elements, &normals);
 
-        if(!connectedSurfaces.empty()){
-            glm::vec3 sum = glm::vec3(0.0f);
-            for(int k=0; k<connectedSurfaces.size(); k++){
-                sum += connectedSurfaces[k];
-            }
-            //average the normal for this vertex and update the normals buffer
-            this->normals[i] = glm::normalize(
-                    glm::vec3(sum.x/connectedSurfaces.size(),
-                              sum.y/connectedSurfaces.size(),
-                              sum.z/connectedSurfaces.size()
-                    )
-            );
+    // hit boxes can't see the jitter, so the bounds take every vertex as far as it could go
+    std::vector<glm::vec3> reach;
+    for (const glm::vec3& vertex : shape.vertices) {
+        for (int corner = 0; corner < 8; corner++) {
+            reach.push_back(vertex + glm::vec3(corner & 1 ? max_jitter : min_jitter,
+                                               corner & 2 ? max_jitter : min_jitter,
+                                               corner & 4 ? max_jitter : min_jitter));
         }
     }
+    shape.bounds = MeshBounds(reach);
 
-    this->vao = DrawableEntity::initVertexArray(
-            this->vertices,
+    shape.vao = this->initVertexArray(
+            shape.vertices,
             elements,
-            this->normals,
+            normals,
             uvs,
-            &this->vertices_buffer,
-            &this->element_buffer,
-            &this->normal_buffer,
-            &this->uv_buffer
+            &shape.vertices_buffer,
+            &shape.element_buffer,
+            &shape.normal_buffer,
+            &shape.uv_buffer
     );
 }
 
 Rock::~Rock()
 {
-    glDeleteBuffers(1, &this->vertices_buffer);
-    glDeleteBuffers(1, &this->element_buffer);
-    glDeleteBuffers(1, &this->uv_buffer);
-    glDeleteBuffers(1, &this->uv_buffer);
-    glDeleteVertexArrays(1, &this->vao);
+}
+
+void Rock::shutdown()
+{
+    glDeleteBuffers(1, &shape.vertices_buffer);
+    glDeleteBuffers(1, &shape.element_buffer);
+    glDeleteBuffers(1, &shape.normal_buffer);
+    glDeleteBuffers(1, &shape.uv_buffer);
+    glDeleteVertexArrays(1, &shape.vao);
+    shape = Shape();
 }
 
 const std::vector<glm::vec3>& Rock::getVertices() const
 {
-    return this->vertices;
+    return shape.vertices;
+}
+
+const MeshBounds* Rock::getMeshBounds() const
+{
+    return &shape.bounds;
 }
 
 GLuint Rock::getVAO()
 {
-    return this->vao;
+    return shape.vao;
 }
 
 const int Rock::getColorType()
@@ -546,12 +526,22 @@ const int Rock::getColorType()
     return COLOR_LIGHTING;
 }
 
+int Rock::getDisplacementType()
+{
+    return DISPLACE_JITTER;
+}
+
+GLuint Rock::getDisplacementSeed()
+{
+    return this->seed;
+}
+
 GLuint Rock::getTextureId()
 {
-	static GLuint rock_texture = loadTexture(
+	static TextureHandle rock_texture = TextureManager::get(
 			"../textures/stoneC.jpg",
 			GL_NEAREST,
 			GL_NEAREST
 	);
-	return rock_texture;
+	return rock_texture->getId();
 }
@@ -13,16 +13,32 @@
 
 #include "Entity.hpp"
 #include "DrawableEntity.hpp"
+#include "../MeshBounds.hpp"
+
+// Every rock draws the same 5x5 sided box, the first one builds it. The vertex shader jitters each
+// vertex by the rock's seed (DISPLACE_JITTER), the way rand() used to on the cpu.
 
 class Rock : public DrawableEntity {
 private:
-	std::vector<glm::vec3> vertices;
-	std::vector<glm::vec3> normals;
-	GLuint vao;
-    GLuint vertices_buffer;
-    GLuint element_buffer;
-	GLuint normal_buffer;
-    GLuint uv_buffer;
+	// how far the shader moves a vertex along each axis
+	static constexpr float min_jitter = -0.13f;
+	static constexpr float max_jitter = 0.12f;
+
+	struct Shape {
+		std::vector<glm::vec3> vertices;
+		MeshBounds bounds;
+		GLuint vao = 0;
+		GLuint vertices_buffer = 0;
+		GLuint element_buffer = 0;
+		GLuint normal_buffer = 0;
+		GLuint uv_buffer = 0;
+	};
+	static Shape shape;
+
+	GLuint seed;
+
+	// needs the gl context
+	void buildShape();
 public:
 	Rock(
 		const GLuint& shader_program,
@@ -47,10 +63,15 @@ public:
 		Entity* parent
 	);
     ~Rock() override;
+	// frees the shared box, call before the gl context goes
+	static void shutdown();
 	const std::vector<glm::vec3>& getVertices() const override;
+	const MeshBounds* getMeshBounds() const override;
 	GLuint getVAO() override;
 	const int getColorType() override;
     GLuint getTextureId() override;
+	int getDisplacementType() override;
+	GLuint getDisplacementSeed() override;
 };
 
 
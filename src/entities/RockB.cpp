@@ -11,15 +11,19 @@
 #include <vector>
 #include <stdexcept>
 #include <algorithm>
+#include <random>
 
 #include "Entity.hpp"
 #include "DrawableEntity.hpp"
 #include "RockB.hpp"
 
 #include "../constants.hpp"
-#include "../loadTexture.hpp"
+#include "../TextureManager.hpp"
 #include "../utils.hpp"
+#include "../MeshNormals.hpp"
 
+constexpr int RockB::variant_count;
+std::vector<RockB::Variant> RockB::variants;
 
 RockB::RockB(
         const GLuint &shader_program,
@@ -57,32 +61,65 @@ RockB::RockB(
             shininess
     );
 
-    //generate a sphere
-    //this could be useful to change with  +/-  rand() % 5
-    int num_arc_points = rand()%5 + 7;
-    int num_longitude_lines = rand()%10 + 5;
-
-    generateSphere(&this->vertices, &this->elements, &this->normals, &this->uvs, (num_arc_points-1), num_longitude_lines);
-
-    this->vao = DrawableEntity::initVertexArray(
-            this->vertices,
-            this->elements,
-            this->normals,
-            this->uvs,
-            &this->vertices_buffer,
-            &this->element_buffer,
-            &this->normal_buffer,
-            &this->uv_buffer
-    );
+    this->seed = utils::hashLocation(world_x_location, world_z_location);
+    this->variant = &getVariant();
 }
 
 RockB::~RockB()
 {
-    glDeleteBuffers(1, &this->vertices_buffer);
-    glDeleteBuffers(1, &this->element_buffer);
-    glDeleteBuffers(1, &this->normal_buffer);
-    glDeleteBuffers(1, &this->uv_buffer);
-    glDeleteVertexArrays(1, &this->vao);
+}
+
+const RockB::Variant& RockB::getVariant()
+{
+    if (variants.empty()) {
+        variants.resize(variant_count);
+        for (int i = 0; i < variant_count; i++) {
+            Variant& variant = variants[i];
+            std::minstd_rand random((unsigned int)i + 1);
+
+            //generate a sphere, with the arc and longitude counts rand() used to give
+            int num_arc_points = (int)(random() % 5) + 7;
+            int num_longitude_lines = (int)(random() % 10) + 5;
+
+            std::vector<GLuint> elements;
+            std::vector<glm::vec3> normals;
+            std::vector<glm::vec2> uvs;
+            generateSphere(&variant.vertices, &elements, &normals, &uvs, (num_arc_points-1), num_longitude_lines);
+
+            // hit boxes can't see the shader's scale, so the bounds take every vertex at its
+            // smallest and its largest
+            std::vector<glm::vec3> reach;
+            for (const glm::vec3& vertex : variant.vertices) {
+                reach.push_back(vertex * 0.5f);
+                reach.push_back(vertex * (vertex.x >= 0 ? 0.7f : std::max(0.5f, -vertex.x)));
+            }
+            variant.bounds = MeshBounds(reach);
+
+            variant.vao = this->initVertexArray(
+                    variant.vertices,
+                    elements,
+                    normals,
+                    uvs,
+                    &variant.vertices_buffer,
+                    &variant.element_buffer,
+                    &variant.normal_buffer,
+                    &variant.uv_buffer
+            );
+        }
+    }
+    return variants[this->seed % variant_count];
+}
+
+void RockB::shutdown()
+{
+    for (Variant& variant : variants) {
+        glDeleteBuffers(1, &variant.vertices_buffer);
+        glDeleteBuffers(1, &variant.element_buffer);
+        glDeleteBuffers(1, &variant.normal_buffer);
+        glDeleteBuffers(1, &variant.uv_buffer);
+        glDeleteVertexArrays(1, &variant.vao);
+    }
+    variants.clear();
 }
 
 void RockB::generateSphere(
@@ -109,24 +146,6 @@ void RockB::generateSphere(
     }
 
 
-    for(int i=0; i<vertices->size(); i++){
-        float scale = float((*vertices)[i].x * ((((float)rand())/(RAND_MAX))));
-        if(scale<0.5 && scale>-0.5){
-            scale = 0.5f;
-        }
-        if(scale>0.7){
-            scale=0.7;
-        }
-        if(scale<0){
-            scale = std::abs(scale);
-        }
-
-        (*vertices)[i].x = (*vertices)[i].x * scale;
-        (*vertices)[i].y = (*vertices)[i].y * scale;
-        (*vertices)[i].z = (*vertices)[i].z * scale;
-
-    }
-
     //generate ebo
     for(int l=0; l<(num_longitude_lines-1); l++) {
         int arc_offset = l*(num_arc_segments+1);
@@ -189,63 +208,26 @@ void RockB::generateSphere(
         normals->emplace_back((*vertices)[i] - glm::vec3(0.0f));
     }
 
-        // calculate normals
-        //------------------
-
-        //step 1: find the surface normal for each triangle in the element buffer
-
-        std::vector<glm::vec3>surfaceNormals;
-
-        for(int i=1; i<ebo->size()+1; i++){
-            if(i%3 == 0){// then element at i-1 is the third vertex of the triangle
-
-                //std::cout<<"element at "<<i<<" :"<<elements[i-1]<<std::endl;
-                // vertex A is at i-3, vertex B is i-2, vertex C is i-1
-                glm::vec3 line_seg_BA = (*vertices)[(*ebo)[i-2]] - (*vertices)[(*ebo)[i-3]];
-                glm::vec3 line_seg_BC = (*vertices)[(*ebo)[i-2]] - (*vertices)[(*ebo)[i-1]];
-                //  this is right or this cube, but if the normals look inverted in another application, just switch the order of the cross product operation: cross(line_seg_BA, line_seg_BC)
-                glm::vec3 normal = glm::cross(line_seg_BC, line_seg_BA);
-                surfaceNormals.emplace_back(normal);
-            }
-        }
-
-        //step 2: find the average of the surface normals of the surfaces this vertex is part of
-
-        std::vector<glm::vec3>connectedSurfaces;
-
-        for(int i=0; i<vertices->size(); i++){
-            // vector that will hold all normals of all the surfaces this vertex is part of
-            connectedSurfaces.clear();
-            for(int j=0; j<ebo->size(); j++){
-                if(i==(*ebo)[j]){//the vertice is being drawn
-                    //j/3 gives us the location of this surface normal
-                    connectedSurfaces.emplace_back(surfaceNormals[j/3]);
-                }
-            }
-
-            if(!connectedSurfaces.empty()){
-                glm::vec3 sum = glm::vec3(0.0f);
-                for(int k=0; k<connectedSurfaces.size(); k++){
-                    sum += connectedSurfaces[k];
-                }
-                //average the normal for this vertex and update the normals buffer
-                (*normals)[i] = glm::normalize(glm::vec3(sum.x/connectedSurfaces.size(), sum.y/connectedSurfaces.size(), sum.z/connectedSurfaces.size()));
-            }
-        }
-
-
+    // calculate normals, the ones set above stay for vertices no triangle uses
+    //------------------
 
+    MeshNormals::compute(*vertices, *ebo, normals);
 }
 
 
 const std::vector<glm::vec3>& RockB::getVertices() const
 {
-    return this->vertices;
+    return this->variant->vertices;
+}
+
+const MeshBounds* RockB::getMeshBounds() const
+{
+    return &this->variant->bounds;
 }
 
 GLuint RockB::getVAO()
 {
-    return this->vao;
+    return this->variant->vao;
 }
 
 const int RockB::getColorType()
@@ -253,12 +235,22 @@ const int RockB::getColorType()
     return COLOR_LIGHTING;
 }
 
+int RockB::getDisplacementType()
+{
+    return DISPLACE_RADIAL;
+}
+
+GLuint RockB::getDisplacementSeed()
+{
+    return this->seed;
+}
+
 GLuint RockB::getTextureId()
 {
-    static GLuint rock_texture = loadTexture(
+    static TextureHandle rock_texture = TextureManager::get(
             "../textures/stoneC.jpg",
             GL_LINEAR,
             GL_LINEAR
     );
-    return rock_texture;
+    return rock_texture->getId();
 }
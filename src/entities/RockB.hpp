@@ -13,18 +13,34 @@
 
 #include "Entity.hpp"
 #include "DrawableEntity.hpp"
+#include "../MeshBounds.hpp"
+
+// Rocks share their spheres: a pool of variant_count unit spheres is made (and uploaded) the first time a
+// rock is, and each rock picks one by hashing where it stands. The vertex shader scales the sphere's
+// vertices by that hash (DISPLACE_RADIAL), the way rand() used to on the cpu. Only the seed, transform
+// and material are the rock's own.
 
 class RockB : public DrawableEntity {
+public:
+    static constexpr int variant_count = 16;
+
 private:
-    std::vector<glm::vec3> vertices;
-    std::vector<GLuint> elements;
-    std::vector<glm::vec3> normals;
-    std::vector<glm::vec2>uvs;
-    GLuint vao;
-    GLuint vertices_buffer;
-    GLuint element_buffer;
-    GLuint uv_buffer;
-    GLuint normal_buffer;
+    struct Variant {
+        std::vector<glm::vec3> vertices;
+        MeshBounds bounds;
+        GLuint vao = 0;
+        GLuint vertices_buffer = 0;
+        GLuint element_buffer = 0;
+        GLuint uv_buffer = 0;
+        GLuint normal_buffer = 0;
+    };
+    static std::vector<Variant> variants;
+
+    GLuint seed;
+    const Variant* variant;
+
+    // builds the pool through this rock the first time, needs the gl context
+    const Variant& getVariant();
 public:
     RockB(
             const GLuint& shader_program,
@@ -49,17 +65,22 @@ public:
             Entity* parent
     );
     ~RockB() override;
-    void generateSphere(
+    static void generateSphere(
             std::vector<glm::vec3>* vertices,
             std::vector<GLuint>* ebo,
             std::vector<glm::vec3>* normals,
             std::vector<glm::vec2>* uvs,
             const int num_arc_segments,
             const int num_longitude_lines);
+    // frees the pool's buffers, call before the gl context goes
+    static void shutdown();
     const std::vector<glm::vec3>& getVertices() const override;
+    const MeshBounds* getMeshBounds() const override;
     GLuint getVAO() override;
     const int getColorType() override;
     GLuint getTextureId() override;
+    int getDisplacementType() override;
+    GLuint getDisplacementSeed() override;
 };
 
 
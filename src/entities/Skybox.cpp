@@ -17,7 +17,7 @@
 #include "Skybox.hpp"
 #include "../utils.hpp"
 #include "../constants.hpp"
-#include "../loadTexture.hpp"
+#include "../TextureManager.hpp"
 #include "../objloader.hpp"
 
 
@@ -195,10 +195,10 @@ const int Skybox::getColorType() {
 GLuint Skybox::getTextureId()
 {
     //from pinterest
-    static GLuint cloud_texture = loadTexture(
+    static TextureHandle cloud_texture = TextureManager::get(
             "../textures/nightskydome1.jpg",
             GL_LINEAR,
             GL_LINEAR
     );
-    return cloud_texture;
+    return cloud_texture->getId();
 }
\ No newline at end of file
@@ -9,8 +9,8 @@ CREATES TRUNK AND LEAF VECTORS+INDICES WHICH ARE MERGED TOGETHER ARE SENT TO THE
 
 CURRENT LOADING SPEED SUGESTS THE 4-8 DIAMETER RANGE WILL GENERATE QUICKLY. SCALING TO HEIGHTS MAY BE NESCICARY.
 
-PROGRAM ENTRY POINT IN IN THE generateTreeA FUNCTION WHEREIN IT STARTS TO BUILD THE STARTER TRUNK, 
-THEN ENTERS BINARY RECURSIONS OF ITSELF TO GENERATE THE TRUNKS AND LEAVES WHEREUPON REACHING THE BASE CASE IN MOVES SEGMENTS OF
+PROGRAM ENTRY POINT IN IN THE generate FUNCTION (Trees/BranchingTree.hpp) WHEREIN IT STARTS TO BUILD THE STARTER TRUNK, 
+THEN QUEUES A TASK FOR EACH SHOOT ON THE TREE'S GROWTH STACK (A BINARY RECURSION RUN AS A LOOP, SEE Tree::grow) TO GENERATE THE TRUNKS AND LEAVES WHEREUPON REACHING THE BASE CASE IN MOVES SEGMENTS OF
 ONE RECURSION ONTO THE STARTER TRUNK AND PROCEEDS TO DO THE NEXT BRANCH. RECURSIONS SET PARAMETERS OF ANGLES AND SEGMENT WIDTHS
 DECREASING AT A PYTHAGOREAN RATE.
 
@@ -37,12 +37,6 @@ ANGLES COMPUTED DURING RECURSIONS
 #ifndef COMP371_TREnt_A_HPP
 #define COMP371_TREnt_A_HPP
 
-#define START_TRUNK 0
-#define TRUNK 2
-#define LEAF 3
-#define END_TRUNK -1
-
-
 #ifdef __APPLE__
 #include <OpenGL/OpenGL.h>
 #include <OpenGL/OpenGL.h>
@@ -60,50 +54,21 @@ ANGLES COMPUTED DURING RECURSIONS
 #include <ctime>
 
 #include "src/TreeRandom.hpp"
-#include "Trees/TrunkAB.hpp"
-#include "Trees/LeafContainerAB.hpp"
 
 #include "src/entities/Entity.hpp"
 #include "src/entities/DrawableEntity.hpp"
-#include "Trees/Tree.hpp"
+#include "Trees/BranchingTree.hpp"
 
-class Tentacle : public Tree {
+class Tentacle : public BranchingTree<TentacleParams> {
 private:
 	bool treeLoaded = false;
 	bool treeInit = false;
 	bool isAlien, isTextured;
 
-    static constexpr int branches = 1;
-    static constexpr int k = 250;
-	float limiter = 1;
-	static constexpr int previousRotationCap = 8;
-
-    static constexpr float boostFactor = 0.25;//0.5;
-    static constexpr int heightChunking = 20;//INVERSE
-
-    static constexpr int minYBranchAngle = 30;
-	static constexpr int maxYBranchAngle = 45;
-	static constexpr int minYTrunkAngle = 0;
-	static constexpr int maxYTrunkAngle = 20;
-
-	static constexpr double trunkRatio = 1.0;
-	static constexpr double branchRatio = 0.850;
-
-	float trunk(float trunkDiameter, const float& seed, float lineHeight);
-	void leafBranch(float trunkDiameter, const float& seed, float lineHeight);
-
-	void initiateMove(AttatchmentGroupings* ag);
-
-	void moveSegments(const int& previousRotation, AttatchmentGroupings* ag);
-
-	void treeSetup(const GLuint& shader_program, float trunkDiameter, const int&);
-
-	void generateTentacle(const int& _case, float trunkDiameter, const float& seed,
-					   float angleX, float angleY, float angleZ,
-					   char tag, AttatchmentGroupings* ag, float lineHeight);
+	void treeSetup(const GLuint& shader_program, float trunkDiameter, const int&, TreeBuildBatch* batch);
 
 	//PUT TEXTURE LOADING IN SEPERATE CLASS. MAKE IT ONLY CALLED ONCE FOR THE FIRST TREE LOADED.
-	void bufferObject(const GLuint& shader_program);
+	void bufferObject(const GLuint& shader_program) override;
 
 protected:
 
@@ -115,7 +80,8 @@ public:
 	void setTreeLoaded(bool state);
 	void setTreeInit(bool state);
 
-	Tentacle(const GLuint& shader_program, Entity* entity, float trunkDiameter, const int& seed, bool isAlien, bool isTextured);
+	Tentacle(const GLuint& shader_program, Entity* entity, float trunkDiameter, const int& seed, bool isAlien, bool isTextured,
+	         TreeBuildBatch* batch = nullptr);
 
 	GLuint getTextureId();
 	const int getColorType();
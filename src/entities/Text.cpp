@@ -9,14 +9,135 @@
 #include <glm/gtc/matrix_transform.hpp>
 #include "glm/gtx/rotate_vector.hpp"
 #include <vector>
+#include <cctype>
 
 #include "Entity.hpp"
 #include "DrawableEntity.hpp"
 #include "Text.hpp"
+#include "TextRenderer.hpp"
 
 #include "../constants.hpp"
-#include "../loadTexture.hpp"
-#include <iostream>
+
+// Where a glyph sits in its font map and how much empty space its cell has on
+// either side. Spaces are fractions of the character width, uvs are in twelfths
+// of the map. Letters cover both cases.
+struct GlyphMetrics {
+    char glyph;
+    float l_space;
+    float r_space;
+    float u_min;
+    float v_min;
+    float u_max;
+    float v_max;
+};
+
+// the fonts are laid out in a 6x6 grid, punctuation and some digits use half cells
+static const GlyphMetrics OUTLINE_GLYPHS[] = {
+		{'a', 0.32f, 0.32f, 0, 10, 2, 12},
+		{'b', 0.32f, 0.32f, 2, 10, 4, 12},
+		{'c', 0.32f, 0.32f, 4, 10, 6, 12},
+		{'d', 0.32f, 0.32f, 6, 10, 8, 12},
+		{'e', 0.32f, 0.32f, 8, 10, 10, 12},
+		{'f', 0.32f, 0.32f, 10, 10, 12, 12},
+		{'g', 0.2f, 0.36f, 0, 8, 2, 10},
+		{'h', 0.32f, 0.32f, 2, 8, 4, 10},
+		{'i', 0.32f, 0.32f, 4, 8, 6, 10},
+		{'j', 0.32f, 0.32f, 6, 8, 8, 10},
+		{'k', 0.32f, 0.32f, 8, 8, 10, 10},
+		{'l', 0.32f, 0.32f, 10, 8, 12, 10},
+		{'m', 0.2f, 0.2f, 0, 6, 2, 8},
+		{'n', 0.28f, 0.24f, 2, 6, 4, 8},
+		{'o', 0.28f, 0.2f, 4, 6, 6, 8},
+		{'p', 0.32f, 0.32f, 6, 6, 8, 8},
+		{'q', 0.32f, 0.32f, 8, 6, 10, 8},
+		{'r', 0.32f, 0.28f, 10, 6, 12, 8},
+		{'s', 0.32f, 0.32f, 0, 4, 2, 6},
+		{'t', 0.28f, 0.24f, 2, 4, 4, 6},
+		{'u', 0.32f, 0.32f, 4, 4, 6, 6},
+		{'v', 0.28f, 0.24f, 6, 4, 8, 6},
+		{'w', 0.16f, 0.16f, 8, 4, 10, 6},
+		{'x', 0.32f, 0.32f, 10, 4, 12, 6},
+		{'y', 0.32f, 0.32f, 0, 2, 2, 4},
+		{'z', 0.28f, 0.28f, 2, 2, 4, 4},
+		{'1', 0.28f, 0.28f, 4, 3, 5, 4},
+		{'2', 0.28f, 0.28f, 6, 3, 7, 4},
+		{'3', 0.28f, 0.28f, 8, 2, 10, 4},
+		{'4', 0.28f, 0.28f, 10, 2, 12, 4},
+		{'5', 0.28f, 0.28f, 0, 0, 2, 2},
+		{'6', 0.28f, 0.28f, 2, 0, 4, 2},
+		{'7', 0.28f, 0.28f, 4, 0, 6, 2},
+		{'8', 0.28f, 0.28f, 6, 0, 8, 2},
+		{'9', 0.28f, 0.28f, 8, 0, 10, 2},
+		{'0', 0.28f, 0.28f, 10, 0, 12, 2},
+		{'-', 0.28f, 0.28f, 6, 2, 7, 3},
+		{' ', 0.0f, 0.5f, 0, 0, 0.48f, 0.48f},
+		{',', 0.0f, 0.8f, 5, 3, 6, 4},
+		{'.', 0.0f, 0.8f, 4, 2, 5, 3},
+		{':', 0.3f, 0.3f, 5, 2, 6, 3}
+};
+
+static const GlyphMetrics MYTHOS_GLYPHS[] = {
+		{'a', 0.12f, 0.2f, 0, 10, 2, 12},
+		{'b', 0.24f, 0.2f, 2, 10, 4, 12},
+		{'c', 0.2f, 0.2f, 4, 10, 6, 12},
+		{'d', 0.16f, 0.12f, 6, 10, 8, 12},
+		{'e', 0.2f, 0.2f, 8, 10, 10, 12},
+		{'f', 0.32f, 0.2f, 10, 10, 12, 12},
+		{'g', 0.12f, 0.12f, 0, 8, 2, 10},
+		{'h', 0.16f, 0.16f, 2, 8, 4, 10},
+		{'i', 0.36f, 0.28f, 4, 8, 6, 10},
+		{'j', 0.24f, 0.24f, 6, 8, 8, 10},
+		{'k', 0.24f, 0.24f, 8, 8, 10, 10},
+		{'l', 0.32f, 0.16f, 10, 8, 12, 10},
+		{'m', 0.0f, 0.0f, 0, 6, 2, 8},
+		{'n', 0.12f, 0.16f, 2, 6, 4, 8},
+		{'o', 0.16f, 0.12f, 4, 6, 6, 8},
+		{'p', 0.2f, 0.16f, 6, 6, 8, 8},
+		{'q', 0.16f, 0.12f, 8, 6, 10, 8},
+		{'r', 0.28f, 0.12f, 10, 6, 12, 8},
+		{'s', 0.2f, 0.28f, 0, 4, 2, 6},
+		{'t', 0.2f, 0.16f, 2, 4, 4, 6},
+		{'u', 0.2f, 0.16f, 4, 4, 6, 6},
+		{'v', 0.2f, 0.16f, 6, 4, 8, 6},
+		{'w', 0.0f, 0.0f, 8, 4, 10, 6},
+		{'x', 0.16f, 0.08f, 10, 4, 12, 6},
+		{'y', 0.16f, 0.24f, 0, 2, 2, 4},
+		{'z', 0.2f, 0.2f, 2, 2, 4, 4},
+		{'1', 0.2f, 0.2f, 4, 3, 5, 4},
+		{'2', 0.2f, 0.2f, 6, 2, 8, 4},
+		{'3', 0.2f, 0.2f, 8, 2, 10, 4},
+		{'4', 0.2f, 0.2f, 10, 2, 12, 4},
+		{'5', 0.2f, 0.2f, 0, 0, 2, 2},
+		{'6', 0.2f, 0.2f, 2, 0, 4, 2},
+		{'7', 0.2f, 0.2f, 4, 0, 6, 2},
+		{'8', 0.2f, 0.2f, 6, 0, 8, 2},
+		{'9', 0.2f, 0.2f, 8, 0, 10, 2},
+		{'0', 0.2f, 0.2f, 10, 0, 12, 2},
+		{' ', 0.0f, 0.5f, 0, 0, 0.48f, 0.48f},
+		{',', 0.0f, 0.8f, 5, 3, 6, 4},
+		{'.', 0.0f, 0.8f, 4, 2, 5, 3}
+};
+
+// anything missing from the font maps, a sliver of empty map with no overlap
+static const GlyphMetrics BLANK_GLYPH = {'\0', 0.0f, 0.0f, 0, 0, 0.48f, 0.48f};
+
+template<size_t N>
+static std::vector<const GlyphMetrics*> buildGlyphLookup(const GlyphMetrics (&glyphs)[N])
+{
+    std::vector<const GlyphMetrics*> lookup(256, &BLANK_GLYPH);
+    for (size_t i = 0; i < N; i++) {
+        lookup[(unsigned char)glyphs[i].glyph] = &glyphs[i];
+        lookup[(unsigned char)std::toupper(glyphs[i].glyph)] = &glyphs[i];
+    }
+    return lookup;
+}
+
+static const GlyphMetrics& getGlyphMetrics(const unsigned int& font_style, const char& c)
+{
+    static const std::vector<const GlyphMetrics*> outline = buildGlyphLookup(OUTLINE_GLYPHS);
+    static const std::vector<const GlyphMetrics*> mythos = buildGlyphLookup(MYTHOS_GLYPHS);
+    return *(font_style == FONT_STYLE_OUTLINE ? outline : mythos)[(unsigned char)c];
+}
 
 Text::Text(
         const GLuint& shader_program,
@@ -25,26 +146,21 @@ Text::Text(
         const float left_margin,
         const unsigned int FONT_STYLE,
         Entity* parent
-) : DrawableEntity(shader_program, parent) {
-
+) : DrawableEntity(shader_program, parent),
+    font_style(FONT_STYLE),
+    line_start(line_start),
+    left_margin(left_margin)
+{
     this->draw_mode = GL_TRIANGLES;
     this->should_draw_back_face = true;
 
-    if(FONT_STYLE==FONT_STYLE_OUTLINE){
-        this->font_map = loadTexture(
-                "../textures/outline_text_map.png",
-                GL_LINEAR,
-                GL_LINEAR,
-                true
-        );
-    }else{
-        this->font_map = loadTexture(
-                "../textures/mythos_text_map.png",
-                GL_LINEAR,
-                GL_LINEAR,
-                true
-        );
-    }
+    this->setMessage(message);
+}
+
+void Text::setMessage(const std::string& message)
+{
+    this->vertices.clear();
+    this->uvs.clear();
 
     // 0.01 scale for at least 100 chars per line
     float char_width = 0.01;
@@ -55,10 +171,6 @@ Text::Text(
         line_height = 0;
     }else line_height = line_start * char_height;
 
-    //the amount we can overlap on either side
-    float char_r_space;
-    float char_l_space;
-
     float l_margin = left_margin;
 
     if(l_margin<char_width){
@@ -70,766 +182,32 @@ Text::Text(
 
     float cursor;
 
-    for(int i=0, j=0; i<message.length(); i++, j+=4){
+    for(int i=0; i<message.length(); i++){
 
-        cursor = line_width_sum;
-
-        this->elements.emplace_back(j+2);
-        this->elements.emplace_back(j);
-        this->elements.emplace_back(j+1);
-        this->elements.emplace_back(j+2);
-        this->elements.emplace_back(j+1);
-        this->elements.emplace_back(j+3);
-
-        //we are not using these but want to keep a consistentency with drawable methods, and they could be used to light text
-        this->normals.emplace_back(0.0f, 0.0f, 1.0f);
-        this->normals.emplace_back(0.0f, 0.0f, 1.0f);
-        this->normals.emplace_back(0.0f, 0.0f, 1.0f);
-        this->normals.emplace_back(0.0f, 0.0f, 1.0f);
-
-        //char_l_space, char_r_space and uv coordinates are relative to mythos_text_map
-        if(FONT_STYLE==FONT_STYLE_OUTLINE){
-
-            switch(message[i]){
-                case 'a':
-                case 'A':
-                    char_l_space = (float)(char_width*0.32);
-                    char_r_space = (float)(char_width*0.32);
-                    this->uvs.emplace_back(0, 0.833333);
-                    this->uvs.emplace_back(0.166666, 0.833333);
-                    this->uvs.emplace_back(0, 1);
-                    this->uvs.emplace_back(0.166666, 1);
-                    break;
-                case 'b':
-                case 'B':
-                    char_l_space = (float)(char_width*0.32);
-                    char_r_space = (float)(char_width*0.32);
-                    this->uvs.emplace_back(0.166666, 0.833333);
-                    this->uvs.emplace_back(0.333333, 0.833333);
-                    this->uvs.emplace_back(0.166666, 1);
-                    this->uvs.emplace_back(0.333333, 1);
-                    break;
-                case 'c':
-                case 'C':
-                    char_l_space = (float)(char_width*0.32);
-                    char_r_space = (float)(char_width*0.32);
-                    this->uvs.emplace_back(0.333333, 0.833333);
-                    this->uvs.emplace_back(0.5, 0.833333);
-                    this->uvs.emplace_back(0.333333, 1);
-                    this->uvs.emplace_back(0.5, 1);
-                    break;
-                case 'd':
-                case 'D':
-                    char_l_space = (float)(char_width*0.32);
-                    char_r_space = (float)(char_width*0.32);
-                    this->uvs.emplace_back(0.5, 0.833333);
-                    this->uvs.emplace_back(0.666666, 0.833333);
-                    this->uvs.emplace_back(0.5, 1);
-                    this->uvs.emplace_back(0.666666, 1);
-                    break;
-                case 'e':
-                case 'E':
-                    char_l_space = (float)(char_width*0.32);
-                    char_r_space = (float)(char_width*0.32);
-                    this->uvs.emplace_back(0.666666, 0.833333);
-                    this->uvs.emplace_back(0.833333, 0.833333);
-                    this->uvs.emplace_back(0.666666, 1);
-                    this->uvs.emplace_back(0.833333, 1);
-                    break;
-                case 'f':
-                case 'F':
-                    char_l_space = (float)(char_width*0.32);
-                    char_r_space = (float)(char_width*0.32);
-                    this->uvs.emplace_back(0.833333, 0.833333);
-                    this->uvs.emplace_back(1, 0.833333);
-                    this->uvs.emplace_back(0.833333, 1);
-                    this->uvs.emplace_back(1, 1);
-                    break;
-                case 'g':
-                case 'G':
-                    char_l_space = (float)(char_width*0.2);
-                    char_r_space = (float)(char_width*0.36);
-                    this->uvs.emplace_back(0, 0.666666);
-                    this->uvs.emplace_back(0.166666, 0.666666);
-                    this->uvs.emplace_back(0, 0.833333);
-                    this->uvs.emplace_back(0.166666, 0.833333);
-                    break;
-                case 'h':
-                case 'H':
-                    char_l_space = (float)(char_width*0.32);
-                    char_r_space = (float)(char_width*0.32);
-                    this->uvs.emplace_back(0.166666, 0.666666);
-                    this->uvs.emplace_back(0.333333, 0.666666);
-                    this->uvs.emplace_back(0.166666, 0.833333);
-                    this->uvs.emplace_back(0.333333, 0.833333);
-                    break;
-                case 'i':
-                case 'I':
-                    char_l_space = (float)(char_width*0.32);
-                    char_r_space = (float)(char_width*0.32);
-                    this->uvs.emplace_back(0.333333, 0.666666);
-                    this->uvs.emplace_back(0.5, 0.666666);
-                    this->uvs.emplace_back(0.333333, 0.833333);
-                    this->uvs.emplace_back(0.5, 0.833333);
-                    break;
-                case 'j':
-                case 'J':
-                    char_l_space = (float)(char_width*0.32);
-                    char_r_space = (float)(char_width*0.32);
-                    this->uvs.emplace_back(0.5, 0.666666);
-                    this->uvs.emplace_back(0.666666, 0.666666);
-                    this->uvs.emplace_back(0.5, 0.833333);
-                    this->uvs.emplace_back(0.666666, 0.833333);
-                    break;
-                case 'k':
-                case 'K':
-                    char_l_space = (float)(char_width*0.32);
-                    char_r_space = (float)(char_width*0.32);
-                    this->uvs.emplace_back(0.666666, 0.666666);
-                    this->uvs.emplace_back(0.833333, 0.666666);
-                    this->uvs.emplace_back(0.666666, 0.833333);
-                    this->uvs.emplace_back(0.833333, 0.833333);
-                    break;
-                case 'l':
-                case 'L':
-                    char_l_space = (float)(char_width*0.32);
-                    char_r_space = (float)(char_width*0.32);
-                    this->uvs.emplace_back(0.833333, 0.666666);
-                    this->uvs.emplace_back(1, 0.666666);
-                    this->uvs.emplace_back(0.833333, 0.833333);
-                    this->uvs.emplace_back(1, 0.833333);
-                    break;
-                case 'm':
-                case 'M':
-                    char_l_space = (float)(char_width*0.2);
-                    char_r_space = (float)(char_width*0.2);
-                    this->uvs.emplace_back(0, 0.5);
-                    this->uvs.emplace_back(0.166666, 0.5);
-                    this->uvs.emplace_back(0, 0.666666);
-                    this->uvs.emplace_back(0.166666, 0.666666);
-                    break;
-                case 'n':
-                case 'N':
-                    char_l_space = (float)(char_width*0.28);
-                    char_r_space = (float)(char_width*0.24);
-                    this->uvs.emplace_back(0.166666, 0.5);
-                    this->uvs.emplace_back(0.333333, 0.5);
-                    this->uvs.emplace_back(0.166666, 0.666666);
-                    this->uvs.emplace_back(0.333333, 0.666666);
-                    break;
-                case 'o':
-                case 'O':
-                    char_l_space = (float)(char_width*0.28);
-                    char_r_space = (float)(char_width*0.2);
-                    this->uvs.emplace_back(0.333333, 0.5);
-                    this->uvs.emplace_back(0.5, 0.5);
-                    this->uvs.emplace_back(0.333333, 0.666666);
-                    this->uvs.emplace_back(0.5, 0.666666);
-                    break;
-                case 'p':
-                case 'P':
-                    char_l_space = (float)(char_width*0.32);
-                    char_r_space = (float)(char_width*0.32);
-                    this->uvs.emplace_back(0.5, 0.5);
-                    this->uvs.emplace_back(0.666666, 0.5);
-                    this->uvs.emplace_back(0.5, 0.666666);
-                    this->uvs.emplace_back(0.666666, 0.666666);
-                    break;
-                case 'q':
-                case 'Q':
-                    char_l_space = (float)(char_width*0.32);
-                    char_r_space = (float)(char_width*0.32);
-                    this->uvs.emplace_back(0.666666, 0.5);
-                    this->uvs.emplace_back(0.833333, 0.5);
-                    this->uvs.emplace_back(0.666666, 0.666666);
-                    this->uvs.emplace_back(0.833333, 0.666666);
-                    break;
-                case 'r':
-                case 'R':
-                    char_l_space = (float)(char_width*0.32);
-                    char_r_space = (float)(char_width*0.28);
-                    this->uvs.emplace_back(0.833333, 0.5);
-                    this->uvs.emplace_back(1.0, 0.5);
-                    this->uvs.emplace_back(0.833333, 0.666666);
-                    this->uvs.emplace_back(1.0, 0.666666);
-                    break;
-                case 's':
-                case 'S':
-                    char_l_space = (float)(char_width*0.32);
-                    char_r_space = (float)(char_width*0.32);
-                    this->uvs.emplace_back(0, 0.333333);
-                    this->uvs.emplace_back(0.166666, 0.333333);
-                    this->uvs.emplace_back(0, 0.5);
-                    this->uvs.emplace_back(0.166666, 0.5);
-                    break;
-                case 't':
-                case 'T':
-                    char_l_space = (float)(char_width*0.28);
-                    char_r_space = (float)(char_width*0.24);
-                    this->uvs.emplace_back(0.166666, 0.333333);
-                    this->uvs.emplace_back(0.333333, 0.333333);
-                    this->uvs.emplace_back(0.166666, 0.5);
-                    this->uvs.emplace_back(0.333333, 0.5);
-                    break;
-                case 'u':
-                case 'U':
-                    char_l_space = (float)(char_width*0.32);
-                    char_r_space = (float)(char_width*0.32);
-                    this->uvs.emplace_back(0.333333, 0.333333);
-                    this->uvs.emplace_back(0.5, 0.333333);
-                    this->uvs.emplace_back(0.333333, 0.5);
-                    this->uvs.emplace_back(0.5, 0.5);
-                    break;
-                case 'v':
-                case 'V':
-                    char_l_space = (float)(char_width*0.28);
-                    char_r_space = (float)(char_width*0.24);
-                    this->uvs.emplace_back(0.5, 0.333333);
-                    this->uvs.emplace_back(0.666666, 0.333333);
-                    this->uvs.emplace_back(0.5, 0.5);
-                    this->uvs.emplace_back(0.666666, 0.5);
-                    break;
-                case 'w':
-                case 'W':
-                    char_l_space = (float)(char_width*0.16);
-                    char_r_space = (float)(char_width*0.16);
-                    this->uvs.emplace_back(0.666666, 0.333333);
-                    this->uvs.emplace_back(0.833333, 0.333333);
-                    this->uvs.emplace_back(0.666666, 0.5);
-                    this->uvs.emplace_back(0.833333, 0.5);
-                    break;
-                case 'x':
-                case 'X':
-                    char_l_space = (float)(char_width*0.32);
-                    char_r_space = (float)(char_width*0.32);
-                    this->uvs.emplace_back(0.833333, 0.333333);
-                    this->uvs.emplace_back(1, 0.333333);
-                    this->uvs.emplace_back(0.833333, 0.5);
-                    this->uvs.emplace_back(1, 0.5);
-                    break;
-                case 'y':
-                case 'Y':
-                    char_l_space = (float)(char_width*0.32);
-                    char_r_space = (float)(char_width*0.32);
-                    this->uvs.emplace_back(0, 0.166666);
-                    this->uvs.emplace_back(0.166666, 0.166666);
-                    this->uvs.emplace_back(0, 0.333333);
-                    this->uvs.emplace_back(0.166666, 0.333333);
-                    break;
-                case 'z':
-                case 'Z':
-                    char_l_space = (float)(char_width*0.28);
-                    char_r_space = (float)(char_width*0.28);
-                    this->uvs.emplace_back(0.166666, 0.166666);
-                    this->uvs.emplace_back(0.333333, 0.166666);
-                    this->uvs.emplace_back(0.166666, 0.333333);
-                    this->uvs.emplace_back(0.333333, 0.333333);
-                    break;
-                case '1':
-                    char_l_space = (float)(char_width*0.28);
-                    char_r_space = (float)(char_width*0.28);
-                    this->uvs.emplace_back(0.333333, 0.25);
-                    this->uvs.emplace_back(0.416666, 0.25);
-                    this->uvs.emplace_back(0.333333, 0.333333);
-                    this->uvs.emplace_back(0.416666, 0.333333);
-                    break;
-                case '2':
-                    char_l_space = (float)(char_width*0.28);
-                    char_r_space = (float)(char_width*0.28);
-                    this->uvs.emplace_back(0.5, 0.25);
-                    this->uvs.emplace_back(0.583333, 0.25);
-                    this->uvs.emplace_back(0.5, 0.333333);
-                    this->uvs.emplace_back(0.583333, 0.333333);
-                    break;
-                case '3':
-                    char_l_space = (float)(char_width*0.28);
-                    char_r_space = (float)(char_width*0.28);
-                    this->uvs.emplace_back(0.666666, 0.166666);
-                    this->uvs.emplace_back(0.833333, 0.166666);
-                    this->uvs.emplace_back(0.666666, 0.333333);
-                    this->uvs.emplace_back(0.833333, 0.333333);
-                    break;
-                case '4':
-                    char_l_space = (float)(char_width*0.28);
-                    char_r_space = (float)(char_width*0.28);
-                    this->uvs.emplace_back(0.833333, 0.166666);
-                    this->uvs.emplace_back(1, 0.166666);
-                    this->uvs.emplace_back(0.833333, 0.333333);
-                    this->uvs.emplace_back(1, 0.333333);
-                    break;
-                case '5':
-                    char_l_space = (float)(char_width*0.28);
-                    char_r_space = (float)(char_width*0.28);
-                    this->uvs.emplace_back(0, 0.0f);
-                    this->uvs.emplace_back(0.166666, 0.0f);
-                    this->uvs.emplace_back(0, 0.166666);
-                    this->uvs.emplace_back(0.166666, 0.16666);
-                    break;
-                case '6':
-                    char_l_space = (float)(char_width*0.28);
-                    char_r_space = (float)(char_width*0.28);
-                    this->uvs.emplace_back(0.166666, 0);
-                    this->uvs.emplace_back(0.333333, 0);
-                    this->uvs.emplace_back(0.166666, 0.166666);
-                    this->uvs.emplace_back(0.333333, 0.166666);
-                    break;
-                case '7':
-                    char_l_space = (float)(char_width*0.28);
-                    char_r_space = (float)(char_width*0.28);
-                    this->uvs.emplace_back(0.333333, 0);
-                    this->uvs.emplace_back(0.5, 0);
-                    this->uvs.emplace_back(0.333333, 0.166666);
-                    this->uvs.emplace_back(0.5, 0.166666);
-                    break;
-                case '8':
-                    char_l_space = (float)(char_width*0.28);
-                    char_r_space = (float)(char_width*0.28);
-                    this->uvs.emplace_back(0.5, 0);
-                    this->uvs.emplace_back(0.666666, 0);
-                    this->uvs.emplace_back(0.5, 0.166666);
-                    this->uvs.emplace_back(0.666666, 0.166666);
-                    break;
-                case '9':
-                    char_l_space = (float)(char_width*0.28);
-                    char_r_space = (float)(char_width*0.28);
-                    this->uvs.emplace_back(0.666666, 0);
-                    this->uvs.emplace_back(0.833333, 0);
-                    this->uvs.emplace_back(0.666666, 0.166666);
-                    this->uvs.emplace_back(0.833333, 0.166666);
-                    break;
-                case '0':
-                    char_l_space = (float)(char_width*0.28);
-                    char_r_space = (float)(char_width*0.28);
-                    this->uvs.emplace_back(0.833333, 0);
-                    this->uvs.emplace_back(1, 0);
-                    this->uvs.emplace_back(0.833333, 0.166666);
-                    this->uvs.emplace_back(1, 0.166666);
-                    break;
-                case '-':
-                    char_l_space = (float)(char_width*0.28);
-                    char_r_space = (float)(char_width*0.28);
-                    this->uvs.emplace_back(0.5, 0.166666);
-                    this->uvs.emplace_back(0.583333, 0.166666);
-                    this->uvs.emplace_back(0.5, 0.25);
-                    this->uvs.emplace_back(0.583333, 0.25);
-                    break;
-                case ' ':
-                    char_l_space = (float)(char_width*0.0);
-                    char_r_space = (float)(char_width*0.5);
-                    this->uvs.emplace_back(0.0f, 0.0f);
-                    this->uvs.emplace_back(0.04, 0.0);
-                    this->uvs.emplace_back(0.0f, 0.04f);
-                    this->uvs.emplace_back(0.04f, 0.04f);
-                    break;
-                case ',':
-                    char_l_space = char_width*0.0f;
-                    char_r_space = char_width*0.8f;
-                    this->uvs.emplace_back(0.416666, 0.25f); // 5.0f/12.0f, 3.0f/12.0f
-                    this->uvs.emplace_back(0.5, 0.25);
-                    this->uvs.emplace_back(0.416666, 0.333333);
-                    this->uvs.emplace_back(0.5, 0.333333);
-                    break;
-                case '.':
-                    char_l_space = char_width*0.0f;
-                    char_r_space = char_width*0.8f;
-                    this->uvs.emplace_back(0.333333, 0.166666); // 2.0f/6.0f, 1.0f/6.0f
-                    this->uvs.emplace_back(0.416666, 0.166666); // 5.0f/12.0f, 1.0f/6.0f
-                    this->uvs.emplace_back(0.333333, 0.25f); // 2.0f/6.0f, 3.0f/12.0f
-                    this->uvs.emplace_back(0.416666, 0.25f);
-                    break;
-                case ':' :
-                    char_l_space = char_width*0.3f;
-                    char_r_space = char_width*0.3f;
-                    this->uvs.emplace_back(0.416666, 0.166666);
-                    this->uvs.emplace_back(0.5, 0.166666);
-                    this->uvs.emplace_back(0.416666, 0.25f);
-                    this->uvs.emplace_back(0.5, 0.25f);
-                    break;
-                case '\n' : // new line key
-                    line_width_sum = l_margin;
-                    line_height += char_height;
-                    continue;
-                default:
-                    char_l_space = 0.0;
-                    char_r_space = 0.0;
-
-                    this->uvs.emplace_back(0.0f, 0.0f);
-                    this->uvs.emplace_back(0.04, 0.0);
-                    this->uvs.emplace_back(0.0f, 0.04f);
-                    this->uvs.emplace_back(0.04f, 0.04f);
-
-            }
+        if(message[i]=='\n'){
+            line_width_sum = l_margin;
+            line_height += char_height;
+            continue;
         }
 
-        //char_l_space, char_r_space and uv coordinates are relative to mythos_text_map
-
-        if(FONT_STYLE==FONT_STYLE_MYTHOS) {
-            switch (message[i]) {
-                case 'a':
-                case 'A':
-                    char_l_space = char_width * 0.12f;
-                    char_r_space = char_width * 0.2f;
-                    this->uvs.emplace_back(0, 0.833333);
-                    this->uvs.emplace_back(0.166666, 0.833333);
-                    this->uvs.emplace_back(0, 1);
-                    this->uvs.emplace_back(0.166666, 1);
-                    break;
-                case 'b':
-                case 'B':
-                    char_l_space = char_width * 0.24f;
-                    char_r_space = char_width * 0.2f;
-                    this->uvs.emplace_back(0.166666, 0.833333);
-                    this->uvs.emplace_back(0.333333, 0.833333);
-                    this->uvs.emplace_back(0.166666, 1);
-                    this->uvs.emplace_back(0.333333, 1);
-                    break;
-                case 'c':
-                case 'C':
-                    char_l_space = char_width * 0.2f;
-                    char_r_space = char_width * 0.2f;
-
-                    this->uvs.emplace_back(0.333333, 0.833333);
-                    this->uvs.emplace_back(0.5, 0.833333);
-                    this->uvs.emplace_back(0.333333, 1);
-                    this->uvs.emplace_back(0.5, 1);
-                    break;
-                case 'd':
-                case 'D':
-                    char_l_space = char_width * 0.16f;
-                    char_r_space = char_width * 0.12f;
-                    this->uvs.emplace_back(0.5, 0.833333);
-                    this->uvs.emplace_back(0.666666, 0.833333);
-                    this->uvs.emplace_back(0.5, 1);
-                    this->uvs.emplace_back(0.666666, 1);
-                    break;
-                case 'e':
-                case 'E':
-                    char_l_space = char_width * 0.2f;
-                    char_r_space = char_width * 0.2f;
-                    this->uvs.emplace_back(0.666666, 0.833333);
-                    this->uvs.emplace_back(0.833333, 0.833333);
-                    this->uvs.emplace_back(0.666666, 1);
-                    this->uvs.emplace_back(0.833333, 1);
-                    break;
-                case 'f':
-                case 'F':
-                    char_l_space = char_width * 0.32f;
-                    char_r_space = char_width * 0.2f;
-                    this->uvs.emplace_back(0.833333, 0.833333);
-                    this->uvs.emplace_back(1, 0.833333);
-                    this->uvs.emplace_back(0.833333, 1);
-                    this->uvs.emplace_back(1, 1);
-                    break;
-                case 'g':
-                case 'G':
-                    char_l_space = char_width * 0.12f;
-                    char_r_space = char_width * 0.12f;
-                    this->uvs.emplace_back(0, 0.666666);
-                    this->uvs.emplace_back(0.166666, 0.666666);
-                    this->uvs.emplace_back(0, 0.833333);
-                    this->uvs.emplace_back(0.166666, 0.833333);
-                    break;
-                case 'h':
-                case 'H':
-                    char_l_space = char_width * 0.16f;
-                    char_r_space = char_width * 0.16f;
-                    this->uvs.emplace_back(0.166666, 0.666666);
-                    this->uvs.emplace_back(0.333333, 0.666666);
-                    this->uvs.emplace_back(0.166666, 0.833333);
-                    this->uvs.emplace_back(0.333333, 0.833333);
-                    break;
-                case 'i':
-                case 'I':
-                    char_l_space = char_width * 0.36f;
-                    char_r_space = char_width * 0.28f;
-                    this->uvs.emplace_back(0.333333, 0.666666);
-                    this->uvs.emplace_back(0.5, 0.666666);
-                    this->uvs.emplace_back(0.333333, 0.833333);
-                    this->uvs.emplace_back(0.5, 0.833333);
-                    break;
-                case 'j':
-                case 'J':
-                    char_l_space = char_width * 0.24f;
-                    char_r_space = char_width * 0.24f;
-                    this->uvs.emplace_back(0.5, 0.666666);
-                    this->uvs.emplace_back(0.666666, 0.666666);
-                    this->uvs.emplace_back(0.5, 0.833333);
-                    this->uvs.emplace_back(0.666666, 0.833333);
-                    break;
-                case 'k':
-                case 'K':
-                    char_l_space = char_width * 0.24f;
-                    char_r_space = char_width * 0.24f;
-                    this->uvs.emplace_back(0.666666, 0.666666);
-                    this->uvs.emplace_back(0.833333, 0.666666);
-                    this->uvs.emplace_back(0.666666, 0.833333);
-                    this->uvs.emplace_back(0.833333, 0.833333);
-                    break;
-                case 'l':
-                case 'L':
-                    char_l_space = char_width * 0.32f;
-                    char_r_space = char_width * 0.16f;
-                    this->uvs.emplace_back(0.833333, 0.666666);
-                    this->uvs.emplace_back(1, 0.666666);
-                    this->uvs.emplace_back(0.833333, 0.833333);
-                    this->uvs.emplace_back(1, 0.833333);
-                    break;
-                case 'm':
-                case 'M':
-                    char_l_space = char_width * 0.0f;
-                    char_r_space = char_width * 0.0f;
-                    this->uvs.emplace_back(0, 0.5);
-                    this->uvs.emplace_back(0.166666, 0.5);
-                    this->uvs.emplace_back(0, 0.666666);
-                    this->uvs.emplace_back(0.166666, 0.666666);
-                    break;
-                case 'n':
-                case 'N':
-                    char_l_space = char_width * 0.12f;
-                    char_r_space = char_width * 0.16f;
-                    this->uvs.emplace_back(0.166666, 0.5);
-                    this->uvs.emplace_back(0.333333, 0.5);
-                    this->uvs.emplace_back(0.166666, 0.666666);
-                    this->uvs.emplace_back(0.333333, 0.666666);
-                    break;
-                case 'o':
-                case 'O':
-                    char_l_space = char_width * 0.16f;
-                    char_r_space = char_width * 0.12f;
-                    this->uvs.emplace_back(0.333333, 0.5);
-                    this->uvs.emplace_back(0.5, 0.5);
-                    this->uvs.emplace_back(0.333333, 0.666666);
-                    this->uvs.emplace_back(0.5, 0.666666);
-                    break;
-                case 'p':
-                case 'P':
-                    char_l_space = char_width * 0.2f;
-                    char_r_space = char_width * 0.16f;
-                    this->uvs.emplace_back(0.5, 0.5);
-                    this->uvs.emplace_back(0.666666, 0.5);
-                    this->uvs.emplace_back(0.5, 0.666666);
-                    this->uvs.emplace_back(0.666666, 0.666666);
-                    break;
-                case 'q':
-                case 'Q':
-                    char_l_space = char_width * 0.16f;
-                    char_r_space = char_width * 0.12f;
-                    this->uvs.emplace_back(0.666666, 0.5);
-                    this->uvs.emplace_back(0.833333, 0.5);
-                    this->uvs.emplace_back(0.666666, 0.666666);
-                    this->uvs.emplace_back(0.833333, 0.666666);
-                    break;
-                case 'r':
-                case 'R':
-                    char_l_space = char_width * 0.28f;
-                    char_r_space = char_width * 0.12f;
-                    this->uvs.emplace_back(0.833333, 0.5);
-                    this->uvs.emplace_back(1.0, 0.5);
-                    this->uvs.emplace_back(0.833333, 0.666666);
-                    this->uvs.emplace_back(1.0, 0.666666);
-                    break;
-                case 's':
-                case 'S':
-                    char_l_space = char_width * 0.2f;
-                    char_r_space = char_width * 0.28f;
-                    this->uvs.emplace_back(0, 0.333333);
-                    this->uvs.emplace_back(0.166666, 0.333333);
-                    this->uvs.emplace_back(0, 0.5);
-                    this->uvs.emplace_back(0.166666, 0.5);
-                    break;
-                case 't':
-                case 'T':
-                    char_l_space = char_width * 0.2f;
-                    char_r_space = char_width * 0.16f;
-                    this->uvs.emplace_back(0.166666, 0.333333);
-                    this->uvs.emplace_back(0.333333, 0.333333);
-                    this->uvs.emplace_back(0.166666, 0.5);
-                    this->uvs.emplace_back(0.333333, 0.5);
-                    break;
-                case 'u':
-                case 'U':
-                    char_l_space = char_width * 0.2f;
-                    char_r_space = char_width * 0.16f;
-                    this->uvs.emplace_back(0.333333, 0.333333);
-                    this->uvs.emplace_back(0.5, 0.333333);
-                    this->uvs.emplace_back(0.333333, 0.5);
-                    this->uvs.emplace_back(0.5, 0.5);
-                    break;
-                case 'v':
-                case 'V':
-                    char_l_space = char_width * 0.2f;
-                    char_r_space = char_width * 0.16f;
-                    this->uvs.emplace_back(0.5, 0.333333);
-                    this->uvs.emplace_back(0.666666, 0.333333);
-                    this->uvs.emplace_back(0.5, 0.5);
-                    this->uvs.emplace_back(0.666666, 0.5);
-                    break;
-                case 'w':
-                case 'W':
-                    char_l_space = char_width * 0.0f;
-                    char_r_space = char_width * 0.0f;
-                    this->uvs.emplace_back(0.666666, 0.333333);
-                    this->uvs.emplace_back(0.833333, 0.333333);
-                    this->uvs.emplace_back(0.666666, 0.5);
-                    this->uvs.emplace_back(0.833333, 0.5);
-                    break;
-                case 'x':
-                case 'X':
-                    char_l_space = char_width * 0.16f;
-                    char_r_space = char_width * 0.08f;
-                    this->uvs.emplace_back(0.833333, 0.333333);
-                    this->uvs.emplace_back(1, 0.333333);
-                    this->uvs.emplace_back(0.833333, 0.5);
-                    this->uvs.emplace_back(1, 0.5);
-                    break;
-                case 'y':
-                case 'Y':
-                    char_l_space = char_width * 0.16f;
-                    char_r_space = char_width * 0.24f;
-                    this->uvs.emplace_back(0, 0.166666);
-                    this->uvs.emplace_back(0.166666, 0.166666);
-                    this->uvs.emplace_back(0, 0.333333);
-                    this->uvs.emplace_back(0.166666, 0.333333);
-                    break;
-                case 'z':
-                case 'Z':
-                    char_l_space = char_width * 0.2f;
-                    char_r_space = char_width * 0.2f;
-                    this->uvs.emplace_back(0.166666, 0.166666);
-                    this->uvs.emplace_back(0.333333, 0.166666);
-                    this->uvs.emplace_back(0.166666, 0.333333);
-                    this->uvs.emplace_back(0.333333, 0.333333);
-                    break;
-                case '1':
-                    char_l_space = char_width * 0.2f;
-                    char_r_space = char_width * 0.2f;
-                    this->uvs.emplace_back(0.333333, 0.25);
-                    this->uvs.emplace_back(0.416666, 0.25);
-                    this->uvs.emplace_back(0.333333, 0.333333);
-                    this->uvs.emplace_back(0.416666, 0.333333);
-                    break;
-                case '2':
-                    char_l_space = char_width * 0.2f;
-                    char_r_space = char_width * 0.2f;
-                    this->uvs.emplace_back(0.5, 0.166666);
-                    this->uvs.emplace_back(0.666666, 0.166666);
-                    this->uvs.emplace_back(0.5, 0.333333);
-                    this->uvs.emplace_back(0.666666, 0.333333);
-                    break;
-                case '3':
-                    char_l_space = char_width * 0.2f;
-                    char_r_space = char_width * 0.2f;
-                    this->uvs.emplace_back(0.666666, 0.166666);
-                    this->uvs.emplace_back(0.833333, 0.166666);
-                    this->uvs.emplace_back(0.666666, 0.333333);
-                    this->uvs.emplace_back(0.833333, 0.333333);
-                    break;
-                case '4':
-                    char_l_space = char_width * 0.2f;
-                    char_r_space = char_width * 0.2f;
-                    this->uvs.emplace_back(0.833333, 0.166666);
-                    this->uvs.emplace_back(1, 0.166666);
-                    this->uvs.emplace_back(0.833333, 0.333333);
-                    this->uvs.emplace_back(1, 0.333333);
-                    break;
-                case '5':
-                    char_l_space = char_width * 0.2f;
-                    char_r_space = char_width * 0.2f;
-                    this->uvs.emplace_back(0, 0.0f);
-                    this->uvs.emplace_back(0.166666, 0.0f);
-                    this->uvs.emplace_back(0, 0.166666);
-                    this->uvs.emplace_back(0.166666, 0.16666);
-                    break;
-                case '6':
-                    char_l_space = char_width * 0.2f;
-                    char_r_space = char_width * 0.2f;
-                    this->uvs.emplace_back(0.166666, 0);
-                    this->uvs.emplace_back(0.333333, 0);
-                    this->uvs.emplace_back(0.166666, 0.166666);
-                    this->uvs.emplace_back(0.333333, 0.166666);
-                    break;
-                case '7':
-                    char_l_space = char_width * 0.2f;
-                    char_r_space = char_width * 0.2f;
-                    this->uvs.emplace_back(0.333333, 0);
-                    this->uvs.emplace_back(0.5, 0);
-                    this->uvs.emplace_back(0.333333, 0.166666);
-                    this->uvs.emplace_back(0.5, 0.166666);
-                    break;
-                case '8':
-                    char_l_space = char_width * 0.2f;
-                    char_r_space = char_width * 0.2f;
-                    this->uvs.emplace_back(0.5, 0);
-                    this->uvs.emplace_back(0.666666, 0);
-                    this->uvs.emplace_back(0.5, 0.166666);
-                    this->uvs.emplace_back(0.666666, 0.166666);
-                    break;
-                case '9':
-                    char_l_space = char_width * 0.2f;
-                    char_r_space = char_width * 0.2f;
-                    this->uvs.emplace_back(0.666666, 0);
-                    this->uvs.emplace_back(0.833333, 0);
-                    this->uvs.emplace_back(0.666666, 0.166666);
-                    this->uvs.emplace_back(0.833333, 0.166666);
-                    break;
-                case '0':
-                    char_l_space = char_width * 0.2f;
-                    char_r_space = char_width * 0.2f;
-                    this->uvs.emplace_back(0.833333, 0);
-                    this->uvs.emplace_back(1, 0);
-                    this->uvs.emplace_back(0.833333, 0.166666);
-                    this->uvs.emplace_back(1, 0.166666);
-                    break;
-                case ' ':
-                    char_l_space = (float)(char_width * 0.0);
-                    char_r_space = (float)(char_width * 0.5);
-                    this->uvs.emplace_back(0.0f, 0.0f);
-                    this->uvs.emplace_back(0.04, 0.0);
-                    this->uvs.emplace_back(0.0f, 0.04f);
-                    this->uvs.emplace_back(0.04f, 0.04f);
-                    break;
-                case ',':
-                    char_l_space = char_width * 0.0f;
-                    char_r_space = char_width * 0.8f;
-                    this->uvs.emplace_back(0.416666, 0.25f); // 5.0f/12.0f, 3.0f/12.0f
-                    this->uvs.emplace_back(0.5, 0.25);
-                    this->uvs.emplace_back(0.416666, 0.333333);
-                    this->uvs.emplace_back(0.5, 0.333333);
-                    break;
-                case '.':
-                    char_l_space = char_width * 0.0f;
-                    char_r_space = char_width * 0.8f;
-                    this->uvs.emplace_back(0.333333, 0.166666); // 2.0f/6.0f, 1.0f/6.0f
-                    this->uvs.emplace_back(0.416666, 0.166666); // 5.0f/12.0f, 1.0f/6.0f
-                    this->uvs.emplace_back(0.333333, 0.25f); // 2.0f/6.0f, 3.0f/12.0f
-                    this->uvs.emplace_back(0.416666, 0.25f);
-                    break;
-                case '\n' : // new line key
-                    line_width_sum = l_margin;
-                    line_height += char_height;
-                    continue;
-                default:
-                    char_l_space = 0.0;
-                    char_r_space = 0.0;
-
-                    this->uvs.emplace_back(0.0f, 0.0f);
-                    this->uvs.emplace_back(0.04, 0.0);
-                    this->uvs.emplace_back(0.0f, 0.04f);
-                    this->uvs.emplace_back(0.04f, 0.04f);
-
-            }
-        }
+        cursor = line_width_sum;
 
+        const GlyphMetrics& glyph = getGlyphMetrics(font_style, message[i]);
+
+        //the amount we can overlap on either side
+        float char_l_space = char_width * glyph.l_space;
+        float char_r_space = char_width * glyph.r_space;
 
         //we are 'cutting away' the extra space before and after chars
-        line_width_sum += char_width - (char_l_space + char_r_space);
+        float advance = char_width - (char_l_space + char_r_space);
+        line_width_sum += advance;
 
         //we need to check if we need to go to the next line BEFORE assigning the vertices
         if(line_width_sum > 1.0){
             //we are drawing from the top down
             line_height += char_height;
             cursor = l_margin;
-            line_width_sum = 0.0f;
+            line_width_sum = l_margin + advance;
         }
 
         if(line_height>1){
@@ -841,29 +219,27 @@ Text::Text(
         this->vertices.emplace_back(cursor - char_l_space, 1.0f - line_height, 0.0f);
         this->vertices.emplace_back(cursor - char_l_space + char_width, 1.0f - line_height, 0.0f);
 
+        this->uvs.emplace_back(glyph.u_min / 12.0f, glyph.v_min / 12.0f);
+        this->uvs.emplace_back(glyph.u_max / 12.0f, glyph.v_min / 12.0f);
+        this->uvs.emplace_back(glyph.u_min / 12.0f, glyph.v_max / 12.0f);
+        this->uvs.emplace_back(glyph.u_max / 12.0f, glyph.v_max / 12.0f);
     }
+}
 
-    this->vao = this->initVertexArray(
-            this->vertices,
-            this->elements,
-            this->normals,
-            this->uvs,
-            &this->vertices_buffer,
-            &this->element_buffer,
-            &this->normal_buffer,
-            &this->uv_buffer
-    );
-
+void Text::draw(
+        const glm::mat4& view_matrix,
+        const glm::mat4& projection_matrix,
+        const Light& light
+) {
+    Entity::draw(view_matrix, projection_matrix, light);
 
-}
+    if (this->isHidden()) {
+        return;
+    }
 
-Text::~Text()
-{
-    glDeleteBuffers(1, &this->vertices_buffer);
-    glDeleteBuffers(1, &this->element_buffer);
-    glDeleteBuffers(1, &this->uv_buffer);
-    glDeleteBuffers(1, &this->normal_buffer);
-    glDeleteVertexArrays(1, &this->vao);
+    // drawn later together with every other string in the same font,
+    // see TextRenderer::flush
+    TextRenderer::queue(this->font_style, this->vertices, this->uvs, this->getModelMatrix());
 }
 
 const std::vector<glm::vec3>& Text::getVertices() const
@@ -873,7 +249,8 @@ const std::vector<glm::vec3>& Text::getVertices() const
 
 GLuint Text::getVAO()
 {
-    return this->vao;
+    // glyphs live in TextRenderer's shared buffers
+    return 0;
 }
 
 const int Text::getColorType()
@@ -883,9 +260,5 @@ const int Text::getColorType()
 
 GLuint Text::getTextureId()
 {
-    return this->font_map;
+    return TextRenderer::getFontMapId(this->font_style);
 }
-
-
-
-
@@ -14,18 +14,16 @@
 #include "Entity.hpp"
 #include "DrawableEntity.hpp"
 
+// A string laid out as glyph quads on the [0,1] plane. Text doesn't own any GL
+// buffers, draw() hands the quads to TextRenderer which draws every string of a
+// font at once.
 class Text : public DrawableEntity {
 private:
     std::vector<glm::vec3> vertices;
-    std::vector<GLuint> elements;
-    std::vector<glm::vec3> normals;
     std::vector<glm::vec2>uvs;
-    GLuint font_map;
-    GLuint vao;
-    GLuint vertices_buffer;
-    GLuint element_buffer;
-    GLuint uv_buffer;
-    GLuint normal_buffer;
+    unsigned int font_style;
+    int line_start;
+    float left_margin;
 public:
     Text(
             const GLuint& shader_program,
@@ -49,7 +47,12 @@ public:
             const unsigned int FONT_STYLE,
             Entity* parent
     );
-    ~Text() override;
+    void setMessage(const std::string& message);
+    void draw(
+            const glm::mat4& view_matrix,
+            const glm::mat4& projection_matrix,
+            const Light& light
+    ) override;
     const std::vector<glm::vec3>& getVertices() const override;
     GLuint getVAO() override;
     const int getColorType() override;
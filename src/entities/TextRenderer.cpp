@@ -0,0 +1,174 @@
+#ifdef __APPLE__
+#include <OpenGL/gl3.h>
+#include <OpenGL/gl3ext.h>
+#else
+#include <GL/glew.h> // include GL Extension Wrangler
+#endif
+
+#include <glm/glm.hpp>
+#include <glm/gtc/type_ptr.hpp>
+#include <map>
+#include <vector>
+#include <cstddef>
+
+#include "TextRenderer.hpp"
+#include "../constants.hpp"
+#include "../TextureManager.hpp"
+
+std::map<unsigned int, TextRenderer::Batch> TextRenderer::batches;
+
+static TextureHandle loadFontMap(const unsigned int& font_style)
+{
+	return TextureManager::get(
+			font_style == FONT_STYLE_OUTLINE ? "../textures/outline_text_map.png" : "../textures/mythos_text_map.png",
+			GL_LINEAR,
+			GL_LINEAR,
+			true
+	);
+}
+
+void TextRenderer::queue(
+		const unsigned int& font_style,
+		const std::vector<glm::vec3>& vertices,
+		const std::vector<glm::vec2>& uvs,
+		const glm::mat4& model_matrix
+) {
+	Batch& batch = batches[font_style];
+	if (!batch.font_map) {
+		batch.font_map = loadFontMap(font_style);
+	}
+
+	for (size_t i = 0; i < vertices.size(); i++) {
+		GlyphVertex vertex;
+		vertex.position = glm::vec3(model_matrix * glm::vec4(vertices[i], 1.0f));
+		vertex.uv = uvs[i];
+		batch.vertices.push_back(vertex);
+	}
+}
+
+GLuint TextRenderer::getFontMapId(const unsigned int& font_style)
+{
+	Batch& batch = batches[font_style];
+	if (!batch.font_map) {
+		batch.font_map = loadFontMap(font_style);
+	}
+	return batch.font_map->getId();
+}
+
+void TextRenderer::prepare(const GLuint& shader_program, Batch& batch)
+{
+	if (batch.vao == 0) {
+		glGenVertexArrays(1, &batch.vao);
+		glBindVertexArray(batch.vao);
+
+		glGenBuffers(1, &batch.vertex_buffer);
+		glBindBuffer(GL_ARRAY_BUFFER, batch.vertex_buffer);
+
+		auto v_position = (GLuint)glGetAttribLocation(shader_program, "v_position");
+		glEnableVertexAttribArray(v_position);
+		glVertexAttribPointer(v_position, 3, GL_FLOAT, GL_FALSE, sizeof(GlyphVertex),
+		                      (const void*)offsetof(GlyphVertex, position));
+
+		auto tex_coord_in = (GLuint)glGetAttribLocation(shader_program, "tex_coord_in");
+		glEnableVertexAttribArray(tex_coord_in);
+		glVertexAttribPointer(tex_coord_in, 2, GL_FLOAT, GL_FALSE, sizeof(GlyphVertex),
+		                      (const void*)offsetof(GlyphVertex, uv));
+
+		// text is unlit, every glyph faces the same way
+		auto normal = (GLuint)glGetAttribLocation(shader_program, "normal");
+		glDisableVertexAttribArray(normal);
+		glVertexAttrib3f(normal, 0.0f, 0.0f, 1.0f);
+
+		glGenBuffers(1, &batch.element_buffer);
+		glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, batch.element_buffer);
+	} else {
+		glBindVertexArray(batch.vao);
+		glBindBuffer(GL_ARRAY_BUFFER, batch.vertex_buffer);
+	}
+
+	// the quad index pattern never changes, it only has to grow with the text
+	size_t quads = batch.vertices.size() / 4;
+	if (quads > batch.quad_capacity) {
+		size_t capacity = batch.quad_capacity == 0 ? 64 : batch.quad_capacity;
+		while (capacity < quads) capacity *= 2;
+
+		std::vector<GLuint> elements;
+		elements.reserve(capacity * 6);
+		for (GLuint j = 0; j < capacity * 4; j += 4) {
+			elements.push_back(j + 2);
+			elements.push_back(j);
+			elements.push_back(j + 1);
+			elements.push_back(j + 2);
+			elements.push_back(j + 1);
+			elements.push_back(j + 3);
+		}
+		glBufferData(GL_ELEMENT_ARRAY_BUFFER, elements.size() * sizeof(GLuint), elements.data(), GL_STATIC_DRAW);
+		batch.quad_capacity = capacity;
+	}
+
+	if (batch.vertices == batch.uploaded) {
+		return;
+	}
+
+	if (batch.vertices.size() > batch.vertex_capacity) {
+		batch.vertex_capacity = batch.quad_capacity * 4;
+	}
+	// orphan last frame's storage so we don't wait on the GPU still reading it
+	glBufferData(GL_ARRAY_BUFFER, batch.vertex_capacity * sizeof(GlyphVertex), nullptr, GL_DYNAMIC_DRAW);
+	glBufferSubData(GL_ARRAY_BUFFER, 0, batch.vertices.size() * sizeof(GlyphVertex), batch.vertices.data());
+	batch.uploaded = batch.vertices;
+}
+
+void TextRenderer::flush(
+		const GLuint& shader_program,
+		const glm::mat4& view_matrix,
+		const glm::mat4& projection_matrix
+) {
+	auto mvp_matrix_loc = (GLuint)glGetUniformLocation(shader_program, "mvp_matrix");
+	auto model_loc = (GLuint)glGetUniformLocation(shader_program, "model");
+	auto color_type_loc = (GLuint)glGetUniformLocation(shader_program, "color_type");
+	auto use_texture_loc = (GLuint)glGetUniformLocation(shader_program, "use_texture");
+	auto texture_layer_loc = (GLuint)glGetUniformLocation(shader_program, "texture_layer");
+	auto displacement_type_loc = (GLuint)glGetUniformLocation(shader_program, "displacement_type");
+
+	glUseProgram(shader_program);
+
+	// vertices are already in world space
+	glm::mat4 model_matrix(1.0f);
+	glm::mat4 mvp_matrix = projection_matrix * view_matrix;
+	glUniformMatrix4fv(mvp_matrix_loc, 1, GL_FALSE, glm::value_ptr(mvp_matrix));
+	glUniformMatrix4fv(model_loc, 1, GL_FALSE, glm::value_ptr(model_matrix));
+	glUniform1i(color_type_loc, COLOR_FONT);
+	glUniform1i(use_texture_loc, true);
+	glUniform1i(texture_layer_loc, -1);
+	glUniform1i(displacement_type_loc, DISPLACE_NONE);
+
+	// glyphs are drawn double sided
+	glDisable(GL_CULL_FACE);
+
+	for (auto it = batches.begin(); it != batches.end(); ++it) {
+		Batch& batch = it->second;
+		if (batch.vertices.empty()) continue;
+
+		prepare(shader_program, batch);
+		TextureManager::bind(GL_TEXTURE_2D, batch.font_map->getId());
+		glDrawElements(GL_TRIANGLES, (GLsizei)(batch.vertices.size() / 4 * 6), GL_UNSIGNED_INT, nullptr);
+
+		batch.vertices.clear();
+	}
+
+	glEnable(GL_CULL_FACE);
+	glBindVertexArray(0);
+	glUseProgram(0);
+}
+
+void TextRenderer::shutdown()
+{
+	for (auto it = batches.begin(); it != batches.end(); ++it) {
+		Batch& batch = it->second;
+		glDeleteBuffers(1, &batch.vertex_buffer);
+		glDeleteBuffers(1, &batch.element_buffer);
+		glDeleteVertexArrays(1, &batch.vao);
+	}
+	batches.clear();
+}
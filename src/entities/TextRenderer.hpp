@@ -0,0 +1,60 @@
+#ifndef PROCEDURALWORLD_TEXTRENDERER_HPP
+#define PROCEDURALWORLD_TEXTRENDERER_HPP
+
+#ifdef __APPLE__
+#include <OpenGL/gl3.h>
+#include <OpenGL/gl3ext.h>
+#else
+#include <GL/glew.h> // include GL Extension Wrangler
+#endif
+
+#include <glm/glm.hpp>
+#include <map>
+#include <vector>
+
+#include "../TextureManager.hpp"
+
+// Collects the glyph quads of every visible Text during the frame and draws them
+// with one glDrawElements per font in flush(). Quads are moved to world space on
+// the CPU and streamed into a single dynamic vertex buffer per font.
+class TextRenderer {
+private:
+	struct GlyphVertex {
+		glm::vec3 position;
+		glm::vec2 uv;
+		bool operator==(const GlyphVertex& other) const
+		{
+			return position == other.position && uv == other.uv;
+		}
+	};
+	struct Batch {
+		TextureHandle font_map;
+		std::vector<GlyphVertex> vertices;
+		// what the vertex buffer currently holds, so unchanged text isn't re-sent
+		std::vector<GlyphVertex> uploaded;
+		GLuint vao = 0;
+		GLuint vertex_buffer = 0;
+		GLuint element_buffer = 0;
+		size_t vertex_capacity = 0;
+		size_t quad_capacity = 0;
+	};
+	static std::map<unsigned int, Batch> batches;
+	static void prepare(const GLuint& shader_program, Batch& batch);
+public:
+	// vertices and uvs come four per glyph, as laid out by Text
+	static void queue(
+			const unsigned int& font_style,
+			const std::vector<glm::vec3>& vertices,
+			const std::vector<glm::vec2>& uvs,
+			const glm::mat4& model_matrix
+	);
+	static void flush(
+			const GLuint& shader_program,
+			const glm::mat4& view_matrix,
+			const glm::mat4& projection_matrix
+	);
+	static GLuint getFontMapId(const unsigned int& font_style);
+	static void shutdown();
+};
+
+#endif //PROCEDURALWORLD_TEXTRENDERER_HPP
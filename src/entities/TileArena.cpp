@@ -0,0 +1,136 @@
+#ifdef __APPLE__
+#include <OpenGL/gl3.h>
+#include <OpenGL/gl3ext.h>
+#else
+#include <GL/glew.h> // include GL Extension Wrangler
+#endif
+
+#include <algorithm>
+#include <memory>
+#include <vector>
+#include <cstddef>
+
+#include "TileArena.hpp"
+
+constexpr size_t TileArena::block_size;
+constexpr size_t TileArena::max_idle_arenas;
+
+std::vector<std::unique_ptr<TileArena>> TileArena::idle;
+std::vector<GLuint> TileArena::dead_buffers;
+std::vector<GLuint> TileArena::dead_vertex_arrays;
+
+TileArena* TileArena::acquire()
+{
+	if (TileArena::idle.empty()) {
+		return new TileArena();
+	}
+	TileArena* arena = TileArena::idle.back().release();
+	TileArena::idle.pop_back();
+	return arena;
+}
+
+void TileArena::release(TileArena* const& arena)
+{
+	arena->reset();
+	if (TileArena::idle.size() < TileArena::max_idle_arenas) {
+		TileArena::idle.emplace_back(arena);
+	} else {
+		delete arena;
+	}
+}
+
+void TileArena::shutdown()
+{
+	TileArena::idle.clear();
+	TileArena::deleteQueued();
+}
+
+void TileArena::deleteLater(const GLuint* const& buffers, const size_t& count, const GLuint& vertex_array)
+{
+	for (size_t i = 0; i < count; i++) {
+		if (buffers[i]) {
+			TileArena::dead_buffers.push_back(buffers[i]);
+		}
+	}
+	if (vertex_array) {
+		TileArena::dead_vertex_arrays.push_back(vertex_array);
+	}
+}
+
+void TileArena::deleteQueued()
+{
+	if (!TileArena::dead_buffers.empty()) {
+		glDeleteBuffers((GLsizei)TileArena::dead_buffers.size(), TileArena::dead_buffers.data());
+		TileArena::dead_buffers.clear();
+	}
+	if (!TileArena::dead_vertex_arrays.empty()) {
+		glDeleteVertexArrays((GLsizei)TileArena::dead_vertex_arrays.size(), TileArena::dead_vertex_arrays.data());
+		TileArena::dead_vertex_arrays.clear();
+	}
+}
+
+TileArena::~TileArena()
+{
+	this->reset();
+}
+
+void* TileArena::allocate(const size_t& size, const size_t& align)
+{
+	while (this->block < this->blocks.size()) {
+		Block& current = this->blocks[this->block];
+		const size_t start = (this->offset + align - 1) / align * align;
+		if (start + size <= current.size) {
+			this->offset = start + size;
+			this->used_bytes += size;
+			return current.memory.get() + start;
+		}
+		if (this->offset == 0) {
+			// doesn't fit even an empty block
+			break;
+		}
+		this->block++;
+		this->offset = 0;
+	}
+
+	// new[] memory is aligned for anything. something larger than a block gets one of its own,
+	// ahead of the blocks that are left
+	Block added;
+	added.size = std::max(TileArena::block_size, size);
+	added.memory.reset(new unsigned char[added.size]);
+	unsigned char* memory = added.memory.get();
+	this->blocks.insert(this->blocks.begin() + this->block, std::move(added));
+	this->offset = size;
+	this->used_bytes += size;
+	return memory;
+}
+
+void TileArena::reset()
+{
+	for (size_t i = this->made.size(); i-- > 0;) {
+		this->made[i].destroy(this->made[i].object);
+	}
+	this->made.clear();
+	this->block = 0;
+	this->offset = 0;
+	this->used_bytes = 0;
+	TileArena::deleteQueued();
+}
+
+size_t TileArena::getUsedBytes() const
+{
+	return this->used_bytes;
+}
+
+size_t TileArena::getReservedBytes() const
+{
+	size_t bytes = 0;
+	for (const Block& block : this->blocks) {
+		bytes += block.size;
+	}
+	return bytes;
+}
+
+size_t TileArena::getPooledCount()
+{
+	return TileArena::idle.size();
+}
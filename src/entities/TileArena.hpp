@@ -0,0 +1,93 @@
+#ifndef PROCEDURALWORLD_TILEARENA_HPP
+#define PROCEDURALWORLD_TILEARENA_HPP
+
+#ifdef __APPLE__
+#include <OpenGL/gl3.h>
+#include <OpenGL/gl3ext.h>
+#else
+#include <GL/glew.h> // include GL Extension Wrangler
+#endif
+
+#include <memory>
+#include <new>
+#include <utility>
+#include <vector>
+#include <cstddef>
+
+// Everything a WorldTile puts on itself (rocks, trees) is made in the tile's arena, packed one
+// after the other in a few large blocks, and destroyed all at once with the tile. The blocks are
+// kept: arenas are pooled and handed to the next tile that comes into view.
+//
+// GL objects the entities give up on the way are only queued (deleteLater) and deleted together
+// when the arena is reset.
+
+class TileArena {
+public:
+	// large enough for a tile's worth of rocks and trees on most tiles
+	static constexpr size_t block_size = 64 * 1024;
+	// a row or a column of tiles goes out of view at a time
+	static constexpr size_t max_idle_arenas = 3;
+
+	// a pooled arena if there is one, otherwise a new one
+	static TileArena* acquire();
+	// resets the arena and pools it, or frees it if the pool is full
+	static void release(TileArena* const& arena);
+	static void shutdown();
+
+	// buffers and a vertex array for the next reset() to delete. zero names are skipped
+	static void deleteLater(const GLuint* const& buffers, const size_t& count, const GLuint& vertex_array);
+
+	TileArena() = default;
+	~TileArena();
+	TileArena(const TileArena&) = delete;
+	TileArena& operator=(const TileArena&) = delete;
+
+	// lives until reset()
+	template<class T, class... Args>
+	T* make(Args&&... args)
+	{
+		void* memory = this->allocate(sizeof(T), alignof(T));
+		T* object = new (memory) T(std::forward<Args>(args)...);
+		this->made.push_back({object, &TileArena::destroy<T>});
+		return object;
+	}
+
+	// destroys what was made, newest first, and deletes the queued GL objects
+	void reset();
+
+	size_t getUsedBytes() const;
+	size_t getReservedBytes() const;
+	static size_t getPooledCount();
+
+private:
+	struct Block {
+		std::unique_ptr<unsigned char[]> memory;
+		size_t size;
+	};
+	struct Made {
+		void* object;
+		void (*destroy)(void*);
+	};
+
+	std::vector<Block> blocks;
+	// the block being filled and how far
+	size_t block = 0;
+	size_t offset = 0;
+	size_t used_bytes = 0;
+	std::vector<Made> made;
+
+	static std::vector<std::unique_ptr<TileArena>> idle;
+	static std::vector<GLuint> dead_buffers;
+	static std::vector<GLuint> dead_vertex_arrays;
+
+	void* allocate(const size_t& size, const size_t& align);
+	static void deleteQueued();
+
+	template<class T>
+	static void destroy(void* object)
+	{
+		static_cast<T*>(object)->~T();
+	}
+};
+
+#endif //PROCEDURALWORLD_TILEARENA_HPP
@@ -0,0 +1,220 @@
+#include <glm/glm.hpp>
+#include <glm/gtc/matrix_transform.hpp>
+#include <glm/gtc/quaternion.hpp>
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+
+#include "Entity.hpp"
+#include "TransformSystem.hpp"
+
+constexpr TransformSystem::Handle TransformSystem::no_handle;
+constexpr uint32_t TransformSystem::no_index;
+
+std::vector<uint32_t> TransformSystem::indices;
+std::vector<TransformSystem::Handle> TransformSystem::free_handles;
+std::vector<TransformSystem::Handle> TransformSystem::handles;
+std::vector<Entity*> TransformSystem::entities;
+std::vector<uint32_t> TransformSystem::parents;
+std::vector<glm::vec3> TransformSystem::positions;
+std::vector<glm::quat> TransformSystem::rotations;
+std::vector<glm::vec3> TransformSystem::scales;
+std::vector<glm::mat4> TransformSystem::locals;
+std::vector<glm::mat4> TransformSystem::worlds;
+std::vector<unsigned char> TransformSystem::local_dirty;
+std::vector<unsigned char> TransformSystem::moved;
+size_t TransformSystem::destroyed = 0;
+bool TransformSystem::pending = false;
+
+TransformSystem::Handle TransformSystem::create(Entity* const& entity, const Handle& parent)
+{
+	Handle handle;
+	if (free_handles.empty()) {
+		handle = (Handle)indices.size();
+		indices.push_back(no_index);
+	} else {
+		handle = free_handles.back();
+		free_handles.pop_back();
+	}
+	indices[handle] = (uint32_t)handles.size();
+
+	handles.push_back(handle);
+	entities.push_back(entity);
+	parents.push_back(parent == no_handle ? no_index : indices[parent]);
+	positions.push_back(glm::vec3(0.0f));
+	rotations.push_back(glm::quat());
+	scales.push_back(glm::vec3(1.0f));
+	locals.push_back(glm::mat4());
+	worlds.push_back(glm::mat4());
+	local_dirty.push_back(1);
+	moved.push_back(0);
+	pending = true;
+	return handle;
+}
+
+void TransformSystem::destroy(const Handle& handle)
+{
+	// the arrays are only compacted in update(), so the indices children hold stay good until then
+	entities[indices[handle]] = nullptr;
+	indices[handle] = no_index;
+	free_handles.push_back(handle);
+	destroyed++;
+	// for any children it leaves behind
+	pending = true;
+}
+
+const glm::vec3& TransformSystem::getPosition(const Handle& handle)
+{
+	return positions[indices[handle]];
+}
+
+void TransformSystem::setPosition(const Handle& handle, const glm::vec3& position)
+{
+	positions[indices[handle]] = position;
+	markDirty(handle);
+}
+
+const glm::quat& TransformSystem::getRotation(const Handle& handle)
+{
+	return rotations[indices[handle]];
+}
+
+void TransformSystem::setRotation(const Handle& handle, const glm::quat& rotation)
+{
+	rotations[indices[handle]] = rotation;
+	markDirty(handle);
+}
+
+const glm::vec3& TransformSystem::getScale(const Handle& handle)
+{
+	return scales[indices[handle]];
+}
+
+void TransformSystem::setScale(const Handle& handle, const glm::vec3& scale)
+{
+	scales[indices[handle]] = scale;
+	markDirty(handle);
+}
+
+void TransformSystem::markDirty(const Handle& handle)
+{
+	local_dirty[indices[handle]] = 1;
+	pending = true;
+}
+
+glm::mat4 TransformSystem::localMatrix(const uint32_t& index)
+{
+	static glm::mat4 identity;
+	const Entity* entity = entities[index];
+
+	// the same product Entity used to keep its own matrices for
+	return glm::translate(identity, positions[index]) * entity->getBaseTranslation() *
+			glm::mat4_cast(rotations[index]) * entity->getBaseRotation() *
+			glm::scale(identity, scales[index]) * entity->getBaseScale();
+}
+
+glm::mat4 TransformSystem::getWorldMatrix(const Handle& handle)
+{
+	uint32_t index = indices[handle];
+	if (!pending) {
+		return worlds[index];
+	}
+
+	// the base matrices are virtual, so the local matrices are only kept by update(), once every
+	// entity is done being constructed
+	glm::mat4 world = local_dirty[index] ? localMatrix(index) : locals[index];
+	for (index = parents[index]; index != no_index; index = parents[index]) {
+		if (!entities[index]) {
+			// destroyed, the children don't follow it any more
+			break;
+		}
+		world = (local_dirty[index] ? localMatrix(index) : locals[index]) * world;
+	}
+	return world;
+}
+
+void TransformSystem::update()
+{
+	if (!pending) {
+		return;
+	}
+	if (destroyed > 0 && destroyed * 2 >= handles.size()) {
+		compact();
+	}
+
+	const size_t count = handles.size();
+	for (size_t i = 0; i < count; i++) {
+		if (!entities[i]) {
+			moved[i] = 0;
+			continue;
+		}
+		bool changed = false;
+		if (parents[i] != no_index && !entities[parents[i]]) {
+			// its parent went away, what was its local matrix is now its world matrix
+			parents[i] = no_index;
+			changed = true;
+		}
+		const uint32_t parent = parents[i];
+		if (parent != no_index && moved[parent]) {
+			changed = true;
+		}
+		if (local_dirty[i]) {
+			locals[i] = localMatrix((uint32_t)i);
+			local_dirty[i] = 0;
+			changed = true;
+		}
+		if (changed) {
+			worlds[i] = parent != no_index ? worlds[parent] * locals[i] : locals[i];
+		}
+		moved[i] = changed;
+	}
+	pending = false;
+}
+
+void TransformSystem::compact()
+{
+	const size_t count = handles.size();
+	// where each live transform ends up, in the same order so parents stay ahead
+	std::vector<uint32_t> moved_to(count, no_index);
+	size_t live = 0;
+	for (size_t i = 0; i < count; i++) {
+		if (!entities[i]) {
+			continue;
+		}
+		const uint32_t parent = parents[i] == no_index ? no_index : moved_to[parents[i]];
+		if (parent == no_index && parents[i] != no_index) {
+			// orphaned, see update()
+			local_dirty[i] = 1;
+		}
+		moved_to[i] = (uint32_t)live;
+		handles[live] = handles[i];
+		entities[live] = entities[i];
+		parents[live] = parent;
+		positions[live] = positions[i];
+		rotations[live] = rotations[i];
+		scales[live] = scales[i];
+		locals[live] = locals[i];
+		worlds[live] = worlds[i];
+		local_dirty[live] = local_dirty[i];
+		moved[live] = moved[i];
+		indices[handles[live]] = (uint32_t)live;
+		live++;
+	}
+
+	handles.resize(live);
+	entities.resize(live);
+	parents.resize(live);
+	positions.resize(live);
+	rotations.resize(live);
+	scales.resize(live);
+	locals.resize(live);
+	worlds.resize(live);
+	local_dirty.resize(live);
+	moved.resize(live);
+	destroyed = 0;
+}
+
+size_t TransformSystem::getCount()
+{
+	return handles.size() - destroyed;
+}
@@ -0,0 +1,70 @@
+#ifndef PROCEDURALWORLD_TRANSFORMSYSTEM_HPP
+#define PROCEDURALWORLD_TRANSFORMSYSTEM_HPP
+
+#include <glm/glm.hpp>
+#include <glm/gtc/quaternion.hpp>
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+
+class Entity;
+
+// The position, rotation and scale of every Entity, kept one array per component and reached
+// through a handle that stays the same while the arrays are compacted. An entity is always made
+// after its parent, so creation order has every parent ahead of its children and update() can
+// bring all the world matrices up to date in one pass from front to back.
+
+class TransformSystem {
+public:
+	typedef uint32_t Handle;
+	static constexpr Handle no_handle = UINT32_MAX;
+
+	static Handle create(Entity* const& entity, const Handle& parent);
+	// the children of a destroyed entity are left where they were, without a parent
+	static void destroy(const Handle& handle);
+
+	static const glm::vec3& getPosition(const Handle& handle);
+	static void setPosition(const Handle& handle, const glm::vec3& position);
+	static const glm::quat& getRotation(const Handle& handle);
+	static void setRotation(const Handle& handle, const glm::quat& rotation);
+	static const glm::vec3& getScale(const Handle& handle);
+	static void setScale(const Handle& handle, const glm::vec3& scale);
+
+	// as of the last update() if nothing has changed since, otherwise worked out up the parent chain
+	static glm::mat4 getWorldMatrix(const Handle& handle);
+
+	// the local matrix of everything that changed since the last call and the world matrix of it
+	// and of everything under it. once per frame, before the world is drawn
+	static void update();
+
+	static size_t getCount();
+
+private:
+	static constexpr uint32_t no_index = UINT32_MAX;
+
+	// by handle, where the handle's transform is in the arrays below
+	static std::vector<uint32_t> indices;
+	static std::vector<Handle> free_handles;
+
+	// parents before children. a destroyed entity stays until the arrays are compacted
+	static std::vector<Handle> handles;
+	static std::vector<Entity*> entities;
+	static std::vector<uint32_t> parents;
+	static std::vector<glm::vec3> positions;
+	static std::vector<glm::quat> rotations;
+	static std::vector<glm::vec3> scales;
+	static std::vector<glm::mat4> locals;
+	static std::vector<glm::mat4> worlds;
+	static std::vector<unsigned char> local_dirty;
+	// set by update() for each world matrix it rewrote, so that the children follow
+	static std::vector<unsigned char> moved;
+	static size_t destroyed;
+	// something changed since the last update()
+	static bool pending;
+
+	static glm::mat4 localMatrix(const uint32_t& index);
+	static void markDirty(const Handle& handle);
+	static void compact();
+};
+
+#endif //PROCEDURALWORLD_TRANSFORMSYSTEM_HPP
@@ -14,10 +14,13 @@
 #include <algorithm>
 
 #include <src/HitBox2d.hpp>
+#include <src/HitBoxGrid.hpp>
 
 #include "World.hpp"
 #include "../constants.hpp"
 
+constexpr size_t World::tree_vertex_budget;
+
 World::World(
 	const GLuint& shader_program,
 	const float& player_x_start,
@@ -62,8 +65,11 @@ World::World(
 				this->player_min_world_y,
 				this->player_max_world_y,
 				player_starting_hitbox,
+				this->hitbox_grid,
 				this
 		));
+		// the player starts among these, they don't wait for later frames
+		this->tiles.back()->finishTrees();
 	}
 
 }
@@ -84,38 +90,6 @@ Text* World::getMenu() {
 	return &this->menu;
 }
 
-bool World::pollWorld(const glm::vec3& view_vec, const glm::vec3& up_vec, const float& units) {
-    if(player.deadTime != player.deadMax){
-        if(player.fore){
-            player.moveBack(view_vec, up_vec, units);
-        }
-        else if(player.back){
-            player.moveForward(view_vec, up_vec, units);
-        }
-        else if(player.left){
-            player.moveRight(view_vec, up_vec, units);
-        }
-        else{
-            player.moveLeft(view_vec, up_vec, units);
-        }
-//        if(player.fore){
-//            player.moveForward(view_vec, up_vec, -units / (float)player.deadMax);
-//        }
-//        else if(player.back){
-//            player.moveBack(view_vec, up_vec, -units/ (float)player.deadMax);
-//        }
-//        else if(player.left){
-//            player.moveLeft(view_vec, up_vec, -units/ (float)player.deadMax);
-//        }
-//        else{
-//            player.moveRight(view_vec, up_vec, -units/ (float)player.deadMax);
-//        }
-        player.deadTime++;
-        return true;
-    }
-    return false;
-}
-
 void World::toggleAxes()
 {
 	this->axes.toggleHide();
@@ -181,10 +155,21 @@ void World::placeWorldTile(const int &x, const int &z, const HitBox2d& player_hi
 			this->player_min_world_y,
 			this->player_max_world_y,
 			player_hitbox,
+			this->hitbox_grid,
 			this
 	);
 }
 
+void World::buildTrees()
+{
+	for (WorldTile* const& tile : this->tiles) {
+		if (tile->hasUnbuiltTrees()) {
+			tile->buildTrees(World::tree_vertex_budget);
+			return;
+		}
+	}
+}
+
 int World::locationToTileIndex(const int& x, const int& z)
 {
 	// NOTE: Mapping position -> tile index is arbitrary, but importantly, consistent!
@@ -222,77 +207,30 @@ void World::setPlayerOpacity(const float& opacity)
 
 void World::movePlayerForward(const glm::vec3& view_vec, const glm::vec3& up_vec, const float& units)
 {
-    if(player.deadTime == player.deadMax) {
-        glm::vec3 old_player_position = this->player.getPosition();
-        HitBox2d player_hitbox(this->player);
-        this->player.moveForward(view_vec, up_vec, units);
-        if (this->collidesWith(player_hitbox)) {
-            player.deadTime = 0;
-            player.fore = true;
-            this->player.setPosition(old_player_position);
-//            this->player.setPosition(player.oldPosition);
-        } else {
-            this->checkPosition();
-        }
-        player.oldPosition = old_player_position;
-    }
-    else{  }
+	glm::vec3 old_player_position = this->player.getPosition();
+	this->player.moveForward(view_vec, up_vec, units);
+	this->slidePlayerFrom(old_player_position);
 }
 
 void World::movePlayerBack(const glm::vec3& view_vec, const glm::vec3& up_vec, const float& units)
 {
-
-    if(player.deadTime == player.deadMax){
-        glm::vec3 old_player_position = this->player.getPosition();
-        HitBox2d player_hitbox(this->player);
-        this->player.moveBack(view_vec, up_vec, units);
-        if (this->collidesWith(player_hitbox) ) {
-            player.deadTime = 0;
-            player.back = true;
-            this->player.setPosition(old_player_position);
-//            this->player.setPosition(player.oldPosition);
-        } else {
-            this->checkPosition();
-        }
-        player.oldPosition = old_player_position;
-    }
-
+	glm::vec3 old_player_position = this->player.getPosition();
+	this->player.moveBack(view_vec, up_vec, units);
+	this->slidePlayerFrom(old_player_position);
 }
 
 void World::movePlayerLeft(const glm::vec3& view_vec, const glm::vec3& up_vec, const float& units)
 {
-    if(player.deadTime == player.deadMax){
-        glm::vec3 old_player_position = this->player.getPosition();
-        HitBox2d player_hitbox(this->player);
-        this->player.moveLeft(view_vec, up_vec, units);
-        if (this->collidesWith(player_hitbox)) {
-           player.deadTime = 0;
-            player.right = true;
-            this->player.setPosition(old_player_position);
-//            this->player.setPosition(player.oldPosition);
-        } else {
-            this->checkPosition();
-        }
-        player.oldPosition = old_player_position;
-    }
+	glm::vec3 old_player_position = this->player.getPosition();
+	this->player.moveLeft(view_vec, up_vec, units);
+	this->slidePlayerFrom(old_player_position);
 }
 
 void World::movePlayerRight(const glm::vec3& view_vec, const glm::vec3& up_vec, const float& units)
 {
-    if(player.deadTime == player.deadMax) {
-        glm::vec3 old_player_position = this->player.getPosition();
-        HitBox2d player_hitbox(this->player);
-        this->player.moveRight(view_vec, up_vec, units);
-        if (this->collidesWith(player_hitbox)) {
-//            this->player.setPosition(player.oldPosition);
-            this->player.setPosition(old_player_position);
-            player.deadTime = 0;
-            player.left = true;
-        } else {
-            this->checkPosition();
-        }
-        //player.oldPosition = old_player_position;
-    }
+	glm::vec3 old_player_position = this->player.getPosition();
+	this->player.moveRight(view_vec, up_vec, units);
+	this->slidePlayerFrom(old_player_position);
 }
 
 void World::movePlayerForwardLeft(
@@ -300,17 +238,9 @@ void World::movePlayerForwardLeft(
 	const glm::vec3& up_vec,
 	const float& units
 ) {
-
 	glm::vec3 old_player_position = this->player.getPosition();
-	HitBox2d player_hitbox(this->player);
 	this->player.moveForwardLeft(view_vec, up_vec, units);
-	if (this->collidesWith(player_hitbox)) {
-        this->player.setPosition(player.oldPosition);
-    } else {
-        this->checkPosition();
-    }
-    player.oldPosition = old_player_position;
-
+	this->slidePlayerFrom(old_player_position);
 }
 
 void World::movePlayerForwardRight(
@@ -318,16 +248,9 @@ void World::movePlayerForwardRight(
 	const glm::vec3& up_vec,
 	const float& units
 ) {
-
 	glm::vec3 old_player_position = this->player.getPosition();
-	HitBox2d player_hitbox(this->player);
 	this->player.moveForwardRight(view_vec, up_vec, units);
-	if (this->collidesWith(player_hitbox)) {
-        this->player.setPosition(player.oldPosition);
-    } else {
-        this->checkPosition();
-    }
-    player.oldPosition = old_player_position;
+	this->slidePlayerFrom(old_player_position);
 }
 
 void World::movePlayerBackLeft(
@@ -336,14 +259,8 @@ void World::movePlayerBackLeft(
 	const float& units
 ) {
 	glm::vec3 old_player_position = this->player.getPosition();
-	HitBox2d player_hitbox(this->player);
 	this->player.moveBackLeft(view_vec, up_vec, units);
-	if (this->collidesWith(player_hitbox)) {
-        this->player.setPosition(player.oldPosition);
-    } else {
-        this->checkPosition();
-    }
-    player.oldPosition = old_player_position;
+	this->slidePlayerFrom(old_player_position);
 }
 
 void World::movePlayerBackRight(
@@ -352,22 +269,38 @@ void World::movePlayerBackRight(
 	const float& units
 ) {
 	glm::vec3 old_player_position = this->player.getPosition();
-	HitBox2d player_hitbox(this->player);
 	this->player.moveBackRight(view_vec, up_vec, units);
-	if (this->collidesWith(player_hitbox)) {
-        this->player.setPosition(player.oldPosition);
-    } else {
-        this->checkPosition();
-    }
-    player.oldPosition = old_player_position;
+	this->slidePlayerFrom(old_player_position);
 }
 
-bool World::collidesWith(const HitBox2d& box)
+void World::slidePlayerFrom(const glm::vec3& old_player_position)
 {
-	for (const WorldTile* tile : this->tiles) {
-		if (tile->collidesWith(box)) {
-			return true;
+	// how far the player stays from what it runs into, so that rounding doesn't put it inside
+	static const float skin = 0.0001f;
+	// the player moved and turned, go back and find how far the move really gets
+	const glm::vec3 step = this->player.getPosition() - old_player_position;
+	this->player.setPosition(old_player_position);
+	HitBox2d player_hitbox(this->player);
+
+	glm::vec3 position = old_player_position;
+	glm::vec2 motion(step.x, step.z);
+	// what's left after a hit goes along it, which can run into something else
+	for (int i = 0; i < 3 && (motion.x != 0.0f || motion.y != 0.0f); i++) {
+		glm::vec2 normal;
+		const float t = this->hitbox_grid.sweep(player_hitbox, motion, &normal);
+		if (t >= 1.0f) {
+			position += glm::vec3(motion.x, 0.0f, motion.y);
+			break;
 		}
+		// stop a little short, the way there is clear
+		const float travelled = std::max(0.0f, t - skin / glm::length(motion));
+		const glm::vec2 travel = motion * travelled;
+		position += glm::vec3(travel.x, 0.0f, travel.y);
+		player_hitbox.translate(travel.x, travel.y);
+		motion = motion * (1.0f - travelled);
+		motion = motion - normal * (motion.x * normal.x + motion.y * normal.y);
 	}
-	return false;
+
+	this->player.setPosition(position);
+	this->checkPosition();
 }
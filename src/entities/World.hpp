@@ -12,6 +12,7 @@
 #include <vector>
 
 #include <src/HitBox2d.hpp>
+#include <src/HitBoxGrid.hpp>
 
 #include "Light.h"
 #include "Entity.hpp"
@@ -34,16 +35,23 @@ private:
 	WorldOrigin axes;
     Text menu;
 	std::vector<WorldTile*> tiles;
+	// hit boxes of everything on the tiles, each tile adds its own and takes them out when deleted
+	HitBoxGrid hitbox_grid;
 	// current center tile position
 	int x_center;
 	int z_center;
 	GLuint shader_program;
 	float player_min_world_y;
 	float player_max_world_y;
-	bool collidesWith(const HitBox2d& box);
+	// moves the player from old_player_position to where it is now, as far as it gets before
+	// running into something and then along it
+	void slidePlayerFrom(const glm::vec3& old_player_position);
 	void placeWorldTile(const int& x, const int& z, const HitBox2d& player_hitbox);
 	void checkPosition();
 public:
+	// about how many tree vertices buildTrees generates in a frame
+	static constexpr size_t tree_vertex_budget = 20000;
+
 	explicit World(const GLuint& shader_program) : World(shader_program, nullptr) {}
 	World(const GLuint& shader_program, Entity* parent)
 		: World(shader_program, 0.0f, 0.0f, parent) {}
@@ -61,14 +69,12 @@ public:
 	~World() override;
 
 
-	///////////
-	bool pollWorld(const glm::vec3& view_vec, const glm::vec3& up_vec, const float& units = 1.0f);
-	/////////////
-
 	const Player* getPlayer();
     Text* getMenu();
 	void toggleAxes();
 	void setPlayerOpacity(const float& opacity);
+	// a frame's share of the trees on the tiles that came into view, one tile at a time
+	void buildTrees();
 	void movePlayerForward(const glm::vec3& view_vec, const glm::vec3& up_vec, const float& units = 1.0f);
 	void movePlayerBack(const glm::vec3& view_vec, const glm::vec3& up_vec, const float& units = 1.0f);
 	void movePlayerLeft(const glm::vec3& view_vec, const glm::vec3& up_vec, const float& units = 1.0f);
@@ -14,6 +14,8 @@
 #include <src/utils.hpp>
 #include <src/constants.hpp>
 #include <src/HitBox2d.hpp>
+#include <src/HitBoxGrid.hpp>
+#include <src/PoissonDisk.hpp>
 
 #include "Entity.hpp"
 #include "DrawableEntity.hpp"
@@ -27,6 +29,10 @@
 #include "WorldTile.hpp"
 #include "Tentacle.hpp"
 
+const WorldTile::Density WorldTile::general_density = {0.25f, 0.25f};
+const WorldTile::Density WorldTile::alien_density = {0.22f, 0.25f};
+const WorldTile::Density WorldTile::tentacle_density = {0.22f, 0.28f};
+const WorldTile::Density WorldTile::forest_density = {0.35f, 0.22f};
 
 WorldTile::WorldTile(
 	const GLuint &shader_program,
@@ -35,8 +41,13 @@ WorldTile::WorldTile(
 	const float& min_hitbox_y,
 	const float& max_hitbox_y,
 	const HitBox2d& player_hitbox,
+	HitBoxGrid& hitbox_grid,
 	Entity *parent
 ) : DrawableEntity(shader_program, parent),
+    arena(TileArena::acquire()),
+    hitbox_grid(hitbox_grid),
+    min_hitbox_y(min_hitbox_y),
+    max_hitbox_y(max_hitbox_y),
     seed_loc_message(
 		    shader_program,
 		    "Seed for current location: " + std::to_string(world_x_location) + ':' + std::to_string(world_z_location),
@@ -63,9 +74,8 @@ WorldTile::WorldTile(
 
 	// initialize random number generator based on world location
 	srand((unsigned int)(world_x_location * world_z_location + world_x_location + world_z_location));
-
-	// TODO: better tree/rock distribution?
-	// TODO: test/remove tree/rock overlaps
+	// where things go comes from the location too, see PoissonDisk
+	const uint32_t placement_seed = utils::hashLocation((float)world_x_location, (float)world_z_location);
 
     const int generalBiomeX = 5, generalBiomeY = 5;
     const int alienBiomeX = 5, alienBiomeY = 10;
@@ -73,68 +83,39 @@ WorldTile::WorldTile(
     const int heavyRenderX = 10, heavyRenderY = 10;
     const int worldBoundries = 10;
 
+    const bool generalBiome = abs(world_x_location) % worldBoundries < generalBiomeX && abs(world_z_location) % worldBoundries < generalBiomeY;
+    const bool alienBiome = !generalBiome && abs(world_x_location) % worldBoundries < alienBiomeX && abs(world_z_location) % worldBoundries < alienBiomeY;
+    const bool tentacleBiome = !generalBiome && !alienBiome && abs(world_x_location) % worldBoundries < tentacleX && abs(world_z_location) % worldBoundries < tentacleY;
+    // anything else is the forest biome (A and C) heavyRenderX heavyRenderY
+    const Density& density = generalBiome ? WorldTile::general_density
+                            : alienBiome ? WorldTile::alien_density
+                            : tentacleBiome ? WorldTile::tentacle_density
+                            : WorldTile::forest_density;
+
+	// world space box around a spot in the tile, big enough for anything placed there
+	static const float max_span = 0.05f;
+	auto spotBox = [&](const glm::vec2& spot) {
+		return HitBox2d(world_x_location + spot.x - max_span / 2, world_z_location + spot.y - max_span / 2, max_span, max_span);
+	};
+
 	// add rocks
-	int rock_tries_left = 3;
-	for (int i = 0; i < 7; i++) {
+	const std::vector<glm::vec2> rock_spots = PoissonDisk::sample(
+		density.rock_spacing,
+		placement_seed,
+		[&](const glm::vec2& spot) { return !player_hitbox.collidesWith(spotBox(spot)); }
+	);
+	for (size_t i = 0; i < rock_spots.size(); i++) {
 		float x_span = utils::randomFloat(0.02f, 0.05f);
 		float z_span = utils::randomFloat(0.02f, 0.05f);
         float y_span = utils::randomFloat(0.005f, 0.015f);
-		float x_position = utils::randomFloat(0.0f, 1.0f - x_span);
-		float z_position = utils::randomFloat(0.0f, 1.0f - z_span);
-
-		HitBox2d box(x_position, z_position, x_position + x_span, z_position + z_span);
-		if (this->collidesWith(box) || player_hitbox.collidesWith(box)) {
-			if (rock_tries_left-- > 0) {
-				// collision! but give it another try
-				i--;
-			}
-			continue;
-		}
-
-        //general biome
-        if (abs(world_x_location) % worldBoundries < generalBiomeX && abs(world_z_location) % worldBoundries < generalBiomeY) {
-            if((int)(ceil(x_position * y_span + world_z_location)) % 2 == 0){
-                // Add rock child
-                RockB* rockB = new RockB(
-                        shader_program,
-                        world_x_location + x_position,
-                        world_z_location + z_position,
-                        x_span,
-                        z_span,
-                        this
-                );
-                rockB->setPosition(glm::vec3(x_position, 0.002f, z_position));
-
-                rockB->scale(glm::vec3(x_span, y_span, z_span));
-                // Add rock to rocks array
-                this->rocksB.emplace_back(rockB);
-                this->hitboxes.emplace_back(*rockB, min_hitbox_y, max_hitbox_y);
-            }
-            else{
-                // Add rock child
-                Rock* rockA = new Rock(
-                        shader_program,
-                        world_x_location + x_position,
-                        world_z_location + z_position,
-                        x_span,
-                        z_span,
-                        this
-                );
-                rockA->setPosition(glm::vec3(x_position, 0.002f, z_position));
-
-                rockA->scale(glm::vec3(x_span, y_span, z_span));
-                // Add rock to rocks array
-                this->rocks.emplace_back(rockA);
-                this->hitboxes.emplace_back(*rockA, min_hitbox_y, max_hitbox_y);
-            }
-        }
-
-
+		float x_position = rock_spots[i].x - x_span / 2;
+		float z_position = rock_spots[i].y - z_span / 2;
 
-            //Alien biome
-        else if (abs(world_x_location) % worldBoundries < alienBiomeX  && abs(world_z_location) % worldBoundries < alienBiomeY ) {
+        // the general biome picks by place, the others have as many of each
+        bool smooth = generalBiome ? (int)(ceil(x_position * y_span + world_z_location)) % 2 == 0 : i % 2 == 0;
+        if (smooth) {
             // Add rock child
-            RockB* rockB = new RockB(
+            RockB* rockB = this->arena->make<RockB>(
                     shader_program,
                     world_x_location + x_position,
                     world_z_location + z_position,
@@ -143,102 +124,13 @@ WorldTile::WorldTile(
                     this
             );
             rockB->setPosition(glm::vec3(x_position, 0.002f, z_position));
-            rockB->scale(glm::vec3(x_span, y_span, z_span));
-            // Add rock to rocks array
-            this->rocksB.emplace_back(rockB);
-            this->hitboxes.emplace_back(*rockB, min_hitbox_y, max_hitbox_y);
 
-
-            float x_span = utils::randomFloat(0.02f, 0.05f);
-            float z_span = utils::randomFloat(0.02f, 0.05f);
-            float y_span = utils::randomFloat(0.005f, 0.015f);
-            float x_position = utils::randomFloat(0.0f, 1.0f - x_span);
-            float z_position = utils::randomFloat(0.0f, 1.0f - z_span);
-            // Add rock child
-            Rock* rockA = new Rock(
-                    shader_program,
-                    world_x_location + x_position,
-                    world_z_location + z_position,
-                    x_span,
-                    z_span,
-                    this
-            );
-            rockA->setPosition(glm::vec3(x_position, 0.002f, z_position));
-            rockA->scale(glm::vec3(x_span, y_span, z_span));
-            // Add rock to rocks array
-            this->rocks.emplace_back(rockA);
-            this->hitboxes.emplace_back(*rockA, min_hitbox_y, max_hitbox_y);
-        }
-
-
-
-            //Tentacle Biome
-        else if(abs(world_x_location) % worldBoundries < tentacleX && abs(world_z_location) % worldBoundries < tentacleY) {
-                // Add rock child
-                RockB* rockB = new RockB(
-                        shader_program,
-                        world_x_location + x_position,
-                        world_z_location + z_position,
-                        x_span,
-                        z_span,
-                        this
-                );
-                rockB->setPosition(glm::vec3(x_position, 0.002f, z_position));
-                rockB->scale(glm::vec3(x_span, y_span, z_span));
-                // Add rock to rocks array
-                this->rocksB.emplace_back(rockB);
-                this->hitboxes.emplace_back(*rockB, min_hitbox_y, max_hitbox_y);
-
-            float x_span = utils::randomFloat(0.02f, 0.05f);
-            float z_span = utils::randomFloat(0.02f, 0.05f);
-            float y_span = utils::randomFloat(0.005f, 0.015f);
-            float x_position = utils::randomFloat(0.0f, 1.0f - x_span);
-            float z_position = utils::randomFloat(0.0f, 1.0f - z_span);
-                // Add rock child
-                Rock* rockA = new Rock(
-                        shader_program,
-                        world_x_location + x_position,
-                        world_z_location + z_position,
-                        x_span,
-                        z_span,
-                        this
-                );
-                rockA->setPosition(glm::vec3(x_position, 0.002f, z_position));
-
-                rockA->scale(glm::vec3(x_span, y_span, z_span));
-                // Add rock to rocks array
-                this->rocks.emplace_back(rockA);
-                this->hitboxes.emplace_back(*rockA, min_hitbox_y, max_hitbox_y);
+            rockB->scale(glm::vec3(x_span, y_span, z_span));
+            this->hitbox_grid.insert(HitBox2d(*rockB, min_hitbox_y, max_hitbox_y), this);
         }
-
-
-
-            //forest biome (A and C) heavyRenderX heavyRenderY
         else{
             // Add rock child
-            RockB* rockB = new RockB(
-                    shader_program,
-                    world_x_location + x_position,
-                    world_z_location + z_position,
-                    x_span,
-                    z_span,
-                    this
-            );
-            rockB->setPosition(glm::vec3(x_position, 0.002f, z_position));
-
-            rockB->scale(glm::vec3(x_span, y_span, z_span));
-            // Add rock to rocks array
-            this->rocksB.emplace_back(rockB);
-            this->hitboxes.emplace_back(*rockB, min_hitbox_y, max_hitbox_y);
-
-            float x_span = utils::randomFloat(0.02f, 0.05f);
-            float z_span = utils::randomFloat(0.02f, 0.05f);
-            float y_span = utils::randomFloat(0.005f, 0.015f);
-            float x_position = utils::randomFloat(0.0f, 1.0f - x_span);
-            float z_position = utils::randomFloat(0.0f, 1.0f - z_span);
-
-            // Add rock child
-            Rock* rockA = new Rock(
+            Rock* rockA = this->arena->make<Rock>(
                     shader_program,
                     world_x_location + x_position,
                     world_z_location + z_position,
@@ -249,33 +141,29 @@ WorldTile::WorldTile(
             rockA->setPosition(glm::vec3(x_position, 0.002f, z_position));
 
             rockA->scale(glm::vec3(x_span, y_span, z_span));
-            // Add rock to rocks array
-            this->rocks.emplace_back(rockA);
-            this->hitboxes.emplace_back(*rockA, min_hitbox_y, max_hitbox_y);
-            break;
-            }
+            this->hitbox_grid.insert(HitBox2d(*rockA, min_hitbox_y, max_hitbox_y), this);
+        }
 	}
 
 
 	//enable tree distributor function
 	//TreeDistributor::setEntity(this);
 	// add trees
-	int tree_tries_left = 2;
-	for (int i = 0; i < 5; i++) {
+	// trees keep clear of the rocks
+	const std::vector<glm::vec2> tree_spots = PoissonDisk::sample(
+		density.tree_spacing,
+		placement_seed ^ 0x9E3779B9u,
+		[&](const glm::vec2& spot) {
+			HitBox2d box = spotBox(spot);
+			return !this->collidesWith(box) && !player_hitbox.collidesWith(box);
+		}
+	);
+	for (const glm::vec2& spot : tree_spots) {
 		static const float scale_factor = 100;
 		float base_span = utils::randomFloat(0.02f, 0.05f);
 		float internal_tree_width = base_span * scale_factor;
-		float x_position = utils::randomFloat(0.0f, 1.0f - base_span);
-		float z_position = utils::randomFloat(0.0f, 1.0f - base_span);
-
-		HitBox2d box(x_position, z_position, x_position + base_span, z_position + base_span);
-		if (this->collidesWith(box) || player_hitbox.collidesWith(box)) {
-			if (tree_tries_left-- > 0) {
-				// collision! but give it another try
-				i--;
-			}
-			continue;
-		}
+		float x_position = spot.x;
+		float z_position = spot.y;
 
 		int seed = std::abs((world_x_location + x_position) * (world_z_location + z_position))*scale_factor;
 		seed = seed == 0 ? (world_x_location + x_position + world_z_location + z_position+3 )* 7: seed;
@@ -285,18 +173,18 @@ WorldTile::WorldTile(
 
 
         //general biome
-        if (abs(world_x_location) % worldBoundries < generalBiomeX && abs(world_z_location) % worldBoundries < generalBiomeY) {
+        if (generalBiome) {
             bool isAlien = false;
             if (seed % worldBoundries < 2) {
                 if (seed % 2 == 0)
-                    tree = new TreeA(shader_program, this, internal_tree_width * 2.5, seed, isAlien);
+                    tree = this->arena->make<TreeA>(shader_program, this, internal_tree_width * 2.5, seed, isAlien);
                 else
-                    tree = new TreeA_Autumn(shader_program, this, internal_tree_width * 2.5, seed);
+                    tree = this->arena->make<TreeA_Autumn>(shader_program, this, internal_tree_width * 2.5, seed);
             } else if (seed % worldBoundries < 7) {
-                tree = new TreeB(shader_program, this, internal_tree_width, seed, isAlien);
+                tree = this->arena->make<TreeB>(shader_program, this, internal_tree_width, seed, isAlien);
             } else {
-                TreeC tc(seed % 15, shader_program, this, internal_tree_width, seed, isAlien, trees,
-                         {x_position, 0.0f, z_position}, 1.0f / (scale_factor*10), min_hitbox_y, max_hitbox_y, hitboxes);
+                TreeC tc(seed % 15, shader_program, this, internal_tree_width, seed, isAlien, this->unbuilt_trees,
+                         *this->arena, this->tree_batch, {x_position, 0.0f, z_position}, 1.0f / (scale_factor*10));
 
                 continue;
             }
@@ -305,15 +193,15 @@ WorldTile::WorldTile(
 
 
             //Alien biome
-        else if (abs(world_x_location) % worldBoundries < alienBiomeX  && abs(world_z_location) % worldBoundries < alienBiomeY ) {
+        else if (alienBiome) {
             bool isAlien = true;
             if (seed % worldBoundries < 2) {
-                    tree = new TreeA(shader_program, this, internal_tree_width * 2.5, seed, isAlien);
+                    tree = this->arena->make<TreeA>(shader_program, this, internal_tree_width * 2.5, seed, isAlien);
             } else if (seed % worldBoundries < 7) {
-                tree = new TreeB(shader_program, this, internal_tree_width, seed, isAlien);
+                tree = this->arena->make<TreeB>(shader_program, this, internal_tree_width, seed, isAlien);
             } else {
-                TreeC tc(seed % 15, shader_program, this, internal_tree_width, seed, isAlien, trees,
-                         {x_position, 0.0f, z_position}, 1.0f / (scale_factor*10), min_hitbox_y, max_hitbox_y, hitboxes);
+                TreeC tc(seed % 15, shader_program, this, internal_tree_width, seed, isAlien, this->unbuilt_trees,
+                         *this->arena, this->tree_batch, {x_position, 0.0f, z_position}, 1.0f / (scale_factor*10));
 
                 continue;
             }
@@ -322,7 +210,7 @@ WorldTile::WorldTile(
 
 
             //Tentacle Biome
-        else if(abs(world_x_location) % worldBoundries < tentacleX && abs(world_z_location) % worldBoundries < tentacleY) {
+        else if (tentacleBiome) {
             bool isAlien, isTextured;
             if(seed % 3 == 0) {
                 isAlien = false, isTextured = true;
@@ -332,7 +220,7 @@ WorldTile::WorldTile(
             else
                 isAlien = true, isTextured = false;
 
-            tree =  new Tentacle(shader_program, this, internal_tree_width * 2.5, seed, isAlien, isTextured);
+            tree =  this->arena->make<Tentacle>(shader_program, this, internal_tree_width * 2.5, seed, isAlien, isTextured);
         }
 
 
@@ -342,40 +230,62 @@ WorldTile::WorldTile(
             bool isAlien = false;
             if (seed % 10 < 7) {
                 if (seed % 2 == 0)
-                    tree = new TreeA(shader_program, this, internal_tree_width * 3, seed, isAlien);
+                    tree = this->arena->make<TreeA>(shader_program, this, internal_tree_width * 3, seed, isAlien);
                 else
-                    tree = new TreeA_Autumn(shader_program, this, internal_tree_width * 3, seed);
+                    tree = this->arena->make<TreeA_Autumn>(shader_program, this, internal_tree_width * 3, seed);
             } else {
 
-                TreeC::setSpacingConstant(10);
-                TreeC tc(0, shader_program, this, internal_tree_width * 1.5, seed, isAlien, trees,
-                         {x_position, 0.0f, z_position}, 1.0f / (scale_factor*10), min_hitbox_y, max_hitbox_y, hitboxes);
-                TreeC::setSpacingConstant(10);
+                TreeC tc(0, shader_program, this, internal_tree_width * 1.5, seed, isAlien, this->unbuilt_trees,
+                         *this->arena, this->tree_batch, {x_position, 0.0f, z_position}, 1.0f / (scale_factor*10), 10);
                 continue;
             }
         }
 
 		tree->setPosition(glm::vec3(x_position, 0.0f, z_position));
 		tree->scale(1.0f / (scale_factor*10));
-		// Add tree to trees array
-		this->trees.emplace_back(tree);
-		this->hitboxes.emplace_back(*tree, min_hitbox_y, max_hitbox_y);
+		this->hitbox_grid.insert(HitBox2d(*tree, min_hitbox_y, max_hitbox_y), this);
 
 	}
+	// the clusters' trees the prototype cache already had
+	this->insertBuiltTreeHitboxes();
 }
 
 WorldTile::~WorldTile()
 {
-	for (Rock* const& rock : this->rocks) {
-		delete rock;
-	}
-	for (Tree* const& tree : this->trees) {
-		delete tree;
-	}
+	this->hitbox_grid.remove(this);
+	// every rock and tree at once, the arena goes to the next tile
+	TileArena::release(this->arena);
+}
 
-    for (RockB* const& rock : this->rocksB) {
-        delete rock;
-    }
+bool WorldTile::hasUnbuiltTrees() const
+{
+	return !this->unbuilt_trees.empty();
+}
+
+void WorldTile::buildTrees(const size_t& vertex_budget)
+{
+	this->tree_batch.buildSome(vertex_budget);
+	this->insertBuiltTreeHitboxes();
+}
+
+void WorldTile::finishTrees()
+{
+	this->tree_batch.build();
+	this->insertBuiltTreeHitboxes();
+}
+
+void WorldTile::insertBuiltTreeHitboxes()
+{
+	// hit boxes come from the meshes, the trees still waiting for theirs stay in the list
+	std::vector<Tree*>::iterator unbuilt = this->unbuilt_trees.begin();
+	for (Tree* const& tree : this->unbuilt_trees) {
+		if (tree->getPrototype()) {
+			this->hitbox_grid.insert(HitBox2d(*tree, this->min_hitbox_y, this->max_hitbox_y), this);
+		} else {
+			*unbuilt++ = tree;
+		}
+	}
+	this->unbuilt_trees.erase(unbuilt, this->unbuilt_trees.end());
 }
 
 const std::vector<glm::vec3>& WorldTile::getVertices() const
@@ -433,10 +343,5 @@ const int WorldTile::getColorType() {
 // does NOT test if the box exists at all in the tile space.
 bool WorldTile::collidesWith(const HitBox2d &box) const
 {
-	for (const HitBox2d& hb : this->hitboxes) {
-		if (hb.collidesWith(box)) {
-			return true;
-		}
-	}
-	return false;
+	return this->hitbox_grid.collidesWith(box, this);
 }
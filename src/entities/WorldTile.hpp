@@ -12,6 +12,7 @@
 #include <vector>
 
 #include <src/HitBox2d.hpp>
+#include <src/HitBoxGrid.hpp>
 
 #include "Entity.hpp"
 #include "Rock.hpp"
@@ -20,14 +21,34 @@
 #include "Rock.hpp"
 #include "RockB.hpp"
 #include "Text.hpp"
+#include "TileArena.hpp"
+#include "Trees/TreeBuildBatch.hpp"
 
 class WorldTile: public DrawableEntity {
 private:
-	std::vector<Rock*> rocks;
-    std::vector<RockB*> rocksB;
-	std::vector<Tree*> trees;
-	std::vector<HitBox2d> hitboxes;
+	// least distance between the rocks and between the trees of a biome, in tiles. about
+	// 0.5 / spacing^2 of each fit on a tile
+	struct Density {
+		float rock_spacing;
+		float tree_spacing;
+	};
+	static const Density general_density;
+	static const Density alien_density;
+	static const Density tentacle_density;
+	static const Density forest_density;
+
+	// the rocks and trees, all of them go with the tile
+	TileArena* arena;
+	// the world's, holds this tile's hit boxes while it's alive
+	HitBoxGrid& hitbox_grid;
+	float min_hitbox_y;
+	float max_hitbox_y;
+	// the tree clusters' trees are generated over several frames, see buildTrees
+	TreeBuildBatch tree_batch;
+	// the ones without a mesh yet, they have no hit box until they get one
+	std::vector<Tree*> unbuilt_trees;
     Text seed_loc_message;
+	void insertBuiltTreeHitboxes();
 public:
 	WorldTile(
 		const GLuint& shader_program,
@@ -35,7 +56,8 @@ public:
 		const int& world_z_location,
 		const float& min_hitbox_y,
 		const float& max_hitbox_y,
-		const HitBox2d& player_hitbox
+		const HitBox2d& player_hitbox,
+		HitBoxGrid& hitbox_grid
     ) : WorldTile(
 		shader_program,
 		world_x_location,
@@ -43,6 +65,7 @@ public:
 		min_hitbox_y,
 		max_hitbox_y,
 		player_hitbox,
+		hitbox_grid,
 		nullptr
 	) {}
 	WorldTile(
@@ -52,6 +75,7 @@ public:
 		const float& min_hitbox_y,
 		const float& max_hitbox_y,
 		const HitBox2d& player_hitbox,
+		HitBoxGrid& hitbox_grid,
 		Entity* parent
 	);
 	~WorldTile() override;
@@ -59,6 +83,12 @@ public:
 	GLuint getVAO() override;
 	const int getColorType() override;
 	bool collidesWith(const HitBox2d& box) const;
+	bool hasUnbuiltTrees() const;
+	// generates the tree clusters' trees for about vertex_budget vertices, each one goes in the
+	// hit box grid once it has its mesh
+	void buildTrees(const size_t& vertex_budget);
+	// generates the rest of them at once
+	void finishTrees();
 };
 
 #endif //PROCEDURALWORLD_WORLDTILE_H
@@ -0,0 +1,408 @@
+#ifndef PROCEDURALWORLD_BRANCHINGTREE_HPP
+#define PROCEDURALWORLD_BRANCHINGTREE_HPP
+
+#define START_TRUNK 0
+#define TRUNK 2
+#define LEAF 3
+#define END_TRUNK -1
+#define FLIP_FLOW 4
+#define START_MOVE 5
+#define MOVE_SEGMENT 6
+
+#ifdef __APPLE__
+#include <OpenGL/OpenGL.h>
+#include <OpenGL/OpenGL.h>
+#else
+#include <GL/glew.h> // include GL Extension Wrangler
+#endif
+
+#include <glm/glm.hpp>
+#include <cmath>
+
+#include "src/TreeRandom.hpp"
+#include "TrunkAB.hpp"
+#include "LeafContainerAB.hpp"
+#include "Tree.hpp"
+#include "TreeParams.hpp"
+
+//the trunk/branch/leaf generator shared by TreeA, TreeB and Tentacle, see the documentation
+//in TreeA.hpp. everything that differs between them is a constant in Params, so each species
+//gets its own copy of the generator with those folded in. it runs off Tree::growthStack,
+//generate and moveSegment queue the segments they lead to instead of recursing into them
+template<class Params>
+class BranchingTree : public Tree {
+protected:
+    static constexpr int branches = Params::branches;
+    static constexpr int k = Params::k;
+    static constexpr int previousRotationCap = Params::previousRotationCap;
+
+    static constexpr float boostFactor = Params::boostFactor;
+    static constexpr int heightChunking = Params::heightChunking;//INVERSE
+
+    static constexpr int minYBranchAngle = Params::minYBranchAngle;
+    static constexpr int maxYBranchAngle = Params::maxYBranchAngle;
+    static constexpr int minYTrunkAngle = Params::minYTrunkAngle;
+    static constexpr int maxYTrunkAngle = Params::maxYTrunkAngle;
+
+    static constexpr double trunkRatio = Params::trunkRatio;
+    static constexpr double branchRatio = Params::branchRatio;
+
+    float limiter = 1;
+
+    BranchingTree(const GLuint& shader_program, Entity* entity, float seed, const char& type):
+            Tree(heightChunking, boostFactor, seed, shader_program, entity, type){
+        widthCut = Params::widthCut;
+        finalCut = widthCut;
+    }
+
+    void generate(const int& _case, float trunkDiameter, const float& seed,
+                  float angleX, float angleY, float angleZ,
+                  char tag, AttatchmentGroupings* ag, float lineHeight);
+
+    float trunk(float trunkDiameter, const float& seed, float lineHeight);
+    void leafBranch(float trunkDiameter, const float& seed, float lineHeight);
+
+    size_t initiateMove(AttatchmentGroupings* ag);
+    //moves ag's child m onto the end of ag and queues the child's own children
+    size_t moveSegment(const int& previousRotation, AttatchmentGroupings* ag, const int& m);
+
+    size_t growTask(const GrowthTask& task) override;
+
+    MeshEstimate estimateMesh(const float& trunkDiameter) const override {
+        const size_t vertices = (size_t)(Params::vertexScale * std::pow(trunkDiameter, Params::vertexExponent));
+        return {vertices, (size_t)(vertices * Params::indicesPerVertex), (size_t)(vertices * Params::leavesPerVertex)};
+    }
+
+    void flipConstructionFlow(){
+        buildContext.constructionFlowCounter = !buildContext.constructionFlowCounter;
+    }
+
+    void queueFlip(){
+        pushTask(FLIP_FLOW, 0, 0, 0, 0, 0, 0, nullptr, 0);
+    }
+};
+
+template<class Params> constexpr int BranchingTree<Params>::branches;
+template<class Params> constexpr int BranchingTree<Params>::k;
+template<class Params> constexpr int BranchingTree<Params>::previousRotationCap;
+template<class Params> constexpr float BranchingTree<Params>::boostFactor;
+template<class Params> constexpr int BranchingTree<Params>::heightChunking;
+template<class Params> constexpr int BranchingTree<Params>::minYBranchAngle;
+template<class Params> constexpr int BranchingTree<Params>::maxYBranchAngle;
+template<class Params> constexpr int BranchingTree<Params>::minYTrunkAngle;
+template<class Params> constexpr int BranchingTree<Params>::maxYTrunkAngle;
+template<class Params> constexpr double BranchingTree<Params>::trunkRatio;
+template<class Params> constexpr double BranchingTree<Params>::branchRatio;
+
+template<class Params>
+size_t BranchingTree<Params>::growTask(const GrowthTask& task) {
+    const size_t before = combinedVertices.size();
+    switch (task._case)
+    {
+        case FLIP_FLOW:
+            flipConstructionFlow();
+            return 0;
+        case START_MOVE:
+            return initiateMove(task.ag);
+        case MOVE_SEGMENT:
+            return moveSegment(task.previousRotation, task.ag, task.branch);
+        default:
+            generate(task._case, task.trunkDiameter, task.seed, task.angleX, task.angleY, task.angleZ,
+                     task.tag, task.ag, task.lineHeight);
+            return combinedVertices.size() - before;
+    }
+}
+
+template<class Params>
+void BranchingTree<Params>::generate(const int& _case, float trunkDiameter, const float& seed,
+                                     float angleX, float angleY, float angleZ, char tag,
+                                     AttatchmentGroupings* ag, float lineHeight) {
+    int currentLineLength = lineHeight;
+    float ShootDiameterBranch = 0;
+    float ShootDiameterTrunk = 0;
+    bool split;
+    AttatchmentGroupings* agNew;
+    switch (_case)
+    {
+        case START_TRUNK:
+            //1A. Standard trunk with two branches
+            //1A1. Draw circle with seed based ragedness and store in trunkV and trunkC
+            //1A2. Draw circle up one with seed based ragedness and store in trunkV and trunkC
+            //1A3. Draw circle up one with seed based ragedness and store in trunkV and trunkC and create trunkI
+            //1A4. Make branch check
+            currentLineLength = trunk(trunkDiameter, seed, currentLineLength);
+
+            combinedStartIndices.push_back({ (int)combinedVertices.size() - 1, (int)angleX, (int)angleY, (int)angleZ});
+
+            agNew = branchArena.make(combinedStartIndices.at((int)combinedStartIndices.size() - 2).vertex,
+                                     (int)combinedVertices.size() - 1,		//TYPE //SIDE
+                                     (int)angleX, (int)angleY, (int)angleZ, 'B', 'C');
+
+            //1A5. Start N new recursive functions from seed based angle at a certain base position
+            ShootDiameterBranch = shootCalculation(trunkDiameter, branchRatio, branches);
+            ShootDiameterTrunk = shootCalculation(trunkDiameter, trunkRatio, branches);
+
+            //queued last first: the branches run, then the trunk, then everything is moved into place
+            pushMove(START_MOVE, agNew, 0, 0);
+
+            //1A6. On new branch create junction and new shoot
+            angleY = TreeRandom::treeOddEvenRandom(trunkDiameter, seed* ( 1) * 3, (lineHeight+1)* ( 1));
+            if (Params::continueTrunk) {
+                //1A7. On new trunk join to junction and continue
+                angleZ = TreeRandom::trunkAngleFromRandom(trunkDiameter, seed* 71, currentLineLength, maxYTrunkAngle, minYTrunkAngle) ;
+                angleX = TreeRandom::trunkAngleFromRandom(trunkDiameter, seed * 9, currentLineLength, maxYTrunkAngle, minYTrunkAngle); //* (((int)seed) % 2 == 0 ? 1 : -1);
+                queueFlip();
+                pushTask(TRUNK, ShootDiameterTrunk, seed, std::abs(angleX), angleY, -std::abs(angleZ), 'L', agNew, currentLineLength);
+                queueFlip();
+            }
+            for (int n = branches - 1; n >= 0; n--) {
+                angleZ = TreeRandom::branchAngleFromRandom(trunkDiameter, seed * (n+1), currentLineLength* (n + 1), maxYBranchAngle, minYBranchAngle);
+                angleX = TreeRandom::branchAngleFromRandom(trunkDiameter, seed* (n + 1) * 7, currentLineLength* (n + 1), maxYBranchAngle, minYBranchAngle); //* (((int)seed) % 2 == 0 ? -1 : 1);
+                if (Params::flipAroundBranches) queueFlip();
+                pushTask(TRUNK, ShootDiameterBranch / (branches), seed, -std::abs(angleX), angleY, std::abs(angleZ), 'R', agNew, 0);
+                if (Params::flipAroundBranches) queueFlip();
+            }
+            break;
+        case TRUNK:
+            if (trunkDiameter < widthCut) {
+                //a leaf ends its branch, so it's built right away instead of queued
+                generate(LEAF, trunkDiameter, seed, angleX, angleY, angleZ, tag, ag, 0);
+                if (trunkDiameter < finalCut) {
+                    return;
+                }
+            }
+            else{
+                currentLineLength = trunk(trunkDiameter, seed, lineHeight);
+            }
+
+            //rotate based on the previous and current angles
+            angleX += ag->angleX;
+            angleZ += ag->angleZ;
+
+            //add the sum of angles onto the current branch
+            combinedStartIndices.push_back({ (int)combinedVertices.size() - 1, (int)angleX, (int)angleY, (int)angleZ });
+
+            //store current branch poosition and rotation sum at depth
+            agNew = branchArena.make(combinedStartIndices.at((int)combinedStartIndices.size() - 2).vertex,
+                                     (int)combinedVertices.size() - 1, (int)angleX, (int)angleY, (int)angleZ, 'B', tag);
+            if (tag == 'R') ag->ag[1] = agNew;
+            else			ag->ag[0] = agNew;
+
+            //1A5. Start N new shoots from seed based angle at a certain base position, queued last first
+            angleY = TreeRandom::treeOddEvenRandom(trunkDiameter, seed * 5, lineHeight);
+            split = lineHeight == -1 || currentLineLength == -1;
+            if (split) {
+                ShootDiameterTrunk = shootCalculation(trunkDiameter, trunkRatio, branches);
+                currentLineLength = 0;
+            }
+            else{
+                ShootDiameterBranch = shootCalculation(trunkDiameter, branchRatio, branches);
+                ShootDiameterTrunk = shootCalculation(trunkDiameter, trunkRatio, branches);
+            }
+
+            if (Params::continueTrunk) {
+                //1A7. On new trunk create circle then indices flowing back once to top circle.
+                angleZ = TreeRandom::trunkAngleFromRandom(trunkDiameter, seed, currentLineLength, minYTrunkAngle, maxYTrunkAngle);
+                angleX = TreeRandom::trunkAngleFromRandom(trunkDiameter, seed * 7, currentLineLength, minYTrunkAngle, maxYTrunkAngle) * (((int)seed) % 2 == 0 ? -1 : 1);
+                queueFlip();
+                pushTask(TRUNK, ShootDiameterTrunk, seed, std::abs(angleX), angleY, -std::abs(angleZ), 'L', agNew, currentLineLength);
+                queueFlip();
+            }
+
+            if (!split) {
+                for (int n = 0; n < branches; n++) {
+                    //1A6. On new branch create circle then indices flowing back once to center cirlce.
+                    angleZ = TreeRandom::branchAngleFromRandom(trunkDiameter, seed, currentLineLength, maxYBranchAngle, minYBranchAngle);
+                    angleX = TreeRandom::branchAngleFromRandom(trunkDiameter, seed * 7, currentLineLength, maxYBranchAngle, minYBranchAngle) * (((int)seed) % 2 == 0 ? -1 : 1);
+                    if (Params::flipAroundBranches) queueFlip();
+                    pushTask(TRUNK, ShootDiameterBranch, seed, -std::abs(angleX), angleY, std::abs(angleZ), 'R', agNew, 0);
+                    if (Params::flipAroundBranches) queueFlip();
+                }
+            }
+            break;
+        case LEAF:
+            //1B. If trunk width is past a threshold then create a leaf line
+            //1B1.On circle put 4 oval leaves with ragedness at each 90 degrees   and store in trunkV and trunkC  and store in leafV and leafC and create leafI
+            //1B2.On circle up one put 4 oval leaves with ragedness at each 90 degrees   and store in trunkV and trunkC and create trunkI  and store in leafV and leafC and create leafI
+            //1B3. Repeat until max length
+            leafBranch(trunkDiameter, seed, lineHeight);
+
+            //rotate my combined of predesecors
+            //rotate based on the previous and current angles
+            angleX += ag->angleX;
+            angleZ += ag->angleZ;
+
+            //and add to leaf index with combined
+            combinedStartIndices.push_back({ (int)combinedVertices.size() - 1,(int)angleX,(int)angleY,(int)angleZ });
+
+            //add to grouping at depth
+            agNew = branchArena.make(combinedStartIndices.at((int)combinedStartIndices.size() - 2).vertex,
+                                     (int)combinedVertices.size() - 1,
+                                     (int)angleX, (int)angleY, (int)angleZ, 'L', tag);
+            if (tag == 'R') ag->ag[1] = agNew;
+            else			ag->ag[0] = agNew;
+            //2. Translate and rotate into given location
+            //get branch end, get leaf segment start get leaf segment end
+
+            generate(END_TRUNK, trunkDiameter, seed, angleX, angleY, angleZ, tag, ag, lineHeight);
+            break;
+        default:
+            return; break;
+    }
+    //AFTER FUNCTION INSIDE CONSTRUCTOR
+    //3. Merge Trunk V with Leaf V into combined V
+    //4. Generate rendering properties.
+}
+
+template<class Params>
+float BranchingTree<Params>::trunk(float trunkDiameter, const float& seed, float lineHeight) {
+    const int lineMax = lineMAX(trunkDiameter, k);
+    bool loopInitialTrunk;
+    const float lineSegments = ((float)lineMax) / heightChunking;
+    TrunkAB trunk(&combinedVertices, &combinedUV,
+                  seed, &buildContext
+    );
+    do {
+        loopInitialTrunk = trunk.buildTrunk(trunkDiameter, lineSegments);
+        if (Params::flipEachTrunkRing) flipConstructionFlow();
+    } while (loopInitialTrunk && trunk.getLineHeight() < lineMax);
+    if (Params::flipAfterTrunk) flipConstructionFlow();
+    if (lineHeight >= lineMax)
+        return -1;
+    else if(!loopInitialTrunk)
+        return lineHeight;
+    else return -1;
+}
+
+template<class Params>
+void BranchingTree<Params>::leafBranch(float trunkDiameter, const float& seed, float lineHeight) {
+    const int lineMax = lineMAX(trunkDiameter, k);
+    LeafContainerAB lc(&combinedVertices,
+                       &combinedIndices,
+                       &combinedUV,
+                       &combinedLeaves,
+                       seed, &buildContext);
+    //a leaf container is an object that holds a set of leaves and a branch that they're held on
+    if (Params::flipAroundLeaves) flipConstructionFlow();
+    lc.buildContainer(trunkDiameter, seed, lineHeight, lineMax);
+    if (Params::flipAroundLeaves) flipConstructionFlow();
+}
+
+//atatchment grouping -> See Tree.hpp
+template<class Params>
+size_t BranchingTree<Params>::initiateMove(AttatchmentGroupings* ag){
+    const int circularPoints = TrunkAB::trunkPoints;
+    int rotationPoint = std::abs((ag->angleY) % (int)(circularPoints / limiter ));
+
+    //limit rotations to one segment at a time
+    if (Params::shrubMove) rotationPoint = rotationPoint == 0 ? 1 : 0;
+    else                   rotationPoint = rotationPoint == 0 ? 0 : 1;
+
+    const float r = 360.0f/circularPoints  * (rotationPoint);
+    const int start = ag->start + 1;
+    const int max = ag->end + 1;
+    transformSegment(makeRotations(glm::radians((float)ag->angleX), glm::radians(r), glm::radians((float)ag->angleZ)),
+                     glm::vec3(0.0f), start, max);
+    const int previousRotation = rotationPoint;
+    //create elements for segment
+    computeElementsInitial(ag);
+    pushMove(MOVE_SEGMENT, ag, 1, previousRotation);
+    pushMove(MOVE_SEGMENT, ag, 0, previousRotation);
+    return max - start;
+}
+
+/*
+ *
+ * 1_______2
+ *  |     |
+ *  |     |
+ *  |_____|
+ * 0       3
+ *
+ * This figure rotates and needs to connect with a lower square.
+ *
+ * eg.
+ *  0______1
+ *  |     |
+ *  |     |
+ *  |_____|
+ * 3       2
+ *
+ * The methods below do this procedure and pass on rotation information to the move connect, compute and queue
+ * the children's moves, depth first, until the furthest branch has been reached.
+ *
+ */
+template<class Params>
+size_t BranchingTree<Params>::moveSegment(const int& previousRotation, AttatchmentGroupings* ag, const int& m) {
+    if (ag->ag[m] == nullptr) return 0;
+    int moveTo = 0;
+    int moveFrom = 0;
+
+    if (!Params::shrubMove) {
+        if(previousRotation < previousRotationCap) limiter = 1;
+        else if(previousRotation >= previousRotationCap) limiter = 0.01;
+    }
+
+    const int circularPoints = ag->ag[m]->type == 'L' ? LeafContainerAB::leafBranchPoints : TrunkAB::trunkPoints;
+    int rotationPoint = std::abs((ag->ag[m]->angleY) % (int)(circularPoints / limiter ));
+
+    int toPnt, fromPnt;
+    float r;
+    if (Params::shrubMove) {
+        //shrub like, large twists
+        if(previousRotation == 0) rotationPoint = 1;
+        rotationPoint = rotationPoint < 1 ? 0 : 1;
+
+        fromPnt = (circularPoints-rotationPoint + (previousRotation));
+        toPnt = (previousRotation);
+
+        if (ag->ag[m]->side == 'L') {
+            moveTo = (ag->end - circularPoints + 1) + (( 2 + toPnt) % circularPoints);
+            moveFrom = (ag->ag[m]->start + 1)  + ((2 + fromPnt) % circularPoints);
+        }
+        else {
+            moveTo = (ag->end - circularPoints + 1) + (int)(0 + toPnt ) % circularPoints;
+            moveFrom = (ag->ag[m]->start + 1) + (int)(0  + fromPnt) % circularPoints;
+        }
+        r = 360.0/circularPoints  * (fromPnt);
+    }
+    else {
+        rotationPoint = rotationPoint < 1 ? 1 : 0;
+
+        toPnt = (circularPoints-rotationPoint + (previousRotation));
+        fromPnt = (previousRotation);
+
+        if (ag->ag[m]->side == 'L') {
+            moveTo = (ag->end - circularPoints + 1) + (( 0 + toPnt) % circularPoints);
+            moveFrom = (ag->ag[m]->start + 1)  + ((0 + fromPnt) % circularPoints);
+        }
+        else {
+            moveTo = (ag->end - circularPoints + 1) + (int)(circularPoints/2.0 + toPnt ) % circularPoints;
+            moveFrom = (ag->ag[m]->start + 1) + (int)(circularPoints/2.0  + fromPnt) % circularPoints;
+        }
+        r = 360.0f/circularPoints  * (toPnt);
+    }
+
+    const int start = ag->ag[m]->start + 1;
+    const int max = ag->ag[m]->end + 1;
+
+    const glm::mat3 rotation = makeRotations(glm::radians((float)ag->ag[m]->angleX), glm::radians(r),
+                                             glm::radians((float)ag->ag[m]->angleZ));
+
+    //translate components onto branch(destination - position)
+    const glm::vec3 translation = combinedVertices.at(moveTo) - rotateVertex(rotation, combinedVertices.at(moveFrom));
+    //elevate from point
+    const glm::vec3 boost = boostSegment(ag, ag->ag[m], rotation, &combinedVertices) *  (float)(heightChunking * boostFactor);
+    transformSegment(rotation, translation + boost, start, max);
+    //create the connector's elements from previous to m
+    if (Params::shrubMove) connectSegments(ag, m, toPnt + 1, fromPnt, circularPoints + 1, &combinedIndices);
+    else                   connectSegments(ag, m, toPnt, fromPnt, circularPoints, &combinedIndices);
+    //create elements for segment
+    computeElementsInitial(ag->ag[m]);
+    //move them to position
+    pushMove(MOVE_SEGMENT, ag->ag[m], 1, toPnt);
+    pushMove(MOVE_SEGMENT, ag->ag[m], 0, toPnt);
+    return max - start;
+}
+
+#endif //PROCEDURALWORLD_BRANCHINGTREE_HPP
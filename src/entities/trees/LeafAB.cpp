@@ -3,129 +3,83 @@
 
 //builds 2
 void LeafAB::buildLeaf(const float& r1, const float& r2, const float& leafDiameter,
-                       const float& lineHeight, const int& count, float leafTextureStart){
+                       const float& lineHeight, const int& count){
+    //the cap from buildLeafSingle sits on the last pair of leaves
+    this->lineHeight = lineHeight;
     //place leaves parralel following angle
-    //place approproate leaves parralel following angle
-    for(int side = 0 ; side < 2 ; side++){
-        for (int n = 0; n < leafPoints; n++) {
-            //if even create a leaf with constant Z
-            if (count % 2 == 0)
-                leafVertices->push_back(
-                        glm::vec3(
-                                r2 * cos(glm::radians(itterations  * n)) + leafDiameter + r2 ,
-                                lineHeight + r1 *  sin(glm::radians(itterations  * n)) ,
-                                ((float)side) / 10.0f));
-                //else constant X
-            else
-                leafVertices->push_back(
-                        glm::vec3(
-                                ((float)side) / 10.0f,
-                                lineHeight + r1 *  sin(glm::radians(itterations  * n)) + 0,
-                                r2 * cos(glm::radians(itterations  * n)) + leafDiameter / 2.0 + r2));
-        }
-        unsigned  long s = leafVertices->size();
-        leafUVs->resize(s);
-        leafUVs->at(s - 1 - 3) = {1.0, 0 + (1 - leafTextureStart) * 0.5f};
-        leafUVs->at(s - 1 - 2) = {0.5, 1 - leafTextureStart};
-        leafUVs->at(s - 1 - 1) = {0,  (1 - leafTextureStart) * 0.5f};
-        leafUVs->at(s - 1 - 0) = {0.5, 0};
+    //if even the leaves face z, else x
+    if (count % 2 == 0) {
+        addLeaf(glm::vec3(r2, 0, 0), glm::vec3(0, r1, 0), glm::vec3(0, 0, 1),
+                glm::vec3(leafDiameter + r2, lineHeight, 0));
+        addLeaf(glm::vec3(-r2, 0, 0), glm::vec3(0, r1, 0), glm::vec3(0, 0, 1),
+                glm::vec3(-leafDiameter / 2.0 - r2, lineHeight, 0));
     }
-    for(int side = 0 ; side < 2 ; side++) {
-        for (int n = 0; n < leafPoints; n++) {
-            if (count % 2 == 0)
-                leafVertices->push_back(
-                        glm::vec3(
-                                -r2 * cos(glm::radians(itterations * n)) - leafDiameter / 2.0 - r2,
-                                lineHeight + r1 * sin(glm::radians(itterations * n)),
-                                ((float)side) / 10.0f));
-            else
-                leafVertices->push_back(
-                        glm::vec3(
-                                ((float)side) / 10.0f,
-                                lineHeight + r1 * sin(glm::radians(itterations * n)) + 0,
-                                -r2 * cos(glm::radians(itterations * n)) - leafDiameter / 2.0 - r2));
-
-        }
-        unsigned  long s = leafVertices->size();
-        s = leafVertices->size();
-        leafUVs->resize(s);
-        leafUVs->at(s - 1 - 3) = {1.0, 0 + (1 - leafTextureStart) * 0.5f};
-        leafUVs->at(s - 1 - 2) = {0.5, 1 - leafTextureStart};
-        leafUVs->at(s - 1 - 1) = {0, (1 - leafTextureStart) * 0.5f};
-        leafUVs->at(s - 1 - 0) = {0.5, 0};
+    else {
+        addLeaf(glm::vec3(0, 0, r2), glm::vec3(0, r1, 0), glm::vec3(1, 0, 0),
+                glm::vec3(0, lineHeight, leafDiameter / 2.0 + r2));
+        addLeaf(glm::vec3(0, 0, -r2), glm::vec3(0, r1, 0), glm::vec3(1, 0, 0),
+                glm::vec3(0, lineHeight, -leafDiameter / 2.0 - r2));
     }
 }
 
-void LeafAB::buildLeafSingle(const float&  r1, const float&  r2, const float&  trunkDiameter, int y, float leafTextureStart) {
-    for(int side = 0 ; side < 2 ; side++) {
-        for (int n = 0; n < leafPoints; n++) {
-            int sign = -1;
-            int jagednessRandom = this->randomSeedValue * (((int) (n * 13.4) % 17) + 1);
-            if (jagednessRandom % 2 == 0) sign *= -1;
-            float tempTrunkDiameter = trunkDiameter +
-                                      sign * (jagednessRandom) % ((int) (ceil(trunkDiameter))) * jagednessFactor_Leaf /
-                                      (trunkDiameter);
-            leafVertices->push_back(glm::vec3(r1 * sin(glm::radians(itterations * n)),
-                                              r2 * cos(glm::radians(itterations * n)) + lineHeight + r2,
-                                              ((float)side) / 10.0f));
-        }
-        unsigned long s = leafVertices->size();
-        leafUVs->resize(s);
-        leafUVs->at(s - 1 - 3) = {1.0, 0 + (1 - leafTextureStart) * 0.5f};
-        leafUVs->at(s - 1 - 2) = {0.5, 1 - leafTextureStart};
-        leafUVs->at(s - 1 - 1) = {0, (1 - leafTextureStart) * 0.5f};
-        leafUVs->at(s - 1 - 0) = {0.5, 0};
-    }
+void LeafAB::buildLeafSingle(const float&  r1, const float&  r2) {
+    //upright, on top of the branch
+    addLeaf(glm::vec3(0, r2, 0), glm::vec3(r1, 0, 0), glm::vec3(0, 0, 1),
+            glm::vec3(0, lineHeight + r2, 0));
 }
 
-GLuint LeafAB::buildElements(int i, const int& start, const int& leafPoints,
-                         std::vector<GLuint>* leafIndices, std::vector<glm::vec3>* leafVert,
-                         std::vector<glm::vec2>* leafUVs, std::vector<glm::vec3>* leafNorms){
-    glm::vec3 leafNormal = (glm::cross(
-            leafVert->at(i + 2+ start) - leafVert->at(i+1 + start),
-            leafVert->at(i +3+ start) - leafVert->at(i+1 + start)
-    ));
+void LeafAB::addLeaf(const glm::vec3& axisU, const glm::vec3& axisV, const glm::vec3& facing, const glm::vec3& centre){
+    LeafInstance leaf;
+    leaf.placement = glm::mat4x3(axisU, axisV, facing, centre);
+    leaf.anchor = (int)branchVertices->size() - 1;
+    leaves->push_back(leaf);
+}
 
-    if(leafVert->size() != leafNorms->size()){
-        leafUVs->resize(leafVert->size());
-        leafNorms->resize(leafVert->size());
+void LeafAB::buildMesh(std::vector<glm::vec3>* vertices, std::vector<glm::vec3>* normals,
+                       std::vector<glm::vec2>* uvs, std::vector<GLuint>* indices, const float& leafTextureStart){
+    const int leafPoints = 4;
+    const float itterations = 360.0f / leafPoints;
+    for(int side = 0 ; side < 2 ; side++){
+        for (int n = 0; n < leafPoints; n++) {
+            vertices->push_back(glm::vec3(cos(glm::radians(itterations  * n)),
+                                          sin(glm::radians(itterations  * n)),
+                                          ((float)side) / 10.0f));
+            normals->push_back(glm::vec3(0, 0, side == 0 ? 1 : -1));
+        }
+        uvs->push_back({1.0, 0 + (1 - leafTextureStart) * 0.5f});
+        uvs->push_back({0.5, 1 - leafTextureStart});
+        uvs->push_back({0,  (1 - leafTextureStart) * 0.5f});
+        uvs->push_back({0.5, 0});
     }
     //NORTH ON ONE SIDE
-    leafIndices->push_back(i + 0 + start);
-    leafIndices->push_back(i + 1+ start);
-    leafIndices->push_back(i + 2+ start);
-    leafIndices->push_back(i + 2+ start);
-    leafIndices->push_back(i + 3+ start);
-    leafIndices->push_back(i +  0 + start);
+    const GLuint north[6] = {0, 1, 2, 2, 3, 0};
     //SOUTH ON THE OTHER
-    leafIndices->push_back(i + 4 + start);
-    leafIndices->push_back(i + 7 + start);
-    leafIndices->push_back(i + 6 + start);
-    leafIndices->push_back(i + 6 + start);
-    leafIndices->push_back(i + 5 + start);
-    leafIndices->push_back(i + 4 + start);
-    leafNorms->at(i + 0 + start) = (leafNormal);
-    leafNorms->at(i + 1 + start) = (leafNormal);
-    leafNorms->at(i + 2 + start) = (leafNormal);
-    leafNorms->at(i + 3 + start) = (leafNormal);
-
-    leafNorms->at(i + 4 + start) = -(leafNormal);
-    leafNorms->at(i + 5 + start) = -(leafNormal);
-    leafNorms->at(i + 6 + start) = -(leafNormal);
-    leafNorms->at(i + 7 + start) = -(leafNormal);
-
-    return i = i + leafPoints * 2;
+    const GLuint south[6] = {4, 7, 6, 6, 5, 4};
+    indices->insert(indices->end(), north, north + 6);
+    indices->insert(indices->end(), south, south + 6);
 }
 
-
+void LeafAB::appendCorners(const std::vector<LeafInstance>& leaves, std::vector<glm::vec3>* points){
+    std::vector<glm::vec3> mesh, normals;
+    std::vector<glm::vec2> uvs;
+    std::vector<GLuint> indices;
+    buildMesh(&mesh, &normals, &uvs, &indices, 0.0f);
+    for (const LeafInstance& leaf : leaves) {
+        for (const glm::vec3& v : mesh) {
+            points->push_back(leaf.placement[0] * v.x + leaf.placement[1] * v.y + leaf.placement[2] * v.z
+                              + leaf.placement[3]);
+        }
+    }
+}
 
 LeafAB::LeafAB(const int& leafPoints, const int&  randomSeedValue,
                       const float& itterations, const float& jagednessFactor_Leaf,
-                        std::vector<glm::vec3>* leafVertices, std::vector<glm::vec2>* leafUVs) {
+                      const std::vector<glm::vec3>* branchVertices, std::vector<LeafInstance>* leaves) {
     this->leafPoints = leafPoints;
     this->randomSeedValue = randomSeedValue;
     this->itterations = itterations;
     this->jagednessFactor_Leaf = jagednessFactor_Leaf;
-    this->leafUVs = leafUVs;
-    this->leafVertices = leafVertices;
-};
\ No newline at end of file
+    this->lineHeight = 0;
+    this->branchVertices = branchVertices;
+    this->leaves = leaves;
+};
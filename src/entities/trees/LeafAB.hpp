@@ -1,4 +1,3 @@
-
 #ifndef PROCEDURALWORLD_LEAF_H
 #define PROCEDURALWORLD_LEAF_H
 
@@ -15,27 +14,40 @@
 
 #include "src/TreeRandom.hpp"
 
+//one leaf of a tree, drawn as an instance of the shared leaf mesh (see LeafAB::buildMesh and
+//TreePrototypeCache). placement maps the mesh into the tree, its columns are the leaf's two
+//half axes, the axis it faces along and its centre
+struct LeafInstance {
+    glm::mat4x3 placement;
+    //last vertex built before the leaf, it moves with the segment that vertex is in
+    int anchor;
+};
+
 class LeafAB {
     int leafPoints;
     int randomSeedValue;
-    int count;
     float lineHeight;
     float itterations;
     float jagednessFactor_Leaf;
-    std::vector<glm::vec3> *leafVertices;
-    std::vector<glm::vec2> *leafUVs;
+    const std::vector<glm::vec3> *branchVertices;
+    std::vector<LeafInstance> *leaves;
+
+    void addLeaf(const glm::vec3& axisU, const glm::vec3& axisV, const glm::vec3& facing, const glm::vec3& centre);
 public:
     LeafAB(const int& leafPoints, const int&  randomSeedValue,
-          const float& itterations, const float& jagednessFactor_Leaf, std::vector<glm::vec3>* leafVertices,
-                   std::vector<glm::vec2>* leafUVs);
+          const float& itterations, const float& jagednessFactor_Leaf,
+          const std::vector<glm::vec3>* branchVertices, std::vector<LeafInstance>* leaves);
 
     //builds 2
-    void buildLeaf(const float& r1, const float& r2,const float& lineHeight, const float& leafDiameter, const int& count, float leafTextureStar);
+    void buildLeaf(const float& r1, const float& r2, const float& leafDiameter, const float& lineHeight, const int& count);
+
+    void buildLeafSingle(const float& r1, const float& r2);
 
-    static GLuint buildElements(int i, const int& start, const int& leafPoints,
-                             std::vector<GLuint>* leafIndices, std::vector<glm::vec3>* leafVert,
-                             std::vector<glm::vec2>* leafUVs, std::vector<glm::vec3>* leafNorms);
+    //the double sided diamond every leaf is drawn with, a side at z 0 facing +z and one at z 0.1 facing -z
+    static void buildMesh(std::vector<glm::vec3>* vertices, std::vector<glm::vec3>* normals,
+                          std::vector<glm::vec2>* uvs, std::vector<GLuint>* indices, const float& leafTextureStart);
 
-    void buildLeafSingle(const float& r1, const float& r2, const float& trunkDiameter, int y, float leafTextureStart);
+    //the mesh's corners for every leaf, for bounds that have to cover the leaves
+    static void appendCorners(const std::vector<LeafInstance>& leaves, std::vector<glm::vec3>* points);
 };
-#endif //leaf
\ No newline at end of file
+#endif //leaf
@@ -1,19 +1,33 @@
+#include <stdexcept>
 #include "LeafBranchAB.hpp"
 #include "TrunkAB.hpp"
 
+constexpr int LeafBranchAB::maxBranchPoints;
+
 void LeafBranchAB::buildLeafBranch(const float& trunkDiameter, int y , float textureLeafStart ){
+    const bool hashed = TreeRandom::getMode() == TreeRandom::Mode::Hashed;
+    uint64_t jagged[maxBranchPoints];
+    if (hashed) {
+        TreeRandom::hashBatch(TreeRandom::hash(randomSeedValue, TreeRandom::jaggednessStream), y * branchPoints,
+                              jagged, branchPoints);
+    }
     for (int n = 0; n < branchPoints ; n++) {
-        int sign = -1;
-        int jagednessRandom = randomSeedValue * (((int)(n * 13.4) % 17) + 1);
-        if (jagednessRandom % 2 == 0) sign *= -1;
-        float tempTrunkDiameter = trunkDiameter + sign * (jagednessRandom) % ((int)(ceil(trunkDiameter))) * jagednessFactor_Leaf / (trunkDiameter);
+        float tempTrunkDiameter;
+        if (hashed) {
+            const int reach = (int)ceil(trunkDiameter);
+            tempTrunkDiameter = trunkDiameter + TreeRandom::hashRange(jagged[n], 1 - reach, reach)
+                                                * jagednessFactor_Leaf / (trunkDiameter);
+        } else {
+            int sign = -1;
+            int jagednessRandom = randomSeedValue * (((int)(n * 13.4) % 17) + 1);
+            if (jagednessRandom % 2 == 0) sign *= -1;
+            tempTrunkDiameter = trunkDiameter + sign * (jagednessRandom) % ((int)(ceil(trunkDiameter))) * jagednessFactor_Leaf / (trunkDiameter);
+        }
         leafVertices->push_back(glm::vec3(
                 tempTrunkDiameter * sin(glm::radians(itterations  * n)) ,
                 lineHeight,
                 tempTrunkDiameter *  cos(glm::radians(itterations  * n))));
-        unsigned  long s = leafVertices->size();
-        leafUVs->resize(s);
-        leafUVs->at(s - 1) = {(n) % 2, 1 - textureLeafStart * ((y + (!TrunkAB::constructionFlowCounter )) % 2)};
+        leafUVs->push_back({(n) % 2, 1 - textureLeafStart * ((y + (!context->constructionFlowCounter )) % 2)});
     }
 }
 
@@ -44,7 +58,11 @@ void LeafBranchAB::buildBranchElements(int baseVerticesSize, int i, int len){
 LeafBranchAB::LeafBranchAB(const int& randomSeedValue, const float& itterations, const int& branchPoints,
             const float& lineHeight, const float& jagednessFactor_Leaf,
             std::vector<glm::vec3>* leafVertices,
-            std::vector<GLuint>* leafIndices, std::vector<glm::vec2>* leafUVs){
+            std::vector<GLuint>* leafIndices, std::vector<glm::vec2>* leafUVs,
+            const TreeBuildContext* context){
+    if (branchPoints > maxBranchPoints) {
+        throw std::invalid_argument("A leaf branch has at most 16 points");
+    }
     this->randomSeedValue = randomSeedValue;
     this->itterations = itterations;
     this->branchPoints = branchPoints;
@@ -53,6 +71,7 @@ LeafBranchAB::LeafBranchAB(const int& randomSeedValue, const float& itterations,
     this->leafVertices = leafVertices;
     this->leafIndices = leafIndices;
     this->leafUVs = leafUVs;
+    this->context = context;
 }
 
 float LeafBranchAB::getLineHeight(){
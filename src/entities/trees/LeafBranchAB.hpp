@@ -14,6 +14,7 @@
 #include <vector>
 
 #include "src/TreeRandom.hpp"
+#include "TreeBuildContext.hpp"
 #include <cstdio>
 class LeafBranchAB {
     int randomSeedValue;
@@ -25,13 +26,17 @@ class LeafBranchAB {
     std::vector<glm::vec3> *leafVertices;
     std::vector<GLuint> *leafIndices;
     std::vector<glm::vec2> *leafUVs;
+    const TreeBuildContext* context;
 public:
+    static constexpr int maxBranchPoints = 16;
+
     float getLineHeight();
 
     LeafBranchAB(const int& randomSeedValue, const float& itterations, const int& branchPoints,
                 const float& lineHeight, const float& jagednessFactor_Leaf,
                 std::vector<glm::vec3>* leafVertices,
-                std::vector<GLuint>* leafIndices, std::vector<glm::vec2>* leafUVs);
+                std::vector<GLuint>* leafIndices, std::vector<glm::vec2>* leafUVs,
+                const TreeBuildContext* context);
 
     void buildLeafBranch(const float& trunkDiameter, int y, float textureLeafStart);
 
@@ -7,7 +7,7 @@
  * <--[-]-->
  *
  * Goes up alternating leaf angle ending with a top leaf
- * Double sided index on leaves
+ * Only the branch is vertices, the leaves are placed instances of one double sided leaf
  */
 
 #include <cmath>
@@ -27,12 +27,16 @@ constexpr float LeafContainerAB::textureLeafEnd;
 LeafContainerAB::LeafContainerAB(std::vector<glm::vec3>* leafVertices,
                                  std::vector<GLuint>* leafIndices,
                                  std::vector<glm::vec2>* leafUVs,
-                                 const int& seed){
+                                 std::vector<LeafInstance>* leaves,
+                                 const int& seed,
+                                 TreeBuildContext* context){
     this->leafVertices = leafVertices;
     this->leafIndices = leafIndices;
     this->leafUVs = leafUVs;
+    this->leaves = leaves;
     baseVerticesSize = leafVertices->size();
     this->seed = seed;
+    this->context = context;
 }
 
 //method to encapsulate the construction.
@@ -64,65 +68,67 @@ void LeafContainerAB::buildVertices(const int& randomSeedValue, float lineSegmen
 
 
     LeafAB LA(leafPoints, randomSeedValue, branchItterations, jagednessFactor_Leaf,
-              leafVertices, leafUVs);
+              leafVertices, leaves);
 
     while (lineHeight < lineMax - 2){
         //branch
         LeafBranchAB LBA(randomSeedValue, branchItterations, leafBranchPoints,
-                         lineHeight, jagednessFactor_Leaf, leafVertices, nullptr,leafUVs);
+                         lineHeight, jagednessFactor_Leaf, leafVertices, nullptr,leafUVs, context);
         LBA.buildLeafBranch(trunkDiameter, count, textureLeafStart);
         trunkDiameter *= 0.9;
         //builds 2 leaves at alternating 90 degrees. Uses count to do this.
 
         //north and south
-        LA.buildLeaf(r1, r2, trunkDiameter, lineHeight, count, textureLeafStart); //build two double sided leaves
+        LA.buildLeaf(r1, r2, trunkDiameter, lineHeight, count); //build two double sided leaves
         lineHeight += lineSegments;
         count++;
         //REPEAT NX
     }
-    TrunkAB::constructionFlowCounter = !TrunkAB::constructionFlowCounter;
+    context->constructionFlowCounter = !context->constructionFlowCounter;
 
     for (float y = 1.0; y >= 0.25; y -= 0.25) {
         //the branch is getting smaller
         LeafBranchAB LBA(randomSeedValue, branchItterations, leafBranchPoints,
-                         lineHeight, jagednessFactor_Leaf, leafVertices, nullptr, leafUVs);
+                         lineHeight, jagednessFactor_Leaf, leafVertices, nullptr, leafUVs, context);
         LBA.buildLeafBranch(trunkDiameter, count, textureLeafStart);
 
         //still making leaves
-        LA.buildLeaf(r1, r2, trunkDiameter, lineHeight, count, textureLeafStart);  //build two double sided leaves
+        LA.buildLeaf(r1, r2, trunkDiameter, lineHeight, count);  //build two double sided leaves
         lineHeight += lineSegments;
         trunkDiameter *= y ;
         count++;
         //REPEAT 2X
     }
     LeafBranchAB LBA(randomSeedValue, branchItterations, leafBranchPoints,
-                     lineHeight, jagednessFactor_Leaf, leafVertices, nullptr, leafUVs);
+                     lineHeight, jagednessFactor_Leaf, leafVertices, nullptr, leafUVs, context);
 
     LBA.buildLeafBranch(trunkDiameter*0.1, count, textureLeafStart);
 
     //final top two leaves
-    LA.buildLeaf(r1, r2, trunkDiameter, lineHeight, count, textureLeafStart);  //build two double sided leaves
+    LA.buildLeaf(r1, r2, trunkDiameter, lineHeight, count);  //build two double sided leaves
     //Cap with a leaf
-    LA.buildLeafSingle(r1, r2, r1, count, textureLeafStart);
+    LA.buildLeafSingle(r1, r2);
 }
 
 
 void LeafContainerAB::buildLeafContainerElements(const int& start, const int& end,
                                                  std::vector<GLuint>* leafIndices, std::vector<glm::vec3>* leafVert,
                                                  std::vector<glm::vec2>* leafUVs, std::vector<glm::vec3>* leafNorms){
+    if(leafVert->size() != leafNorms->size()){
+        leafUVs->resize(leafVert->size());
+        leafNorms->resize(leafVert->size());
+    }
 
-    const int endVert = (end - start - leafPoints*2)/ (leafBranchPoints + leafPoints*4);
-    const int vertToNext = ((1) *(leafBranchPoints + leafPoints*4));
-    const  int factor = (leafBranchPoints + leafPoints*4);
+    //the branch is stacked rings of leafBranchPoints, joined ring to ring
+    const int rings = (end - start + 1) / leafBranchPoints;
+    const int vertToNext = leafBranchPoints;
 
-    GLuint i = 0;
-    //build a running set of vertices to add indices to.
-    for(int k = 0 ; k < endVert; k++){
+    for(int k = 0 ; k + 1 < rings; k++){
         std::vector<glm::vec3> surfaceNormals;
-        int j = i;
-        for(; i < leafBranchPoints + j ; i++) {
-            const int currentVertSet = ((k) *factor);
-            GLuint i1 = (i + 1) % (factor) % leafBranchPoints +  currentVertSet;
+        const int currentVertSet = k * leafBranchPoints;
+        for(int n = 0; n < leafBranchPoints; n++) {
+            const GLuint i = currentVertSet + n;
+            const GLuint i1 = currentVertSet + (n + 1) % leafBranchPoints;
             leafIndices->push_back(i + start);
             leafIndices->push_back(i1+ start);
             leafIndices->push_back(i1 + vertToNext + start);
@@ -140,28 +146,11 @@ void LeafContainerAB::buildLeafContainerElements(const int& start, const int& en
         }
         //step 2: find the average of the surface normals of the surfaces this vertex is part of
         int len =  surfaceNormals.size();
-        for(GLuint j = 0; j < len ; j++){
-            int jPos = i + start - leafBranchPoints + j + 1;
-            if(jPos % leafPoints == 0) jPos =  i + start - leafBranchPoints + 0;
+        for(int j = 0; j < len ; j++){
+            const int jPos = start + currentVertSet + (j + 1) % leafBranchPoints;
             leafNorms->at(jPos ) = -glm::normalize(
                     surfaceNormals.at(j) + surfaceNormals.at((j+1) % len)
             );
         }
-
-        i = LeafAB::buildElements(i, start, leafPoints ,leafIndices, leafVert,
-                                 leafUVs, leafNorms);
-        i = LeafAB::buildElements(i, start, leafPoints , leafIndices, leafVert,
-                                 leafUVs, leafNorms);
     }
-    i+= leafPoints;
-
-    //incides and normal of top leaf
-    i = LeafAB::buildElements(i, start,  leafPoints,  leafIndices, leafVert,
-                             leafUVs, leafNorms);
-    i = LeafAB::buildElements(i, start,  leafPoints,  leafIndices, leafVert,
-                             leafUVs, leafNorms);
-    //
-    i = LeafAB::buildElements(i, start,  leafPoints,  leafIndices, leafVert,
-                             leafUVs, leafNorms);
 }
-
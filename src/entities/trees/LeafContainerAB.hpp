@@ -20,6 +20,7 @@
 #include "LeafBranchAB.hpp"
 #include "src/entities/Trees/TrunkAB.hpp"
 #include "src/TreeRandom.hpp"
+#include "TreeBuildContext.hpp"
 
 
 class LeafContainerAB {
@@ -36,16 +37,20 @@ private:
     std::vector<glm::vec3>* leafVertices;
     std::vector<GLuint>* leafIndices;
     std::vector<glm::vec2>* leafUVs;
+    std::vector<LeafInstance>* leaves;
 
     float lineHeight = 0;
     int baseVerticesSize = 0;
     int heightCount = 0;
     int seed = 0;
+    TreeBuildContext* context;
 public:
     LeafContainerAB(std::vector<glm::vec3>* leafVertices,
                         std::vector<GLuint>* leafIndices,
                         std::vector<glm::vec2>* leafUVs,
-                        const int& seed);
+                        std::vector<LeafInstance>* leaves,
+                        const int& seed,
+                        TreeBuildContext* context);
 
     void buildVertices(const int& randomSeedValue, float lineSegments,
                    int lineMax, float trunkDiameter, const float& seed,
@@ -53,6 +58,7 @@ public:
   
     void buildContainer(float trunkDiameter, const float& seed, float lineHeight, const int& lineMax);
     
+    //the branch's elements and normals, its leaves are instances and have none
     static void buildLeafContainerElements(const int& start, const int& end,
                                            std::vector<GLuint>* leafIndices, std::vector<glm::vec3>* leafVert,
                                            std::vector<glm::vec2>* leafUVs, std::vector<glm::vec3>* leafNorms);
@@ -20,7 +20,8 @@
 
 
 LeafContainerC::LeafContainerC(std::vector<glm::vec3>* combinedVertices, std::vector<glm::vec2>* combinedUV, std::vector<glm::vec3>* combinedNormals, std::vector<GLuint>* combinedIndices,
-                               float lineMax, float leafTextureHeight) {
+                               float lineMax, float leafTextureHeight, TreeBuildContext* context) {
+    this->context = context;
     this->combinedVertices = combinedVertices;
     this->combinedNormals = combinedNormals;
     this->combinedUV = combinedUV;
@@ -53,9 +54,7 @@ void LeafContainerC::buildAllComponenets(const float& leafDiameter,const float&
                 combinedVertices->push_back(
                         glm::vec3(tempTrunkDiameter * sin(glm::radians(itterations * n)), lineHeight + 0,
                                   tempTrunkDiameter * cos(glm::radians(itterations * n))));
-                unsigned  long s = combinedVertices->size();
-                combinedUV->resize(s);
-                combinedUV->at(s - 1) = {uCount,  1 - leafTextureHeight * ((heightCount + (!TrunkC::constructionFlowCounter)) % 2)};
+                combinedUV->push_back({uCount,  1 - leafTextureHeight * ((heightCount + (!context->constructionFlowCounter)) % 2)});
                 uCount += 0.33;
             }
             for (int side = 0 ; side < 2; side++){
@@ -103,11 +102,10 @@ void LeafContainerC::buildAllComponenets(const float& leafDiameter,const float&
             heightCount++;
             //REPEAT NX
         }
-        TrunkC::constructionFlowCounter = !TrunkC::constructionFlowCounter ;
+        context->constructionFlowCounter = !context->constructionFlowCounter ;
         for (float y = 0.5; y >= 0.25; y -= 0.25) {
             f -= y * 0.55;
             //Generate circle
-            unsigned long s = 0;
             for (int n = 0; n < leafPoints; n++) {
                 int sign = -1;
                 int jagednessRandom = randomSeedValue * (((int) (n * 13.4) % 17) + 1);
@@ -118,9 +116,7 @@ void LeafContainerC::buildAllComponenets(const float& leafDiameter,const float&
                 combinedVertices->push_back(
                         glm::vec3(tempTrunkDiameter * sin(glm::radians(itterations * n)), lineHeight + 0,
                                   tempTrunkDiameter * cos(glm::radians(itterations * n))));
-                s = combinedVertices->size();
-                combinedUV->resize(s);
-                combinedUV->at(s - 1) = {(n) % 2, 1 - leafTextureHeight * (heightCount % 2)};
+                combinedUV->push_back({(n) % 2, 1 - leafTextureHeight * (heightCount % 2)});
             }
 
             for (int side = 0 ; side < 2; side++) {
@@ -14,6 +14,7 @@
 
 
 #include "src/TreeRandom.hpp"
+#include "TreeBuildContext.hpp"
 
 class LeafContainerC {
     std::vector<glm::vec3>* combinedVertices;
@@ -29,9 +30,10 @@ class LeafContainerC {
     static constexpr int stretchFactor = 100;
     static constexpr float jagednessFactor_Leaf = 0.0020;
     int branchMod;
+    TreeBuildContext* context;
 public:
     LeafContainerC(std::vector<glm::vec3>* combinedVertices, std::vector<glm::vec2>* combinedUV, std::vector<glm::vec3>* combinedNormals ,std::vector<GLuint>* combinedIndices, float leafTextureHeight,
-                   float lineMax);
+                   float lineMax, TreeBuildContext* context);
 
     void buildAllComponenets(const float& leafDiameter, const float& widthCutoff, const float& seed, float lineHeight);
     void setLeafUV();
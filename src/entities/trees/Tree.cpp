@@ -5,12 +5,24 @@
 #include <GL/glew.h> // include GL Extension Wrangler
 #endif
 
+#include <algorithm>
 #include <cmath>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <stdexcept>
+#include <utility>
+#ifdef __SSE__
+#include <xmmintrin.h>
+#endif
 #include <glm/glm.hpp>
 
 #include "src/entities/Entity.hpp"
 #include "src/entities/DrawableEntity.hpp"
+#include "src/entities/TileArena.hpp"
 #include "Tree.hpp"
+#include "TreePrototypeCache.hpp"
+#include "TreeBuildBatch.hpp"
 
 
 Tree::Tree(int heightChunking, float boostFactor, float seed, const GLuint& shader_program, Entity* entity, const char& type)
@@ -20,6 +32,8 @@ Tree::Tree(int heightChunking, float boostFactor, float seed, const GLuint& shad
     this->heightChunking = heightChunking;
     this->boostFactor = boostFactor;
     this->type = type;
+    this->shaderProgram = shader_program;
+    vao = 0; vbo = 0; ebo = 0; nbo = 0; uvbo = 0;
 
     this->setMaterial(glm::vec3(0.5f), glm::vec3(0.5f), glm::vec3(0.5f), 0.5f);
 }
@@ -30,43 +44,100 @@ Tree::~Tree() {
 //    delete combinedNormals;
 //    delete combinedUV;
 //    delete combinedStartIndices;
-    glDeleteBuffers(1, &vbo);
-    glDeleteBuffers(1, &ebo);
-    glDeleteBuffers(1, &nbo);
-    glDeleteBuffers(1, &uvbo);
-   glDeleteVertexArrays(1, &vao);
+    //buffers handed to a prototype are zeroed and belong to the cache. the rest go with the
+    //other trees of the tile, see TileArena::reset
+    const GLuint buffers[] = {vbo, ebo, nbo, uvbo};
+    TileArena::deleteLater(buffers, 4, vao);
 }
 
 glm::vec3 Tree::boostSegment(const AttatchmentGroupings* agLow,const AttatchmentGroupings* agHigh,
-                             const std::vector<glm::vec3>* vPntr){
+                             const glm::mat3& highRotation, const std::vector<glm::vec3>* vPntr){
     glm::vec3 AB = vPntr->at(agLow->end) - vPntr->at(agLow->end -1);
     glm::vec3 AC = vPntr->at(agLow->end-2) - vPntr->at(agLow->end -1);
     glm::vec3 low =  glm::normalize(glm::cross(AB, AC));
-    glm::vec3 KJ = vPntr->at(agHigh->start + 1) - vPntr->at(agHigh->start+2);
-    glm::vec3 KL = vPntr->at(agHigh->start + 3) - vPntr->at(agHigh->start+2);
+    const glm::vec3 J = rotateVertex(highRotation, vPntr->at(agHigh->start + 1));
+    const glm::vec3 K = rotateVertex(highRotation, vPntr->at(agHigh->start + 2));
+    const glm::vec3 L = rotateVertex(highRotation, vPntr->at(agHigh->start + 3));
+    glm::vec3 KJ = J - K;
+    glm::vec3 KL = L - K;
     glm::vec3 high =  -glm::normalize(glm::cross(KJ, KL));
     return low + high;
 }
 
 //values in radians
-glm::vec3 Tree::makeRotations(const float& xRot, const float& yRot, const float& zRot, glm::vec3 vector){
-    //ROTATION ABOUT X
-    vector = glm::vec3(
-            vector.x
-            , vector.y * cos(xRot) - vector.z * sin(xRot)
-            ,	vector.y * sin(xRot) + vector.z * cos(xRot));
-    //ROTATION ABOUT Z
-    vector = glm::vec3(
-            vector.x * cos(zRot) - vector.y * sin(zRot)
-            , vector.x * sin(zRot) + vector.y * cos(zRot)
-            ,	vector.z );
-    //ROTATION ABOUT Y
-    vector = glm::vec3(
-            vector.x * cos(yRot) + vector.z * sin(yRot)
-            , vector.y
-            ,	-(vector.x * sin(yRot)) + vector.z * cos(yRot));
-
-    return vector;
+glm::mat3 Tree::makeRotations(const float& xRot, const float& yRot, const float& zRot){
+    const double cx = cos(xRot), sx = sin(xRot);
+    const double cy = cos(yRot), sy = sin(yRot);
+    const double cz = cos(zRot), sz = sin(zRot);
+    //ROTATION ABOUT Y * ROTATION ABOUT Z * ROTATION ABOUT X, glm is column major
+    return glm::mat3(
+            glm::vec3(cy * cz, sz, -sy * cz),
+            glm::vec3(-cy * sz * cx + sy * sx, cz * cx, sy * sz * cx + cy * sx),
+            glm::vec3(cy * sz * sx + sy * cx, -cz * sx, -sy * sz * sx + cy * cx));
+}
+
+glm::vec3 Tree::rotateVertex(const glm::mat3& rotation, const glm::vec3& vertex){
+    return glm::vec3(
+            rotation[0][0] * vertex.x + rotation[1][0] * vertex.y + rotation[2][0] * vertex.z,
+            rotation[0][1] * vertex.x + rotation[1][1] * vertex.y + rotation[2][1] * vertex.z,
+            rotation[0][2] * vertex.x + rotation[1][2] * vertex.y + rotation[2][2] * vertex.z);
+}
+
+void Tree::transformSegment(const glm::mat3& rotation, const glm::vec3& offset, const int& start, const int& end){
+    if (start >= end) return;
+    if (start < 0 || end > (int)combinedVertices.size()) {
+        throw std::out_of_range("Tree segment is outside of the generated vertices");
+    }
+    int k = start;
+#ifdef __SSE__
+    static_assert(sizeof(glm::vec3) == 3 * sizeof(float), "vertices must be tightly packed floats");
+    __m128 m[3][3];
+    __m128 o[3];
+    for (int row = 0; row < 3; row++) {
+        for (int column = 0; column < 3; column++) {
+            m[row][column] = _mm_set1_ps(rotation[column][row]);
+        }
+        o[row] = _mm_set1_ps(offset[row]);
+    }
+    //four vertices are three registers: x0 y0 z0 x1 | y1 z1 x2 y2 | z2 x3 y3 z3
+    for (; k + 4 <= end; k += 4) {
+        float* v = &combinedVertices[k].x;
+        const __m128 a = _mm_loadu_ps(v);
+        const __m128 b = _mm_loadu_ps(v + 4);
+        const __m128 c = _mm_loadu_ps(v + 8);
+        //to x0 x1 x2 x3 | y0 y1 y2 y3 | z0 z1 z2 z3
+        const __m128 x = _mm_shuffle_ps(a, _mm_shuffle_ps(b, c, _MM_SHUFFLE(1, 1, 2, 2)), _MM_SHUFFLE(2, 0, 3, 0));
+        const __m128 y = _mm_shuffle_ps(_mm_shuffle_ps(a, b, _MM_SHUFFLE(0, 0, 1, 1)),
+                                        _mm_shuffle_ps(b, c, _MM_SHUFFLE(2, 2, 3, 3)), _MM_SHUFFLE(2, 0, 2, 0));
+        const __m128 z = _mm_shuffle_ps(_mm_shuffle_ps(a, b, _MM_SHUFFLE(1, 1, 2, 2)),
+                                        _mm_shuffle_ps(c, c, _MM_SHUFFLE(3, 3, 0, 0)), _MM_SHUFFLE(2, 0, 2, 0));
+        __m128 r[3];
+        for (int row = 0; row < 3; row++) {
+            r[row] = _mm_add_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(m[row][0], x), _mm_mul_ps(m[row][1], y)),
+                                           _mm_mul_ps(m[row][2], z)), o[row]);
+        }
+        //and back
+        _mm_storeu_ps(v, _mm_shuffle_ps(_mm_shuffle_ps(r[0], r[1], _MM_SHUFFLE(0, 0, 0, 0)),
+                                        _mm_shuffle_ps(r[2], r[0], _MM_SHUFFLE(1, 1, 0, 0)), _MM_SHUFFLE(2, 0, 2, 0)));
+        _mm_storeu_ps(v + 4, _mm_shuffle_ps(_mm_shuffle_ps(r[1], r[2], _MM_SHUFFLE(1, 1, 1, 1)),
+                                            _mm_shuffle_ps(r[0], r[1], _MM_SHUFFLE(2, 2, 2, 2)), _MM_SHUFFLE(2, 0, 2, 0)));
+        _mm_storeu_ps(v + 8, _mm_shuffle_ps(_mm_shuffle_ps(r[2], r[0], _MM_SHUFFLE(3, 3, 2, 2)),
+                                            _mm_shuffle_ps(r[1], r[2], _MM_SHUFFLE(3, 3, 3, 3)), _MM_SHUFFLE(2, 0, 2, 0)));
+    }
+#endif
+    for (; k < end; k++) {
+        combinedVertices[k] = rotateVertex(rotation, combinedVertices[k]) + offset;
+    }
+
+    //anchors only grow, so the segment's leaves are one run
+    auto leaf = std::lower_bound(combinedLeaves.begin(), combinedLeaves.end(), start,
+                                 [](const LeafInstance& l, const int& vertex) { return l.anchor < vertex; });
+    for (; leaf != combinedLeaves.end() && leaf->anchor < end; ++leaf) {
+        for (int column = 0; column < 3; column++) {
+            leaf->placement[column] = rotateVertex(rotation, leaf->placement[column]);
+        }
+        leaf->placement[3] = rotateVertex(rotation, leaf->placement[3]) + offset;
+    }
 }
 
 void Tree::connectSegments(const AttatchmentGroupings* ag, const int& m,
@@ -95,12 +166,190 @@ int Tree::lineMAX(const float& trunkDiameter, int k) {
 }
 
 
+void Tree::loadPrototype(const TreePrototypeCache::Key& key, const float& trunkDiameter,
+                         const std::function<void(float, int)>& generate, TreeBuildBatch* batch){
+    scale(trunkDiameter / TreePrototypeCache::getDiameter(key));
+
+    prototype = TreePrototypeCache::find(key);
+    if (prototype) return;
+
+    if (batch) {
+        batch->add(this, key, generate);
+        return;
+    }
+    generatePrototype(key, generate);
+    uploadPrototype(key);
+}
+
+void Tree::generatePrototype(const TreePrototypeCache::Key& key, const std::function<void(float, int)>& generate){
+    beginPrototype(key, generate);
+    size_t unlimited = SIZE_MAX;
+    grow(&unlimited);
+    finishPrototype();
+}
+
+void Tree::beginPrototype(const TreePrototypeCache::Key& key, const std::function<void(float, int)>& generate){
+    auto startTime = std::chrono::steady_clock::now();
+    buildContext = TreeBuildContext();
+    branchArena.reset();
+    growthStack.clear();
+    combinedLeaves.clear();
+    const MeshEstimate estimate = estimateMesh(TreePrototypeCache::getDiameter(key));
+    combinedVertices.reserve(estimate.vertices);
+    combinedUV.reserve(estimate.vertices);
+    combinedNormals.reserve(estimate.vertices);
+    combinedIndices.reserve(estimate.indices);
+    combinedLeaves.reserve(estimate.leaves);
+    generate(TreePrototypeCache::getDiameter(key), TreePrototypeCache::getSeed(key));
+    std::chrono::duration<double, std::milli> duration = std::chrono::steady_clock::now() - startTime;
+    generationTime = duration.count();
+}
+
+bool Tree::grow(size_t* vertexBudget){
+    auto startTime = std::chrono::steady_clock::now();
+    while (!growthStack.empty() && *vertexBudget > 0) {
+        const GrowthTask task = growthStack.back();
+        growthStack.pop_back();
+        const size_t written = growTask(task);
+        *vertexBudget -= std::min(written, *vertexBudget);
+    }
+    std::chrono::duration<double, std::milli> duration = std::chrono::steady_clock::now() - startTime;
+    generationTime += duration.count();
+    return growthStack.empty();
+}
+
+void Tree::finishPrototype(){
+    auto startTime = std::chrono::steady_clock::now();
+    std::vector<GrowthTask>().swap(growthStack);
+    if (combinedLeaves.empty()) {
+        generatedBounds = MeshBounds(combinedVertices);
+    } else {
+        //hit boxes cover the leaves too
+        std::vector<glm::vec3> outline(combinedVertices);
+        LeafAB::appendCorners(combinedLeaves, &outline);
+        generatedBounds = MeshBounds(outline);
+    }
+    std::chrono::duration<double, std::milli> duration = std::chrono::steady_clock::now() - startTime;
+    generationTime += duration.count();
+}
+
+void Tree::pushTask(const int& _case, float trunkDiameter, const float& seed,
+                    float angleX, float angleY, float angleZ,
+                    char tag, AttatchmentGroupings* ag, float lineHeight){
+    GrowthTask task;
+    task._case = _case;
+    task.trunkDiameter = trunkDiameter;
+    task.seed = seed;
+    task.angleX = angleX;
+    task.angleY = angleY;
+    task.angleZ = angleZ;
+    task.tag = tag;
+    task.ag = ag;
+    task.lineHeight = lineHeight;
+    task.branch = 0;
+    task.previousRotation = 0;
+    growthStack.push_back(task);
+}
+
+void Tree::pushMove(const int& _case, AttatchmentGroupings* ag, const int& branch, const int& previousRotation){
+    pushTask(_case, 0, 0, 0, 0, 0, 0, ag, 0);
+    growthStack.back().branch = branch;
+    growthStack.back().previousRotation = previousRotation;
+}
+
+void Tree::uploadPrototype(const TreePrototypeCache::Key& key){
+    auto startTime = std::chrono::steady_clock::now();
+    bufferObject(shaderProgram);
+    std::chrono::duration<double, std::milli> duration = std::chrono::steady_clock::now() - startTime;
+
+    TreePrototypeHandle built = std::make_shared<TreePrototype>();
+    built->vao = vao; built->vertex_buffer = vbo; built->element_buffer = ebo;
+    built->normal_buffer = nbo; built->uv_buffer = uvbo;
+    vao = 0; vbo = 0; ebo = 0; nbo = 0; uvbo = 0;
+    //a texel is four floats, so a leaf's placement goes in as three rows
+    std::vector<glm::vec4> leafRows;
+    leafRows.reserve(combinedLeaves.size() * 3);
+    for (const LeafInstance& leaf : combinedLeaves) {
+        for (int row = 0; row < 3; row++) {
+            leafRows.emplace_back(leaf.placement[0][row], leaf.placement[1][row],
+                                  leaf.placement[2][row], leaf.placement[3][row]);
+        }
+    }
+    if (!leafRows.empty()) {
+        glGenBuffers(1, &built->leaf_buffer);
+        glBindBuffer(GL_TEXTURE_BUFFER, built->leaf_buffer);
+        glBufferData(GL_TEXTURE_BUFFER, leafRows.size() * sizeof(glm::vec4), leafRows.data(), GL_STATIC_DRAW);
+        glBindBuffer(GL_TEXTURE_BUFFER, 0);
+        glGenTextures(1, &built->leaf_texture);
+        glActiveTexture(TreePrototypeCache::leaf_texture_unit);
+        glBindTexture(GL_TEXTURE_BUFFER, built->leaf_texture);
+        glTexBuffer(GL_TEXTURE_BUFFER, GL_RGBA32F, built->leaf_buffer);
+        glActiveTexture(GL_TEXTURE0);
+    }
+    built->leaf_count = (GLsizei)combinedLeaves.size();
+    built->element_count = (GLsizei)combinedIndices.size();
+    built->bounds = std::move(generatedBounds);
+    generatedBounds = MeshBounds();
+    built->bytes = combinedVertices.size() * sizeof(glm::vec3)
+                   + combinedIndices.size() * sizeof(GLuint)
+                   + combinedNormals.size() * sizeof(glm::vec3)
+                   + combinedUV.size() * sizeof(glm::vec2)
+                   + leafRows.size() * sizeof(glm::vec4)
+                   + built->bounds.getBytes();
+    built->build_ms = generationTime + duration.count();
+
+    //the generator output is only needed until it's on the gpu
+    std::vector<glm::vec3>().swap(combinedVertices);
+    std::vector<GLuint>().swap(combinedIndices);
+    std::vector<glm::vec3>().swap(combinedNormals);
+    std::vector<glm::vec2>().swap(combinedUV);
+    std::vector<BranchStart>().swap(combinedStartIndices);
+    std::vector<LeafInstance>().swap(combinedLeaves);
+    branchArena.release();
+
+    prototype = TreePrototypeCache::store(key, built);
+}
+
+const TreePrototype* Tree::getPrototype() const {
+    return prototype.get();
+}
+
+void Tree::draw(const glm::mat4& view_matrix, const glm::mat4& projection_matrix, const Light& light){
+    //still queued in a TreeBuildBatch, there's nothing to draw yet
+    if (!prototype) {
+        Entity::draw(view_matrix, projection_matrix, light);
+        return;
+    }
+    //transparent trees are sorted by the entity tree, they can't wait for the instanced pass
+    if (getOpacity() < 1.0f) {
+        DrawableEntity::draw(view_matrix, projection_matrix, light);
+        if (prototype->leaf_count > 0 && !isHidden()) {
+            prepareDraw(view_matrix, projection_matrix, light);
+            TreePrototypeCache::drawLeaves(shaderProgram, prototype.get());
+            glUseProgram(0);
+        }
+        return;
+    }
+
+    Entity::draw(view_matrix, projection_matrix, light);
+    if (isHidden()) return;
+    TreePrototypeCache::queue(this);
+}
+
 const std::vector<glm::vec3>& Tree::getVertices() const {
     return combinedVertices;
 }
 
+const MeshBounds* Tree::getMeshBounds() const {
+    return prototype ? &prototype->bounds : nullptr;
+}
+
+Tree::MeshEstimate Tree::estimateMesh(const float&) const {
+    return {0, 0, 0};
+}
+
 GLuint Tree::getVAO() {
-    return this->vao;
+    return prototype ? prototype->vao : this->vao;
 }
 
 const int Tree::getColorType() {
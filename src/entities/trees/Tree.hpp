@@ -13,18 +13,41 @@
 #include <glm/gtc/matrix_transform.hpp>
 
 #include <vector>
+#include <functional>
 
 #include "src/constants.hpp"
 #include "TrunkAB.hpp"
 #include "LeafContainerAB.hpp"
 #include "src/entities/Entity.hpp"
 #include "src/entities/DrawableEntity.hpp"
+#include "TreePrototypeCache.hpp"
+#include "TreeBuildContext.hpp"
+#include "TreeArena.hpp"
+
+class TreeBuildBatch;
 
 //wrapper class
 class Tree: public DrawableEntity {
 private:
     char type;
+    GLuint shaderProgram;
+    double generationTime = 0;
+
+    //runs the generator into this tree's vectors. touches nothing outside the tree so it can run on any thread
+    void generatePrototype(const TreePrototypeCache::Key& key, const std::function<void(float, int)>& generate);
+    //generatePrototype in pieces: begin queues the first task, grow runs tasks until *vertexBudget
+    //vertices were written (taking them off the budget) and returns true once the stack is empty,
+    //then finish builds the bounds
+    void beginPrototype(const TreePrototypeCache::Key& key, const std::function<void(float, int)>& generate);
+    bool grow(size_t* vertexBudget);
+    void finishPrototype();
+    //sends the generated mesh to the gpu and hands it to the cache, needs the gl context
+    void uploadPrototype(const TreePrototypeCache::Key& key);
+
+    friend class TreeBuildBatch;
 protected:
+    //one generated segment and the two segments attached to it. they live in the tree's
+    //branchArena for one generation, so nothing here owns or frees its children
     class AttatchmentGroupings {
     public:
         //START END ANGLEX ANGLEY ANGLEZ
@@ -38,6 +61,7 @@ protected:
 
         AttatchmentGroupings* ag[2];
 
+    AttatchmentGroupings() = default;
     AttatchmentGroupings(const int& start,	const int& end,
                          const int& angleX, const int& angleY, const int& angleZ,
                          const char& type,	const char& side){
@@ -50,27 +74,60 @@ protected:
         this->side = side;
         ag[0] = nullptr; ag[1] = nullptr;
     }
-    void selfErase() {
-        for (AttatchmentGroupings* agI: this->ag){
-            if (agI != nullptr) {
-                agI->selfErase();
-                delete agI;
-                agI = nullptr;
-            }
-        }
-    }
 };
 
+    //last vertex of a generated segment and the angles it was built with
+    struct BranchStart {
+        int vertex;
+        int angleX;
+        int angleY;
+        int angleZ;
+    };
+
+    //one pending call of a generator. the generators used to recurse once per segment, now a
+    //call pushes the calls it would have made onto growthStack (last first, so they run in the
+    //same order) and returns. a deep tree can't overflow the stack, and generation can stop
+    //between any two tasks and carry on later, see grow
+    struct GrowthTask {
+        int _case;
+        float trunkDiameter;
+        float seed;
+        float angleX;
+        float angleY;
+        float angleZ;
+        char tag;
+        AttatchmentGroupings* ag;
+        float lineHeight;
+        //segment moves, which of ag's two children and the rotation point ag ended up with
+        int branch;
+        int previousRotation;
+    };
+    std::vector<GrowthTask> growthStack;
+
+    void pushTask(const int& _case, float trunkDiameter, const float& seed,
+                  float angleX, float angleY, float angleZ,
+                  char tag, AttatchmentGroupings* ag, float lineHeight);
+    void pushMove(const int& _case, AttatchmentGroupings* ag, const int& branch, const int& previousRotation);
+
+    //runs one task and returns about how many vertices it wrote or moved
+    virtual size_t growTask(const GrowthTask& task) = 0;
+
     float shootCalculation(const float& trunkDiameter, const double& ratio,const int& branches);
     int lineMAX(const float& trunkDiameter, int k);
 
-    std::vector<AttatchmentGroupings> branchStore;
+    TreeArena<AttatchmentGroupings> branchArena;
     std::vector<glm::vec3> combinedVertices;
     std::vector<GLuint> combinedIndices;
     std::vector<glm::vec3> combinedNormals;
     std::vector<glm::vec2> combinedUV;
-    std::vector<std::vector<int>> combinedStartIndices;
+    std::vector<BranchStart> combinedStartIndices;
+    //placed leaves, in the order their anchors were built
+    std::vector<LeafInstance> combinedLeaves;
     GLuint vao; GLuint vbo; GLuint ebo; GLuint nbo; GLuint uvbo;
+    TreePrototypeHandle prototype;
+    TreeBuildContext buildContext;
+    //outline of the generated mesh, built with it (off the gl thread in a batch) and handed to the prototype
+    MeshBounds generatedBounds;
 
     float heightChunking;
     float boostFactor;
@@ -81,15 +138,41 @@ protected:
 
     Entity* e;
 
+    //shares the mesh cached under key, or runs generate(diameter, seed) and hands the mesh to the cache.
+    //with a batch the generation is queued until TreeBuildBatch::build.
+    //the tree is scaled from the prototype's quantised diameter back to trunkDiameter
+    void loadPrototype(const TreePrototypeCache::Key& key, const float& trunkDiameter,
+                       const std::function<void(float, int)>& generate, TreeBuildBatch* batch);
+
+    //each tree type picks the vertex attributes it uses
+    virtual void bufferObject(const GLuint& shader_program) = 0;
+
+    //rough final size of a generated mesh, so the vectors are reserved once instead of regrown
+    struct MeshEstimate {
+        size_t vertices;
+        size_t indices;
+        size_t leaves;
+    };
+    //over rather than under, the vectors are dropped after upload anyway. 0 reserves nothing
+    virtual MeshEstimate estimateMesh(const float& trunkDiameter) const;
+
 public:
 
     char getType(){return type;}
 
+    //agHigh's vertices are read as if highRotation had already been applied to them
     glm::vec3 boostSegment(const AttatchmentGroupings* agLow, const AttatchmentGroupings* agHigh,
-                           const std::vector<glm::vec3>* vPntr);
+                           const glm::mat3& highRotation, const std::vector<glm::vec3>* vPntr);
+
+    //rotation about x, then z, then y. values in radians
+    glm::mat3 makeRotations(const float& xRot, const float& yRot, const float& zRot);
+
+    //rotates one vertex exactly the way transformSegment does
+    static glm::vec3 rotateVertex(const glm::mat3& rotation, const glm::vec3& vertex);
 
-    //values in radians
-    glm::vec3 makeRotations(const float& xRot, const float& yRot, const float& zRot, glm::vec3 vector);
+    //rotates the vertices [start, end) then adds offset, four at a time where sse is available.
+    //leaves anchored in the range move with it
+    void transformSegment(const glm::mat3& rotation, const glm::vec3& offset, const int& start, const int& end);
 
     void connectSegments(const AttatchmentGroupings* ag, const int& m,
                          const int& rotPoint, const int& prevPoint, const int& circularPoints,
@@ -97,10 +180,17 @@ public:
 
     void computeElementsInitial(const AttatchmentGroupings* ag);
 
+    //empty once the mesh is on the gpu, hit boxes use getMeshBounds
     const std::vector<glm::vec3>& getVertices() const override;
 
+    const MeshBounds* getMeshBounds() const override;
+
     GLuint getVAO() override;
 
+    const TreePrototype* getPrototype() const;
+
+    void draw(const glm::mat4& view_matrix, const glm::mat4& projection_matrix, const Light& light) override;
+
     const int getColorType() override;
 
     Tree(int heightChunking, float boostFactor, float seed, const GLuint& shader_program, Entity* entity, const char& type);
@@ -17,8 +17,8 @@ CURRENT LOADING SPEED SUGGESTS THE 4-8 DIAMETER RANGE WILL GENERATE QUICKLY. SOM
 
 ### THE PROGRAM
 PROGRAM ENTRY POINT IN IN THE CONSTRUCTOR FILE WHERE IT INITIALIZES SUBCLASSES AND SETS SOME BASE PARAMETERS.
-AFTER INITIALIZED THE generateTreeA FUNCTION STARTS TO BUILD THE STARTER TRUNK,
-THEN ENTERS BINARY RECURSIONS OF ITSELF TO GENERATE THE TRUNKS AND LEAVES WHEREUPON REACHING THE BASE CASE AFTER CONSTRUCTING A LEAF '                  generateTreeA(END_TRUNK, trunkDiameter, seed, angleX, angleY, angleZ, tag, ag, lineHeight);' IT MOVES ONTO THE NEXT BRANCH. AFTER COMPLETING RECURSIONS SEGMENTS OF ARE ROATED AND THEN MOVED ON TOP OF EACH OTHER WITH TOP MOST VERTICES OF THE LOWER TOUCHING AN APPROPRIATE HIGHEST VERTICES ON THE LOWEST.
+AFTER INITIALIZED THE generate FUNCTION (BranchingTree.hpp) STARTS TO BUILD THE STARTER TRUNK,
+THEN QUEUES A TASK FOR EACH SHOOT ON THE TREE'S GROWTH STACK (A BINARY RECURSION RUN AS A LOOP, SEE Tree::grow) TO GENERATE THE TRUNKS AND LEAVES WHEREUPON REACHING THE BASE CASE AFTER CONSTRUCTING A LEAF '                  generate(END_TRUNK, trunkDiameter, seed, angleX, angleY, angleZ, tag, ag, lineHeight);' IT MOVES ONTO THE NEXT BRANCH. AFTER COMPLETING RECURSIONS SEGMENTS OF ARE ROATED AND THEN MOVED ON TOP OF EACH OTHER WITH TOP MOST VERTICES OF THE LOWER TOUCHING AN APPROPRIATE HIGHEST VERTICES ON THE LOWEST.
 SEGMENTS ARE STORED INTO ATTACHMENT GROUPINGS AS A LINKED LIST AND ARE STITCHED TOGETHER IN THE MOVE PROCESS USING THE ANGLES COMPUTED DURING RECURSIONS
 FINALY THE TREE IS GIVEN A SEED BASED RANDOM ROTATION.
 TREEA CAN HAVE TWO TEXTURES. AUTUMN OR SUMMER.
@@ -53,12 +53,6 @@ TEXTURES ARE CREATED WITH A BINARY SWITCH THAT DETERMINS IF THE TEXTURE UV'S V C
 #ifndef COMP371_TREE_A_HPP
 #define COMP371_TREE_A_HPP
 
-#define START_TRUNK 0
-#define TRUNK 2
-#define LEAF 3
-#define END_TRUNK -1
-
-
 #ifdef __APPLE__
 #include <OpenGL/OpenGL.h>
 #include <OpenGL/OpenGL.h>
@@ -76,56 +70,25 @@ TEXTURES ARE CREATED WITH A BINARY SWITCH THAT DETERMINS IF THE TEXTURE UV'S V C
 #include <ctime>
 
 #include "src/TreeRandom.hpp"
-#include "TrunkAB.hpp"
-#include "LeafContainerAB.hpp"
 
 #include "src/entities/Entity.hpp"
 #include "src/entities/DrawableEntity.hpp"
-#include "Tree.hpp"
+#include "BranchingTree.hpp"
 
-class TreeA : public Tree {
+class TreeA : public BranchingTree<TreeAParams> {
 private:
 
 	bool treeLoaded = false;
 	bool treeInit = false;
 	bool isAlien;
 
-    static constexpr int branches = 1;
-    static constexpr int k = 250;
-	static constexpr float widthCut = 0.3;
-	static constexpr int previousRotationCap = 8;
-
-    static constexpr float boostFactor = 0.25;
-    static constexpr int heightChunking = 20;//INVERSE
-
-    static constexpr int minYBranchAngle = 30;
-	static constexpr int maxYBranchAngle = 45;
-	static constexpr int minYTrunkAngle = 0;
-	static constexpr int maxYTrunkAngle = 20;
-
-	static constexpr double trunkRatio = 1.0;
-	static constexpr double branchRatio = 0.850;
-
-	float trunk(float trunkDiameter, const float& seed, float lineHeight);
-	void leafBranch(float trunkDiameter, const float& seed, float lineHeight);
-
-	void initiateMove(AttatchmentGroupings* ag);
-
-	void moveSegments(const int& previousRotation, AttatchmentGroupings* ag);
-
-	void treeSetup(const GLuint& shader_program, float trunkDiameter, const int&);
-
-	void generateTreeA(const int& _case, float trunkDiameter, const float& seed,
-					   float angleX, float angleY, float angleZ,
-					   char tag, AttatchmentGroupings* ag, float lineHeight);
+	void treeSetup(const GLuint& shader_program, float trunkDiameter, const int&, TreeBuildBatch* batch);
 
 	//PUT TEXTURE LOADING IN SEPERATE CLASS. MAKE IT ONLY CALLED ONCE FOR THE FIRST TREE LOADED.
-	void bufferObject(const GLuint& shader_program);
+	void bufferObject(const GLuint& shader_program) override;
 
 protected:
 
-	float limiter = 1;
-
     std::string textureMap;
     int colorType;
 
@@ -133,9 +96,10 @@ protected:
     const std::string textureMap2 = "../textures/TreeATexture - Alternative.jpg";
 public:
 
-	TreeA(const GLuint& shader_program, Entity* entity, float trunkDiameter, const int& seed, bool isAlien);
+	TreeA(const GLuint& shader_program, Entity* entity, float trunkDiameter, const int& seed, bool isAlien,
+	      TreeBuildBatch* batch = nullptr);
 
-	GLuint getTextureId();
+	int getTextureLayer() override;
 	const int getColorType();
 };
 #endif //treeA
\ No newline at end of file
@@ -1,20 +1,17 @@
 #include <cmath>
-#include <src/loadTexture.hpp>
+#include <src/TextureManager.hpp>
 
 #include "Tree.hpp"
 #include "TreeA_Autumn.hpp"
 
-TreeA_Autumn::TreeA_Autumn(const GLuint& shader_program, Entity* entity, float trunkDiameter, const int& seed):
-        TreeA(shader_program, entity, trunkDiameter, seed, false){
+TreeA_Autumn::TreeA_Autumn(const GLuint& shader_program, Entity* entity, float trunkDiameter, const int& seed,
+                           TreeBuildBatch* batch):
+        TreeA(shader_program, entity, trunkDiameter, seed, false, batch){
         textureMap = textureMap2;
 };
 
-GLuint TreeA_Autumn::getTextureId()
+int TreeA_Autumn::getTextureLayer()
 {
-        static GLuint tA_texture = loadTexture(
-                TreeA::textureMap,
-                GL_NEAREST,
-                GL_NEAREST
-        );
-        return tA_texture;
+        static int tA_layer = TextureManager::getMaterialLayer(TreeA::textureMap);
+        return tA_layer;
 }
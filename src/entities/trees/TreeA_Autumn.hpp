@@ -18,7 +18,7 @@ CURRENT LOADING SPEED SUGGESTS THE 4-8 DIAMETER RANGE WILL GENERATE QUICKLY. SOM
 ### THE PROGRAM
 PROGRAM ENTRY POINT IN IN THE CONSTRUCTOR FILE WHERE IT INITIALIZES SUBCLASSES AND SETS SOME BASE PARAMETERS.
 AFTER INITIALIZED THE generateTreeA FUNCTION STARTS TO BUILD THE STARTER TRUNK,
-THEN ENTERS BINARY RECURSIONS OF ITSELF TO GENERATE THE TRUNKS AND LEAVES WHEREUPON REACHING THE BASE CASE AFTER CONSTRUCTING A LEAF '                  generateTreeA(END_TRUNK, trunkDiameter, seed, angleX, angleY, angleZ, tag, ag, lineHeight);' IT MOVES ONTO THE NEXT BRANCH. AFTER COMPLETING RECURSIONS SEGMENTS OF ARE ROATED AND THEN MOVED ON TOP OF EACH OTHER WITH TOP MOST VERTICES OF THE LOWER TOUCHING AN APPROPRIATE HIGHEST VERTICES ON THE LOWEST.
+THEN QUEUES A TASK FOR EACH SHOOT ON THE TREE'S GROWTH STACK (A BINARY RECURSION RUN AS A LOOP, SEE Tree::grow) TO GENERATE THE TRUNKS AND LEAVES WHEREUPON REACHING THE BASE CASE AFTER CONSTRUCTING A LEAF '                  generateTreeA(END_TRUNK, trunkDiameter, seed, angleX, angleY, angleZ, tag, ag, lineHeight);' IT MOVES ONTO THE NEXT BRANCH. AFTER COMPLETING RECURSIONS SEGMENTS OF ARE ROATED AND THEN MOVED ON TOP OF EACH OTHER WITH TOP MOST VERTICES OF THE LOWER TOUCHING AN APPROPRIATE HIGHEST VERTICES ON THE LOWEST.
 SEGMENTS ARE STORED INTO ATTACHMENT GROUPINGS AS A LINKED LIST AND ARE STITCHED TOGETHER IN THE MOVE PROCESS USING THE ANGLES COMPUTED DURING RECURSIONS
 FINALY THE TREE IS GIVEN A SEED BASED RANDOM ROTATION.
 TREEA CAN HAVE TWO TEXTURES. AUTUMN OR SUMMER.
@@ -85,7 +85,8 @@ TEXTURES ARE CREATED WITH A BINARY SWITCH THAT DETERMINS IF THE TEXTURE UV'S V C
 #include "TreeA.hpp"
 class TreeA_Autumn : public TreeA {
 public:
-	TreeA_Autumn(const GLuint& shader_program, Entity* entity, float trunkDiameter, const int& seed);
-    GLuint getTextureId();
+	TreeA_Autumn(const GLuint& shader_program, Entity* entity, float trunkDiameter, const int& seed,
+	             TreeBuildBatch* batch = nullptr);
+    int getTextureLayer() override;
 };
 #endif //treeA
\ No newline at end of file
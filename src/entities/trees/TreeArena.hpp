@@ -0,0 +1,44 @@
+#ifndef PROCEDURALWORLD_TREEARENA_HPP
+#define PROCEDURALWORLD_TREEARENA_HPP
+
+#include <cstddef>
+#include <memory>
+#include <utility>
+#include <vector>
+
+//bump allocator for the records a tree generator links together while it recurses.
+//records are handed out from fixed blocks so they never move and pointers to them stay
+//valid until reset(), which frees nothing and lets the next tree reuse the blocks
+template<class T, size_t blockSize = 64>
+class TreeArena {
+private:
+    std::vector<std::unique_ptr<T[]>> blocks;
+    size_t used = 0;
+public:
+    template<class... Args>
+    T* make(Args&&... args){
+        if (used == blocks.size() * blockSize) {
+            blocks.emplace_back(new T[blockSize]);
+        }
+        T* record = &blocks[used / blockSize][used % blockSize];
+        *record = T(std::forward<Args>(args)...);
+        used++;
+        return record;
+    }
+
+    //every record handed out so far is dead after this
+    void reset(){
+        used = 0;
+    }
+
+    void release(){
+        blocks.clear();
+        used = 0;
+    }
+
+    size_t size() const {
+        return used;
+    }
+};
+
+#endif //PROCEDURALWORLD_TREEARENA_HPP
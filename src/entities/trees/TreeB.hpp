@@ -9,8 +9,8 @@ CREATES TRUNK AND LEAF VECTORS+INDICES WHICH ARE MERGED TOGETHER ARE SENT TO THE
 
 CURRENT LOADING SPEED SUGESTS THE 4-8 DIAMETER RANGE WILL GENERATE QUICKLY. SCALING TO HEIGHTS MAY BE NESCICARY.
 
-PROGRAM ENTRY POINT IN IN THE generateTreeA FUNCTION WHEREIN IT STARTS TO BUILD THE STARTER TRUNK,
-THEN ENTERS BINARY RECURSIONS OF ITSELF TO GENERATE THE TRUNKS AND LEAVES WHEREUPON REACHING THE BASE CASE IN MOVES SEGMENTS OF
+PROGRAM ENTRY POINT IN IN THE generate FUNCTION (BranchingTree.hpp) WHEREIN IT STARTS TO BUILD THE STARTER TRUNK,
+THEN QUEUES A TASK FOR EACH SHOOT ON THE TREE'S GROWTH STACK (A BINARY RECURSION RUN AS A LOOP, SEE Tree::grow) TO GENERATE THE TRUNKS AND LEAVES WHEREUPON REACHING THE BASE CASE IN MOVES SEGMENTS OF
 ONE RECURSION ONTO THE STARTER TRUNK AND PROCEEDS TO DO THE NEXT BRANCH. RECURSIONS SET PARAMETERS OF ANGLES AND SEGMENT WIDTHS
 DECREASING AT A PYTHAGOREAN RATE.
 
@@ -37,12 +37,6 @@ ANGLES COMPUTED DURING RECURSIONS
 #ifndef COMP371_TREE_B_HPP
 #define COMP371_TREE_B_HPP
 
-#define START_TRUNK 0
-#define TRUNK 2
-#define LEAF 3
-#define END_TRUNK -1
-
-
 #ifdef __APPLE__
 #include <OpenGL/OpenGL.h>
 #include <OpenGL/OpenGL.h>
@@ -60,62 +54,29 @@ ANGLES COMPUTED DURING RECURSIONS
 #include <ctime>
 
 #include "src/TreeRandom.hpp"
-#include "TrunkAB.hpp"
-#include "LeafContainerAB.hpp"
 
 #include "src/entities/Entity.hpp"
 #include "src/entities/DrawableEntity.hpp"
-#include "Tree.hpp"
+#include "BranchingTree.hpp"
 
-class TreeB : public Tree {
+class TreeB : public BranchingTree<TreeBParams> {
 private:
 
     //CONSIDERATION FOR MULTITHREADED LOADING
     bool treeLoaded = false;
 
-    const int branches = 1;
-    const int k = 1;
-    float widthCut = 0.325;
-
-    static constexpr float boostFactor = 0.52;
-    static constexpr int heightChunking = 6;//INVERSE
-
-    const int minYBranchAngle = 30;
-    const int maxYBranchAngle = 90;
-    const int minYTrunkAngle = 30;
-    const int maxYTrunkAngle = 90;
-
-    double trunkRatio = 1.0;
-    double branchRatio = 0.850;
-
-
     bool isAlien;
 
-    void generateTreeB(const int& _case, float trunkDiameter, const float& seed,
-                       float angleX, float angleY, float angleZ, char tag,
-                       AttatchmentGroupings* ag, float lineHeight);
+    void bufferObject(const GLuint& shader_program) override;
 
-    float trunk(float trunkDiameter, const float& seed, float lineHeight);
-
-    void leafBranch(float trunkDiameter, const float& seed, float lineHeight);
-
-    void bufferObject(const GLuint& shader_program);
-
-    void initiateMove(AttatchmentGroupings* ag);
-
-    void moveSegments(const int& previousRotation, AttatchmentGroupings* ag);
-
-    bool treeSetup(const GLuint& shader_program, float trunkDiameter, const int& seed);
+    bool treeSetup(const GLuint& shader_program, float trunkDiameter, const int& seed, TreeBuildBatch* batch);
 protected:
     int colorType;
 public:
-    const std::vector<glm::vec3>& getVertices() const override;
-
-    GLuint getVAO() override;
-
-    TreeB(const GLuint& shader_program, Entity* entity, double trunkDiameter, int seed, bool isAlien);
+    TreeB(const GLuint& shader_program, Entity* entity, double trunkDiameter, int seed, bool isAlien,
+          TreeBuildBatch* batch = nullptr);
 
-    GLuint getTextureId() override;
+    int getTextureLayer() override;
     const int getColorType() override;
 };
 #endif //treeA
@@ -0,0 +1,118 @@
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "TreeBuildBatch.hpp"
+#include "Tree.hpp"
+
+void TreeBuildBatch::add(Tree* tree, const TreePrototypeCache::Key& key, const std::function<void(float, int)>& generate){
+    Job job;
+    job.tree = tree;
+    job.key = key;
+    job.generate = generate;
+    jobs.push_back(job);
+}
+
+void TreeBuildBatch::build(unsigned int threads){
+    //a tree buildSome left half grown is finished here, the rest are built as usual
+    if (streamStarted) {
+        size_t unlimited = SIZE_MAX;
+        jobs[streamed].tree->grow(&unlimited);
+        uploadStreamed();
+    }
+    jobs.erase(jobs.begin(), jobs.begin() + streamed);
+    streamed = 0;
+
+    //only the first tree of each key is generated
+    std::map<TreePrototypeCache::Key, size_t> firstOfKey;
+    std::vector<size_t> unique;
+    for (size_t i = 0; i < jobs.size(); i++) {
+        //buildSome may have built the key already
+        jobs[i].tree->prototype = TreePrototypeCache::find(jobs[i].key);
+        if (jobs[i].tree->prototype) continue;
+        if (firstOfKey.insert(std::make_pair(jobs[i].key, i)).second) {
+            unique.push_back(i);
+        }
+    }
+
+    if (threads == 0) threads = std::max(1u, std::thread::hardware_concurrency());
+    threads = (unsigned int)std::min<size_t>(threads, unique.size());
+
+    std::atomic<size_t> next(0);
+    std::exception_ptr error;
+    std::mutex errorMutex;
+    auto work = [&]() {
+        for (size_t n = next++; n < unique.size(); n = next++) {
+            Job& job = jobs[unique[n]];
+            try {
+                job.tree->generatePrototype(job.key, job.generate);
+            } catch (...) {
+                std::lock_guard<std::mutex> lock(errorMutex);
+                if (!error) error = std::current_exception();
+            }
+        }
+    };
+
+    //the calling thread generates too
+    std::vector<std::thread> workers;
+    for (unsigned int i = 1; i < threads; i++) {
+        workers.emplace_back(work);
+    }
+    work();
+    for (std::thread& worker : workers) {
+        worker.join();
+    }
+
+    if (error) {
+        jobs.clear();
+        std::rethrow_exception(error);
+    }
+
+    //gl calls stay on this thread, in the order the trees were queued
+    for (size_t i : unique) {
+        jobs[i].tree->uploadPrototype(jobs[i].key);
+    }
+    for (size_t i = 0; i < jobs.size(); i++) {
+        if (!jobs[i].tree->prototype) {
+            jobs[i].tree->prototype = TreePrototypeCache::find(jobs[i].key);
+        }
+    }
+    jobs.clear();
+}
+
+bool TreeBuildBatch::buildSome(size_t vertexBudget){
+    while (streamed < jobs.size() && vertexBudget > 0) {
+        Job& job = jobs[streamed];
+        if (!streamStarted) {
+            //an earlier job with the same key may have been built since this one was queued
+            job.tree->prototype = TreePrototypeCache::find(job.key);
+            if (job.tree->prototype) {
+                streamed++;
+                continue;
+            }
+            job.tree->beginPrototype(job.key, job.generate);
+            streamStarted = true;
+        }
+        if (!job.tree->grow(&vertexBudget)) break;
+        uploadStreamed();
+    }
+
+    if (streamed < jobs.size()) return false;
+    jobs.clear();
+    streamed = 0;
+    return true;
+}
+
+void TreeBuildBatch::uploadStreamed(){
+    Job& job = jobs[streamed];
+    job.tree->finishPrototype();
+    job.tree->uploadPrototype(job.key);
+    streamStarted = false;
+    streamed++;
+}
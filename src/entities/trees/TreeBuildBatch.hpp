@@ -0,0 +1,45 @@
+#ifndef PROCEDURALWORLD_TREEBUILDBATCH_HPP
+#define PROCEDURALWORLD_TREEBUILDBATCH_HPP
+
+#include <cstddef>
+#include <functional>
+#include <vector>
+
+#include "TreePrototypeCache.hpp"
+
+class Tree;
+
+//collects the trees that missed the prototype cache and generates them together.
+//trees only use their own vectors and TreeBuildContext while generating, so the
+//result is the same as building them one after the other
+class TreeBuildBatch {
+private:
+    struct Job {
+        Tree* tree;
+        TreePrototypeCache::Key key;
+        std::function<void(float, int)> generate;
+    };
+    std::vector<Job> jobs;
+    //jobs before this one are built, see buildSome
+    size_t streamed = 0;
+    bool streamStarted = false;
+
+    void uploadStreamed();
+public:
+    //called by Tree::loadPrototype on a cache miss
+    void add(Tree* tree, const TreePrototypeCache::Key& key, const std::function<void(float, int)>& generate);
+
+    //generates every queued tree on up to threads workers (0 for one per core), then uploads
+    //them on the calling thread which must own the gl context. trees queued with the same key
+    //share one mesh. the trees have no mesh until this returns
+    void build(unsigned int threads = 0);
+
+    //generates the queued trees one at a time on the calling thread until about vertexBudget
+    //vertices were written, uploading each one that finishes. a tree can be left half grown and
+    //carries on from there on the next call, so a frame only pays for its budget. returns true
+    //once every queued tree has its mesh. the queued trees have to stay alive until then.
+    //a tree has its mesh once getPrototype() is set, see WorldTile::buildTrees
+    bool buildSome(size_t vertexBudget);
+};
+
+#endif //PROCEDURALWORLD_TREEBUILDBATCH_HPP
@@ -0,0 +1,11 @@
+#ifndef PROCEDURALWORLD_TREEBUILDCONTEXT_HPP
+#define PROCEDURALWORLD_TREEBUILDCONTEXT_HPP
+
+//state that changes while one tree is generated. every tree owns its own so that
+//trees can be generated on different threads, see TreeBuildBatch
+struct TreeBuildContext {
+    //flips between stacked segments so the texture's v coordinate runs 101 then 010
+    bool constructionFlowCounter = true;
+};
+
+#endif //PROCEDURALWORLD_TREEBUILDCONTEXT_HPP
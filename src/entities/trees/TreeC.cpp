@@ -6,26 +6,31 @@
 #include <src/loadTexture.hpp>
 #include <src/entities/World.hpp>
 #include "TreeC.hpp"
+#include "TreeBuildBatch.hpp"
 
-    int TreeC::spacingConstant = 5;
+    constexpr int TreeC::defaultSpacingConstant;
 
     int TreeC::maxWidth(const float& trunkDiameter){
         return (int)(pow(spacingConstant * (trunkDiameter+1), 1.0/2) + trunkDiameter);
     }
 
     TreeC::TreeC(int numberOfTrees, const GLuint& shader_program, Entity* entity, float trunkDiameter, long seed, bool isAlien,
-                 std::vector<Tree*>& treeContainer, glm::vec3 pos, float magnitude,
-                    float min_hitbox_y, float max_hitbox_y, std::vector<HitBox2d>& hbEnt){
+                 std::vector<Tree*>& treeContainer, TileArena& arena, TreeBuildBatch& batch, glm::vec3 pos,
+                 float magnitude, int spacingConstant){
+        this->spacingConstant = spacingConstant;
 
+        //the items live as long as the rest of the tile
+        auto makeItem = [&](float itemDiameter, long itemSeed) {
+            return arena.make<TreeClusterItem>(shader_program, entity, itemDiameter, itemSeed, isAlien, &batch);
+        };
 
         //center piece
-        auto * tci = new TreeClusterItem(shader_program, entity, trunkDiameter, seed, isAlien);
+        auto * tci = makeItem(trunkDiameter, seed);
         tci->setLocationWithPoints(0, 0);
         tci->setPosition(pos + glm::vec3(tci->xPos, 0, tci->zPos));
         tci->scale(magnitude);
 
-        treeContainer.emplace_back(tci);
-        hbEnt.emplace_back(*tci, min_hitbox_y, max_hitbox_y);
+        treeContainer.push_back(tci);
 
         //distribute in random cirlce
         float tempTrunkDiameter;
@@ -46,23 +51,15 @@
             float xPos = cos(glm::radians(circleAngle)) * distanceFromCenter * distScale;
             float zPos =  sin(glm::radians(circleAngle)) * distanceFromCenter * distScale;
 
-            auto * tci = new TreeClusterItem(shader_program, entity,
-                                                       tempTrunkDiameter <= 0? 0:  tempTrunkDiameter,
-                                                       seed, isAlien);
+            auto * tci = makeItem(tempTrunkDiameter <= 0? 0:  tempTrunkDiameter, seed);
 
             tci->setLocationWithPoints(xPos , zPos);
             tci->setPosition(pos + glm::vec3(tci->xPos + 0.05, 0.0, tci->zPos));
             tci->scale(magnitude);
 
-            treeContainer.emplace_back(tci);
-            hbEnt.emplace_back(*tci, min_hitbox_y, max_hitbox_y);
+            treeContainer.push_back(tci);
         }
     }
 
 
-    void TreeC::setSpacingConstant(int k){
-        TreeC::spacingConstant = k;
-    }
-
-
 #endif
\ No newline at end of file
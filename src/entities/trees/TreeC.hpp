@@ -21,9 +21,11 @@
 
 
 #include "src/entities/DrawableEntity.hpp"
+#include "src/entities/TileArena.hpp"
 #include "Tree.hpp"
 #include "TreeClusterItem.hpp"
 #include "src/TreeRandom.hpp"
+#include "TreeBuildBatch.hpp"
 
 class TreeC{
 private:
@@ -32,17 +34,18 @@ private:
     static constexpr float sizeVariation = 1.2;
     static constexpr int heightChunking = 0;
     static constexpr int boostFactor = 0;
-    static int spacingConstant;
+    int spacingConstant;
     int maxWidth(const float& trunkDiameter);
 
 public:
+    static constexpr int defaultSpacingConstant = 5;
 
+    //adds the cluster's trees to treeContainer. the trees are made in arena and go with it.
+    //the ones the prototype cache doesn't have yet are queued in batch and have no mesh until it builds them
     TreeC(int numberOfTrees, const GLuint& shader_program,
           Entity* entity, float trunkDiameter, long seed, bool isAlien,
-            std::vector<Tree*>& treeContainer, glm::vec3 pos, float magnitude,
-          float min_hitbox_y, float max_hitbox_y, std::vector<HitBox2d>& hbEnt);
-
-    static void setSpacingConstant(int k);
+            std::vector<Tree*>& treeContainer, TileArena& arena, TreeBuildBatch& batch, glm::vec3 pos,
+          float magnitude, int spacingConstant = defaultSpacingConstant);
 
 };
 #endif
\ No newline at end of file
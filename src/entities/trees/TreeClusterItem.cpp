@@ -9,7 +9,7 @@
 #include <cstdio>
 #include <ctime>
 #include <cmath>
-#include <src/loadTexture.hpp>
+#include <src/TextureManager.hpp>
 
 constexpr int TreeClusterItem::branches;
 constexpr float TreeClusterItem::zeroSize;
@@ -23,8 +23,12 @@ constexpr int TreeClusterItem::leafPoints;
 
 constexpr double TreeClusterItem::trunkRatio;
 constexpr double TreeClusterItem::branchRatio;
+constexpr float TreeClusterItem::vertexScale;
+constexpr float TreeClusterItem::vertexExponent;
+constexpr float TreeClusterItem::indicesPerVertex;
 
-TreeClusterItem::TreeClusterItem (const GLuint& shader_program, Entity* entity, float trunkDiameter, float seed, bool isAlien):
+TreeClusterItem::TreeClusterItem (const GLuint& shader_program, Entity* entity, float trunkDiameter, float seed, bool isAlien,
+                                  TreeBuildBatch* batch):
     Tree(heightChunking, boostFactor,seed, shader_program, entity, 'G'){
 
     if (trunkDiameter <= 0.0) trunkDiameter = this->zeroSize;
@@ -37,7 +41,7 @@ TreeClusterItem::TreeClusterItem (const GLuint& shader_program, Entity* entity,
 
     seed = TreeRandom::treeRandom(trunkDiameter, seed, 991);
 
-    treeLoaded = treeSetup(shader_program, trunkDiameter, seed);
+    treeLoaded = treeSetup(shader_program, trunkDiameter, seed, batch);
 
     float globalRotation = TreeRandom::treeRandom(trunkDiameter,seed,widthCut*100);
     rotate(globalRotation, glm::vec3(0.0f,1.0f,0.0f));
@@ -45,23 +49,59 @@ TreeClusterItem::TreeClusterItem (const GLuint& shader_program, Entity* entity,
 };
 
 
-bool TreeClusterItem::treeSetup(const GLuint& shader_program, const float& trunkDiameter, const float& seed){
+Tree::MeshEstimate TreeClusterItem::estimateMesh(const float& trunkDiameter) const {
+    const size_t vertices = (size_t)(vertexScale * std::pow(trunkDiameter, vertexExponent));
+    return {vertices, (size_t)(vertices * indicesPerVertex), 0};
+}
+
+bool TreeClusterItem::treeSetup(const GLuint& shader_program, const float& trunkDiameter, const float& seed, TreeBuildBatch* batch){
     draw_mode = GL_TRIANGLES;
     //widthCutoff
     finalCutoff = widthCutoff;
-    combinedStartIndices.push_back({-1,0,0,0});
-    generateTreeCI(0, trunkDiameter, seed, 0, 0, 0, 'C', nullptr, 0);
-    bufferObject(shader_program);
+    loadPrototype(TreePrototypeCache::makeKey('C', trunkDiameter, (long)seed, isAlien, !isAlien), trunkDiameter,
+                  [this](float prototypeDiameter, int prototypeSeed){
+        combinedStartIndices.push_back({-1,0,0,0});
+        pushTask(START_TRUNK, prototypeDiameter, prototypeSeed, 0, 0, 0, 'C', nullptr, 0);
+    }, batch);
     rotate(TreeRandom::treeRandom(trunkDiameter, seed,100), glm::vec3(0.0f,1.0f,0.0f));
     return true;
 }
 
+size_t TreeClusterItem::growTask(const GrowthTask& task){
+    const size_t before = combinedVertices.size();
+    switch (task._case)
+    {
+        case FLIP_FLOW:
+            buildContext.constructionFlowCounter=!buildContext.constructionFlowCounter;
+            return 0;
+        case LEAVE_TRUNK:
+            //what the end of a trunk call used to undo once its shoots had returned
+            k += kReduction;
+            depth--;
+            boostFactor += boostReduction;
+            return 0;
+        case START_MOVE:
+            return initiateMove(task.ag);
+        case MOVE_SEGMENT:
+            return moveSegment(task.ag, task.branch);
+        default:
+            generateTreeCI(task._case, task.trunkDiameter, task.seed, task.angleX, task.angleY, task.angleZ,
+                           task.tag, task.ag, task.lineHeight);
+            return combinedVertices.size() - before;
+    }
+}
+
+void TreeClusterItem::queueFlip(){
+    pushTask(FLIP_FLOW, 0, 0, 0, 0, 0, 0, nullptr, 0);
+}
+
 void TreeClusterItem::generateTreeCI(const int& _case, float trunkDiameter, const float& seed,
                                      float angleX, float angleY, float angleZ,
                                      char tag, AttatchmentGroupings* ag, float lineHeight){
     float currentLineLength = lineHeight;
     float offShootDiameterBranch = 0;
     float offShootDiameterTrunk = 0;
+    bool split;
     glm::mat4 rotation;
     glm::vec3 translation;
     AttatchmentGroupings* agNew;
@@ -76,7 +116,7 @@ void TreeClusterItem::generateTreeCI(const int& _case, float trunkDiameter, cons
             currentLineLength = trunk(trunkDiameter, seed, currentLineLength);
             combinedStartIndices.push_back({ (int)combinedVertices.size() - 1, (int)angleX, (int)angleY, (int)angleZ});
 
-            agNew = new AttatchmentGroupings(combinedStartIndices.at((int)combinedStartIndices.size() - 2).at(0),
+            agNew = branchArena.make(combinedStartIndices.at((int)combinedStartIndices.size() - 2).vertex,
                                              (int)combinedVertices.size() - 1,
                                              (int)angleX, (int)angleY, (int)angleZ, 'B', tag);
 
@@ -84,31 +124,26 @@ void TreeClusterItem::generateTreeCI(const int& _case, float trunkDiameter, cons
             offShootDiameterBranch = shootCalculation(trunkDiameter, branchRatio, branches);
             offShootDiameterTrunk = shootCalculation(trunkDiameter, trunkRatio, branches);
 
+            //queued last first: the branches run, then the trunk, then everything is moved into place
+            depth = 0;
+            previousRotation = 0;
+            pushMove(START_MOVE, agNew, 0, 0);
+
             //1A6. On new branch create junction and new shoot
             angleY = TreeRandom::treeOddEvenRandom(trunkDiameter, seed* ( 1) * 3, (lineHeight+1)* ( 1));
-            for (int n = 0; n < branches; n++) {
+            //1A7. On new trunk join to junction and continue
+            angleZ = TreeRandom::trunkAngleFromRandom(trunkDiameter, seed* 71, currentLineLength, maxYTrunkAngle, minYTrunkAngle); ;
+            angleX = TreeRandom::trunkAngleFromRandom(trunkDiameter, seed* 71, currentLineLength, maxYTrunkAngle, minYTrunkAngle);; //* (((int)seed) % 2 == 0 ? 1 : -1);
+            queueFlip();
+            pushTask(TRUNK, offShootDiameterTrunk, seed, std::abs(angleX), angleY, -std::abs(angleZ), 'L', agNew, currentLineLength);
+            for (int n = branches - 1; n >= 0; n--) {
                 angleZ = TreeRandom::branchAngleFromRandom(trunkDiameter, seed * (n+1), currentLineLength* (n + 1),
                                                            maxYBranchAngle, minYBranchAngle);
                 angleX = TreeRandom::branchAngleFromRandom(trunkDiameter, seed* (n + 1) * 7, currentLineLength * (n + 1),
                                                            maxYBranchAngle, minYBranchAngle); //* (((int)seed) % 2 == 0 ? -1 : 1);
-                angleY = angleY;
-                depth = 0;
-                generateTreeCI(TRUNK, offShootDiameterBranch / (branches), seed, -std::abs(angleX), angleY, std::abs(angleZ), 'R', agNew, 0);
-                TrunkC::constructionFlowCounter=!TrunkC::constructionFlowCounter;
+                queueFlip();
+                pushTask(TRUNK, offShootDiameterBranch / (branches), seed, -std::abs(angleX), angleY, std::abs(angleZ), 'R', agNew, 0);
             }
-            //1A7. On new trunk join to junction and continue
-            angleZ = TreeRandom::trunkAngleFromRandom(trunkDiameter, seed* 71, currentLineLength, maxYTrunkAngle, minYTrunkAngle); ;
-            angleX = TreeRandom::trunkAngleFromRandom(trunkDiameter, seed* 71, currentLineLength, maxYTrunkAngle, minYTrunkAngle);; //* (((int)seed) % 2 == 0 ? 1 : -1);
-            angleY = angleY;
-            depth = 0;
-            previousRotation = 0;
-            //CONSIDERATION: MULTITHREAD THE TRUNK AND MOVEMENT
-            generateTreeCI(TRUNK, offShootDiameterTrunk, seed, std::abs(angleX), angleY, -std::abs(angleZ), 'L', agNew, currentLineLength);
-            TrunkC::constructionFlowCounter=!TrunkC::constructionFlowCounter;
-            initiateMove(agNew);
-            agNew->selfErase();
-            delete agNew;
-
             break;
         case TRUNK:
             k -= kReduction;
@@ -116,6 +151,7 @@ void TreeClusterItem::generateTreeCI(const int& _case, float trunkDiameter, cons
             boostFactor -= boostReduction;
             kill = false;
             if (trunkDiameter < widthCutoff) {
+                //a leaf ends its branch, so it's built right away instead of queued
                 generateTreeCI(LEAF, trunkDiameter, seed, angleX, angleY, angleZ, tag, ag, 0);
                 if (trunkDiameter < finalCutoff) {
                     k += kReduction;
@@ -138,14 +174,15 @@ void TreeClusterItem::generateTreeCI(const int& _case, float trunkDiameter, cons
             combinedStartIndices.push_back({ (int)combinedVertices.size() - 1, (int)angleX, (int)angleY, (int)angleZ });
 
             //store current branch poosition and rotation sum at depth
-            agNew = new AttatchmentGroupings(combinedStartIndices.at((int)combinedStartIndices.size() - 2).at(0),
+            agNew = branchArena.make(combinedStartIndices.at((int)combinedStartIndices.size() - 2).vertex,
                                              (int)combinedVertices.size() - 1, (int)angleX, (int)angleY, (int)angleZ, 'B', tag);
             if (tag == 'R') ag->ag[1] = agNew;
             else			ag->ag[0] = agNew;
 
-            //1A5. Start N new recursive functions from seed based angle at a certain base position
+            //1A5. Start N new shoots from seed based angle at a certain base position, queued last first
             angleY = TreeRandom::treeRandom(trunkDiameter, seed * 5, lineHeight);
-            if (lineHeight == -1 || currentLineLength == -1) {
+            split = lineHeight == -1 || currentLineLength == -1;
+            if (split) {
                 //if(//Test)//("====SPLIT====\n");
                 offShootDiameterTrunk = shootCalculation(trunkDiameter, trunkRatio, branches);
                 lineHeight = 0; currentLineLength = 0;
@@ -153,27 +190,26 @@ void TreeClusterItem::generateTreeCI(const int& _case, float trunkDiameter, cons
             else{
                 offShootDiameterBranch = shootCalculation(trunkDiameter, branchRatio, branches);
                 offShootDiameterTrunk = shootCalculation(trunkDiameter, trunkRatio, branches);
+            }
+            pushTask(LEAVE_TRUNK, 0, 0, 0, 0, 0, 0, nullptr, 0);
+
+            //1A7. On new trunk create circle then indices flowing back once to top circle.
+            angleZ = TreeRandom::trunkAngleFromRandom(trunkDiameter, seed, currentLineLength, maxYTrunkAngle, minYTrunkAngle);;
+            angleX = TreeRandom::trunkAngleFromRandom(trunkDiameter, seed * 7, currentLineLength, maxYTrunkAngle, minYTrunkAngle) * (((int)seed) % 2 == 0 ? -1 : 1);;
+            queueFlip();
+            pushTask(TRUNK, offShootDiameterTrunk, seed, std::abs(angleX), angleY, -std::abs(angleZ), 'L', agNew, currentLineLength);
+
+            if (!split) {
                 for (int n = 0; n < branches; n++) {
                     //1A6. On new branch create circle then indices flowing back once to center cirlce.
                     angleZ = TreeRandom::branchAngleFromRandom(trunkDiameter, seed, currentLineLength,
                                                                maxYBranchAngle, minYBranchAngle);
                     angleX = TreeRandom::branchAngleFromRandom(trunkDiameter, seed, currentLineLength,
                                                                maxYBranchAngle, minYBranchAngle) * (((int)seed) % 2 == 0 ? -1 : 1);;
-                    angleY = angleY;
-                    generateTreeCI(TRUNK, offShootDiameterBranch, seed, -std::abs(angleX), angleY, std::abs(angleZ), 'R', agNew, 0);
-                    TrunkC::constructionFlowCounter=!TrunkC::constructionFlowCounter;
+                    queueFlip();
+                    pushTask(TRUNK, offShootDiameterBranch, seed, -std::abs(angleX), angleY, std::abs(angleZ), 'R', agNew, 0);
                 }
             }
-
-            //1A7. On new trunk create circle then indices flowing back once to top circle.
-            angleZ = TreeRandom::trunkAngleFromRandom(trunkDiameter, seed, currentLineLength, maxYTrunkAngle, minYTrunkAngle);;
-            angleX = TreeRandom::trunkAngleFromRandom(trunkDiameter, seed * 7, currentLineLength, maxYTrunkAngle, minYTrunkAngle) * (((int)seed) % 2 == 0 ? -1 : 1);;
-            angleY = angleY;
-            generateTreeCI(TRUNK, offShootDiameterTrunk, seed, std::abs(angleX), angleY, -std::abs(angleZ), 'L', agNew, currentLineLength);
-            TrunkC::constructionFlowCounter=!TrunkC::constructionFlowCounter;
-            k += kReduction;
-            depth--;
-            boostFactor += boostReduction;
             break;
         case LEAF:
             //1B. If trunk width is past a threshold then create a leaf line
@@ -191,7 +227,7 @@ void TreeClusterItem::generateTreeCI(const int& _case, float trunkDiameter, cons
             combinedStartIndices.push_back({ (int)combinedVertices.size() - 1,(int)angleX,(int)angleY,(int)angleZ });
 
             //add to grouping at depth
-            agNew = new AttatchmentGroupings(combinedStartIndices.at((int)combinedStartIndices.size() - 2).at(0),
+            agNew = branchArena.make(combinedStartIndices.at((int)combinedStartIndices.size() - 2).vertex,
                                              (int)combinedVertices.size() - 1, (int)angleX, (int)angleY, (int)angleZ, 'L', tag);
             if (tag == 'R') ag->ag[1] = agNew;
             else			ag->ag[0] = agNew;
@@ -210,88 +246,57 @@ void TreeClusterItem::generateTreeCI(const int& _case, float trunkDiameter, cons
 
 float TreeClusterItem::trunk(const float& trunkDiameter, const float& seed, float lineHeight) {
     const float lineMax = lineMAX(trunkDiameter, k);
-    TrunkC tC(&combinedVertices, &combinedUV, &combinedNormals, &combinedIndices, lineMax, 530.0f/800.0);
+    TrunkC tC(&combinedVertices, &combinedUV, &combinedNormals, &combinedIndices, lineMax, 530.0f/800.0, &buildContext);
     return tC.buildAllComponents(trunkDiameter, seed, lineHeight);
 }
 
 void TreeClusterItem::leafBranch(const float& trunkDiameter, const float& seed, float lineHeight) {
     const float lineMax = lineMAX(trunkDiameter, k);
 
-    LeafContainerC lcC(&combinedVertices, &combinedUV, &combinedNormals, &combinedIndices, lineMax, 530.0f/800.0);
+    LeafContainerC lcC(&combinedVertices, &combinedUV, &combinedNormals, &combinedIndices, lineMax, 530.0f/800.0, &buildContext);
     lcC.buildAllComponenets(trunkDiameter, widthCutoff,  seed, lineHeight);
 }
-void TreeClusterItem::initiateMove(AttatchmentGroupings* ag){
+size_t TreeClusterItem::initiateMove(AttatchmentGroupings* ag){
      int start = ag->start + 1;
     int max = ag->end + 1;
-    for (int k = start; k < max; k++) {
-        combinedVertices.at(k)  = makeRotations(glm::radians((float)ag->angleX), glm::radians(0.0f),
-                                                 glm::radians((float)ag->angleZ), combinedVertices.at(k));
-    }
-    moveSegments(0, ag);
-    return;
+    transformSegment(makeRotations(glm::radians((float)ag->angleX), glm::radians(0.0f), glm::radians((float)ag->angleZ)),
+                     glm::vec3(0.0f), start, max);
+    pushMove(MOVE_SEGMENT, ag, 1, 0);
+    pushMove(MOVE_SEGMENT, ag, 0, 0);
+    return max - start;
 }
 
-void TreeClusterItem::moveSegments(int rotationPoint, AttatchmentGroupings* ag){
-    for (int m = 0; m < 2; m++) {
-        if (ag->ag[m] == nullptr) continue;
-
-        int moveTo = 0;
-        int moveFrom = 0;
-
-        const int circularPoints = ag->ag[m]->type == 'L' ? leafPoints : trunkPoints;
-        if (ag->ag[m]->side == 'L') {
-            moveTo = (ag->end - circularPoints + 1) + 2;
-            moveFrom = (ag->ag[m]->start + 1) + 2;
-        }
-        else {
-            moveTo = (ag->end - circularPoints + 1);
-            moveFrom = (ag->ag[m]->start + 1) ;
-        }
-
-        if (ag->ag[m]->type == 'B') {
-            const int start = ag->ag[m]->start + 1;
-            const  int max = ag->ag[m]->end + 1;
-            for (int k = start; k < max; k++) {
-                combinedVertices.at(k) = makeRotations(glm::radians(
-                        (float)ag->ag[m]->angleX), -glm::radians(0.0f), glm::radians((float)ag->ag[m]->angleZ),
-                                                        combinedVertices.at(k));
-            }
-        }
-        else {
-            const int start = ag->ag[m]->start + 1;
-            const int max = ag->ag[m]->end + 1;
-            for (int k = start; k < max; k++) {
-                combinedVertices.at(k) = makeRotations(glm::radians((float)ag->ag[m]->angleX), -glm::radians(0.0f),
-                                                       glm::radians((float)ag->ag[m]->angleZ),
-                                                        combinedVertices.at(k));
-            }
-        }
-
-        //translate components onto branch(destination - position)
-        glm::vec3 translation = combinedVertices.at(moveTo) - combinedVertices.at(moveFrom);
-        glm::vec3 boost = glm::vec3();
-        if(trunkDiameter > this->zeroSize){
-            boost = boostSegment(ag,ag->ag[m], &combinedVertices);
-        }
-
-        if (ag->ag[m]->type == 'B') {
-            int start = ag->ag[m]->start + 1;
-            int max = ag->ag[m]->end + 1;
-            for (int k = start; k < max; k++) {
-                combinedVertices.at(k) += translation + boost;
-            }
-        }
-        else {
-            int start = ag->ag[m]->start + 1;
-            int max = ag->ag[m]->end + 1;
-            for (int k = start; k < max; k++) {
-                combinedVertices.at(k) += translation + boost;
-            }
-        }
-        connectSegments(ag, m);
-        moveSegments(0, ag->ag[m]);
+size_t TreeClusterItem::moveSegment(AttatchmentGroupings* ag, const int& m){
+    if (ag->ag[m] == nullptr) return 0;
+
+    int moveTo = 0;
+    int moveFrom = 0;
+
+    const int circularPoints = ag->ag[m]->type == 'L' ? leafPoints : trunkPoints;
+    if (ag->ag[m]->side == 'L') {
+        moveTo = (ag->end - circularPoints + 1) + 2;
+        moveFrom = (ag->ag[m]->start + 1) + 2;
+    }
+    else {
+        moveTo = (ag->end - circularPoints + 1);
+        moveFrom = (ag->ag[m]->start + 1) ;
+    }
+
+    const glm::mat3 rotation = makeRotations(glm::radians((float)ag->ag[m]->angleX), -glm::radians(0.0f),
+                                             glm::radians((float)ag->ag[m]->angleZ));
+
+    //translate components onto branch(destination - position)
+    glm::vec3 translation = combinedVertices.at(moveTo) - rotateVertex(rotation, combinedVertices.at(moveFrom));
+    glm::vec3 boost = glm::vec3();
+    if(trunkDiameter > this->zeroSize){
+        boost = boostSegment(ag,ag->ag[m], rotation, &combinedVertices);
     }
-    return;
+
+    transformSegment(rotation, translation + boost, ag->ag[m]->start + 1, ag->ag[m]->end + 1);
+    connectSegments(ag, m);
+    pushMove(MOVE_SEGMENT, ag->ag[m], 1, 0);
+    pushMove(MOVE_SEGMENT, ag->ag[m], 0, 0);
+    return ag->ag[m]->end - ag->ag[m]->start;
 }
 
 void TreeClusterItem::connectSegments(AttatchmentGroupings* ag, const int& m){
@@ -356,13 +361,10 @@ float TreeClusterItem::getTrunkDiameter(){
     return trunkDiameter;
 }
 
-GLuint TreeClusterItem::getTextureId()
+int TreeClusterItem::getTextureLayer()
 {
-    static GLuint tC_texture = loadTexture( textureMap,
-            GL_NEAREST,
-            GL_LINEAR
-    );
-    return tC_texture;
+    static int tC_layer = TextureManager::getMaterialLayer(textureMap);
+    return tC_layer;
 }
 const int TreeClusterItem::getColorType() {
     return colorType;
@@ -10,6 +10,10 @@
 #define TRUNK 2
 #define LEAF 3
 #define END_TRUNK -1
+#define FLIP_FLOW 4
+#define START_MOVE 5
+#define MOVE_SEGMENT 6
+#define LEAVE_TRUNK 7
 
 #ifdef __APPLE__
 #include <OpenGL/OpenGL.h>
@@ -55,6 +59,11 @@ private:
     static constexpr double trunkRatio = 1.0;
     static constexpr double branchRatio = 0.850;
 
+    //mesh size fitted from generated items, 3.3k vertices at diameter 0.64, 18.5k at 1.95
+    static constexpr float vertexScale = 7600;
+    static constexpr float vertexExponent = 1.5;
+    static constexpr float indicesPerVertex = 4.05;
+
     int depth = 0;
     float trunkDiameter;
     int previousRotation;
@@ -74,15 +83,22 @@ private:
 
     void leafBranch(const float& trunkDiameter, const float& seed, float lineHeight);
 
-    void initiateMove(AttatchmentGroupings* ag);
+    size_t initiateMove(AttatchmentGroupings* ag);
+
+    //moves ag's child m onto the end of ag and queues the child's own children
+    size_t moveSegment(AttatchmentGroupings* ag, const int& m);
 
-    void moveSegments(int rotationPoint, AttatchmentGroupings* ag);
+    size_t growTask(const GrowthTask& task) override;
+
+    void queueFlip();
 
     void connectSegments(AttatchmentGroupings* ag, const int& m);
 
-    void bufferObject(const GLuint& shader_program);
+    void bufferObject(const GLuint& shader_program) override;
+
+    MeshEstimate estimateMesh(const float& trunkDiameter) const override;
 
-    bool treeSetup(const GLuint& shader_program, const float& trunkDiameter, const float& seed);
+    bool treeSetup(const GLuint& shader_program, const float& trunkDiameter, const float& seed, TreeBuildBatch* batch);
 
 public:
 
@@ -95,9 +111,10 @@ public:
 
     float getTrunkDiameter();
 
-    TreeClusterItem(const GLuint& shader_program, Entity* entity, float trunkDiameter, float seed, bool isAlien);
+    TreeClusterItem(const GLuint& shader_program, Entity* entity, float trunkDiameter, float seed, bool isAlien,
+                    TreeBuildBatch* batch = nullptr);
 
-    GLuint getTextureId();
+    int getTextureLayer() override;
     const int getColorType();
 };
 
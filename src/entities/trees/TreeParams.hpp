@@ -0,0 +1,109 @@
+#ifndef PROCEDURALWORLD_TREEPARAMS_HPP
+#define PROCEDURALWORLD_TREEPARAMS_HPP
+
+//the constants that tell the branching tree species apart, see BranchingTree.
+//a new species is a new set of these plus a small subclass for its textures
+
+//tall hardwood, branches straighten out further up and the trunk keeps going through every junction
+struct TreeAParams {
+    static constexpr int branches = 1;
+    static constexpr int k = 250;
+    static constexpr float widthCut = 0.3;
+    static constexpr int previousRotationCap = 8;
+
+    static constexpr float boostFactor = 0.25;
+    static constexpr int heightChunking = 20;//INVERSE
+
+    static constexpr int minYBranchAngle = 30;
+    static constexpr int maxYBranchAngle = 45;
+    static constexpr int minYTrunkAngle = 0;
+    static constexpr int maxYTrunkAngle = 20;
+
+    static constexpr double trunkRatio = 1.0;
+    static constexpr double branchRatio = 0.850;
+
+    //mesh size fitted from generated trees, vertices = vertexScale * diameter^vertexExponent.
+    //6.4k vertices at diameter 4.8, 49k at 18. leaves are instances, not vertices
+    static constexpr float vertexScale = 680;
+    static constexpr float vertexExponent = 1.5;
+    static constexpr float indicesPerVertex = 6.0;
+    static constexpr float leavesPerVertex = 0.39;
+
+    //a junction grows the branches and then continues the trunk
+    static constexpr bool continueTrunk = true;
+    //where the texture's v sequence flips besides between segments
+    static constexpr bool flipAroundBranches = false;
+    static constexpr bool flipEachTrunkRing = false;
+    static constexpr bool flipAfterTrunk = false;
+    static constexpr bool flipAroundLeaves = false;
+    //bush like twisting, segments are stacked on the outside of the one below
+    static constexpr bool shrubMove = false;
+};
+
+//bush, lots of inward turning
+struct TreeBParams {
+    static constexpr int branches = 1;
+    static constexpr int k = 1;
+    static constexpr float widthCut = 0.325;
+    static constexpr int previousRotationCap = 0;
+
+    static constexpr float boostFactor = 0.52;
+    static constexpr int heightChunking = 6;//INVERSE
+
+    static constexpr int minYBranchAngle = 30;
+    static constexpr int maxYBranchAngle = 90;
+    static constexpr int minYTrunkAngle = 30;
+    static constexpr int maxYTrunkAngle = 90;
+
+    static constexpr double trunkRatio = 1.0;
+    static constexpr double branchRatio = 0.850;
+
+    //mesh size fitted from generated trees, vertices = vertexScale * diameter^vertexExponent.
+    //900 vertices at diameter 2, 8.5k at 7.5
+    static constexpr float vertexScale = 430;
+    static constexpr float vertexExponent = 1.5;
+    static constexpr float indicesPerVertex = 6.0;
+    static constexpr float leavesPerVertex = 0.35;
+
+    static constexpr bool continueTrunk = true;
+    static constexpr bool flipAroundBranches = false;
+    static constexpr bool flipEachTrunkRing = true;
+    static constexpr bool flipAfterTrunk = true;
+    static constexpr bool flipAroundLeaves = true;
+    static constexpr bool shrubMove = true;
+};
+
+//alien biome, only branches so every junction splits off and nothing continues straight
+struct TentacleParams {
+    static constexpr int branches = 1;
+    static constexpr int k = 250;
+    static constexpr float widthCut = 0.5;
+    static constexpr int previousRotationCap = 8;
+
+    static constexpr float boostFactor = 0.25;//0.5;
+    static constexpr int heightChunking = 20;//INVERSE
+
+    static constexpr int minYBranchAngle = 30;
+    static constexpr int maxYBranchAngle = 45;
+    static constexpr int minYTrunkAngle = 0;
+    static constexpr int maxYTrunkAngle = 20;
+
+    static constexpr double trunkRatio = 1.0;
+    static constexpr double branchRatio = 0.850;
+
+    //mesh size fitted from generated trees, vertices = vertexScale * diameter^vertexExponent.
+    //about 100 vertices and 17 leaves whatever the diameter
+    static constexpr float vertexScale = 100;
+    static constexpr float vertexExponent = 0.1;
+    static constexpr float indicesPerVertex = 5.8;
+    static constexpr float leavesPerVertex = 0.19;
+
+    static constexpr bool continueTrunk = false;
+    static constexpr bool flipAroundBranches = true;
+    static constexpr bool flipEachTrunkRing = true;
+    static constexpr bool flipAfterTrunk = false;
+    static constexpr bool flipAroundLeaves = false;
+    static constexpr bool shrubMove = false;
+};
+
+#endif //PROCEDURALWORLD_TREEPARAMS_HPP
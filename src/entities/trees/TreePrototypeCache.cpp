@@ -0,0 +1,352 @@
+#ifdef __APPLE__
+#include <OpenGL/gl3.h>
+#include <OpenGL/gl3ext.h>
+#else
+#include <GL/glew.h> // include GL Extension Wrangler
+#endif
+
+#include <glm/glm.hpp>
+#include <glm/gtc/type_ptr.hpp>
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <map>
+#include <utility>
+#include <vector>
+
+#include "TreePrototypeCache.hpp"
+#include "Tree.hpp"
+#include "LeafAB.hpp"
+#include "LeafContainerAB.hpp"
+
+constexpr GLenum TreePrototypeCache::leaf_texture_unit;
+constexpr float TreePrototypeCache::diameter_ratio;
+constexpr float TreePrototypeCache::min_diameter;
+constexpr int TreePrototypeCache::seed_classes;
+constexpr size_t TreePrototypeCache::max_idle_prototypes;
+
+std::map<TreePrototypeCache::Key, TreePrototypeCache::Entry> TreePrototypeCache::prototypes;
+unsigned long TreePrototypeCache::use_counter = 0;
+unsigned long TreePrototypeCache::hits = 0;
+unsigned long TreePrototypeCache::misses = 0;
+size_t TreePrototypeCache::saved_bytes = 0;
+double TreePrototypeCache::saved_ms = 0.0;
+std::vector<Tree*> TreePrototypeCache::instances;
+std::vector<glm::mat4> TreePrototypeCache::instance_matrices;
+GLuint TreePrototypeCache::instance_buffer = 0;
+size_t TreePrototypeCache::instance_capacity = 0;
+GLuint TreePrototypeCache::leaf_vao = 0;
+GLuint TreePrototypeCache::leaf_buffers[4] = {0, 0, 0, 0};
+
+TreePrototype::~TreePrototype()
+{
+	glDeleteBuffers(1, &this->vertex_buffer);
+	glDeleteBuffers(1, &this->element_buffer);
+	glDeleteBuffers(1, &this->normal_buffer);
+	glDeleteBuffers(1, &this->uv_buffer);
+	glDeleteBuffers(1, &this->leaf_buffer);
+	glDeleteTextures(1, &this->leaf_texture);
+	glDeleteVertexArrays(1, &this->vao);
+}
+
+bool TreePrototypeCache::Key::operator<(const Key& other) const
+{
+	if (type != other.type) return type < other.type;
+	if (diameter_step != other.diameter_step) return diameter_step < other.diameter_step;
+	if (seed_class != other.seed_class) return seed_class < other.seed_class;
+	if (alien != other.alien) return alien < other.alien;
+	return textured < other.textured;
+}
+
+TreePrototypeCache::Key TreePrototypeCache::makeKey(
+		const char& type,
+		const float& trunk_diameter,
+		const long& seed,
+		const bool& alien,
+		const bool& textured
+) {
+	// the log of 0 or less isn't a step, written so that NaN is clamped too
+	const float diameter = trunk_diameter > min_diameter ? trunk_diameter : min_diameter;
+	Key key;
+	key.type = type;
+	key.diameter_step = (int)std::lround(std::log(diameter) / std::log(diameter_ratio));
+	key.seed_class = (int)(std::labs(seed) % seed_classes);
+	key.alien = alien;
+	key.textured = textured;
+	return key;
+}
+
+float TreePrototypeCache::getDiameter(const Key& key)
+{
+	return std::pow(diameter_ratio, (float)key.diameter_step);
+}
+
+int TreePrototypeCache::getSeed(const Key& key)
+{
+	// large enough that TreeRandom doesn't collapse to a handful of values
+	return 1000 + key.seed_class * 37;
+}
+
+TreePrototypeHandle TreePrototypeCache::find(const Key& key)
+{
+	auto it = prototypes.find(key);
+	if (it == prototypes.end()) {
+		return TreePrototypeHandle();
+	}
+
+	Entry& entry = it->second;
+	entry.last_used = ++use_counter;
+	hits++;
+	saved_bytes += entry.prototype->bytes;
+	saved_ms += entry.prototype->build_ms;
+	return entry.prototype;
+}
+
+TreePrototypeHandle TreePrototypeCache::store(const Key& key, const TreePrototypeHandle& prototype)
+{
+	misses++;
+	Entry& entry = prototypes[key];
+	entry.prototype = prototype;
+	entry.last_used = ++use_counter;
+	evictIdle();
+	return prototype;
+}
+
+void TreePrototypeCache::evictIdle()
+{
+	std::vector<std::pair<unsigned long, Key>> idle;
+	for (auto it = prototypes.begin(); it != prototypes.end(); ++it) {
+		// only the cache holds it, no tree is using it
+		if (it->second.prototype.use_count() == 1) {
+			idle.emplace_back(it->second.last_used, it->first);
+		}
+	}
+	if (idle.size() <= max_idle_prototypes) {
+		return;
+	}
+
+	// least recently used first
+	std::sort(idle.begin(), idle.end(),
+	          [](const std::pair<unsigned long, Key>& a, const std::pair<unsigned long, Key>& b) {
+		          return a.first < b.first;
+	          });
+	for (size_t i = 0; i < idle.size() - max_idle_prototypes; i++) {
+		prototypes.erase(idle[i].second);
+	}
+}
+
+void TreePrototypeCache::queue(Tree* tree)
+{
+	instances.push_back(tree);
+}
+
+void TreePrototypeCache::flush(
+		const GLuint& shader_program,
+		const glm::mat4& view_matrix,
+		const glm::mat4& projection_matrix,
+		const Light& light
+) {
+	if (instances.empty()) {
+		return;
+	}
+
+	// instances of a prototype only share a draw when they use the same texture,
+	// TreeA and TreeA_Autumn share their meshes
+	std::stable_sort(instances.begin(), instances.end(), [](Tree* a, Tree* b) {
+		if (a->getPrototype() != b->getPrototype()) return a->getPrototype() < b->getPrototype();
+		return a->getTextureLayer() < b->getTextureLayer();
+	});
+
+	instance_matrices.clear();
+	for (Tree* tree : instances) {
+		instance_matrices.push_back(tree->getModelMatrix());
+	}
+
+	if (instance_buffer == 0) {
+		glGenBuffers(1, &instance_buffer);
+	}
+	glBindBuffer(GL_ARRAY_BUFFER, instance_buffer);
+	if (instance_matrices.size() > instance_capacity) {
+		instance_capacity = std::max(instance_matrices.size(), instance_capacity * 2);
+	}
+	// orphan last frame's storage so we don't wait on the GPU still reading it
+	glBufferData(GL_ARRAY_BUFFER, instance_capacity * sizeof(glm::mat4), nullptr, GL_STREAM_DRAW);
+	glBufferSubData(GL_ARRAY_BUFFER, 0, instance_matrices.size() * sizeof(glm::mat4), instance_matrices.data());
+
+	auto use_instancing_loc = (GLuint)glGetUniformLocation(shader_program, "use_instancing");
+	auto use_leaf_instancing_loc = (GLuint)glGetUniformLocation(shader_program, "use_leaf_instancing");
+	auto view_projection_loc = (GLuint)glGetUniformLocation(shader_program, "view_projection");
+	auto instance_model = (GLuint)glGetAttribLocation(shader_program, "instance_model");
+	glm::mat4 view_projection = projection_matrix * view_matrix;
+
+	size_t first = 0;
+	while (first < instances.size()) {
+		Tree* tree = instances[first];
+		size_t last = first + 1;
+		while (last < instances.size() &&
+		       instances[last]->getPrototype() == tree->getPrototype() &&
+		       instances[last]->getTextureLayer() == tree->getTextureLayer()) {
+			last++;
+		}
+
+		// every instance shares the material, color type and texture of the first
+		tree->prepareDraw(view_matrix, projection_matrix, light);
+		glUniform1i(use_instancing_loc, true);
+		glUniformMatrix4fv(view_projection_loc, 1, GL_FALSE, glm::value_ptr(view_projection));
+
+		const TreePrototype* prototype = tree->getPrototype();
+		glBindVertexArray(prototype->vao);
+		glBindBuffer(GL_ARRAY_BUFFER, instance_buffer);
+		// a mat4 attribute takes four consecutive locations, one per column
+		for (GLuint column = 0; column < 4; column++) {
+			glEnableVertexAttribArray(instance_model + column);
+			glVertexAttribPointer(instance_model + column, 4, GL_FLOAT, GL_FALSE, sizeof(glm::mat4),
+			                      (const void*)(first * sizeof(glm::mat4) + column * sizeof(glm::vec4)));
+			glVertexAttribDivisor(instance_model + column, 1);
+		}
+
+		glDrawElementsInstanced(GL_TRIANGLES, prototype->element_count, GL_UNSIGNED_INT, nullptr,
+		                        (GLsizei)(last - first));
+
+		if (prototype->leaf_count > 0) {
+			// an instance per leaf of every tree. the tree's matrix steps once per leaf_count
+			// instances and the shader picks the leaf from the rest
+			bindLeaves(shader_program, prototype);
+			glUniform1i(use_leaf_instancing_loc, true);
+			glBindBuffer(GL_ARRAY_BUFFER, instance_buffer);
+			for (GLuint column = 0; column < 4; column++) {
+				glEnableVertexAttribArray(instance_model + column);
+				glVertexAttribPointer(instance_model + column, 4, GL_FLOAT, GL_FALSE, sizeof(glm::mat4),
+				                      (const void*)(first * sizeof(glm::mat4) + column * sizeof(glm::vec4)));
+				glVertexAttribDivisor(instance_model + column, (GLuint)prototype->leaf_count);
+			}
+			glDrawElementsInstanced(GL_TRIANGLES, 12, GL_UNSIGNED_INT, nullptr,
+			                        (GLsizei)(last - first) * prototype->leaf_count);
+			glUniform1i(use_leaf_instancing_loc, false);
+		}
+		first = last;
+	}
+
+	glUniform1i(use_instancing_loc, false);
+	glBindVertexArray(0);
+	glBindBuffer(GL_ARRAY_BUFFER, 0);
+	glUseProgram(0);
+
+	instances.clear();
+}
+
+void TreePrototypeCache::drawLeaves(const GLuint& shader_program, const TreePrototype* prototype)
+{
+	if (prototype->leaf_count == 0) {
+		return;
+	}
+
+	bindLeaves(shader_program, prototype);
+	auto instance_model = (GLuint)glGetAttribLocation(shader_program, "instance_model");
+	for (GLuint column = 0; column < 4; column++) {
+		glDisableVertexAttribArray(instance_model + column);
+	}
+	auto use_leaf_instancing_loc = (GLuint)glGetUniformLocation(shader_program, "use_leaf_instancing");
+	glUniform1i(use_leaf_instancing_loc, true);
+	glDrawElementsInstanced(GL_TRIANGLES, 12, GL_UNSIGNED_INT, nullptr, prototype->leaf_count);
+	glUniform1i(use_leaf_instancing_loc, false);
+	glBindVertexArray(0);
+	glBindBuffer(GL_ARRAY_BUFFER, 0);
+}
+
+void TreePrototypeCache::bindLeafMesh(const GLuint& shader_program)
+{
+	if (leaf_vao != 0) {
+		glBindVertexArray(leaf_vao);
+		return;
+	}
+
+	std::vector<glm::vec3> vertices;
+	std::vector<glm::vec3> normals;
+	std::vector<glm::vec2> uvs;
+	std::vector<GLuint> indices;
+	LeafAB::buildMesh(&vertices, &normals, &uvs, &indices, LeafContainerAB::textureLeafStart);
+
+	glGenVertexArrays(1, &leaf_vao);
+	glBindVertexArray(leaf_vao);
+	glGenBuffers(4, leaf_buffers);
+
+	auto position_loc = (GLuint)glGetAttribLocation(shader_program, "v_position");
+	glBindBuffer(GL_ARRAY_BUFFER, leaf_buffers[0]);
+	glBufferData(GL_ARRAY_BUFFER, vertices.size() * sizeof(glm::vec3), vertices.data(), GL_STATIC_DRAW);
+	glVertexAttribPointer(position_loc, 3, GL_FLOAT, GL_FALSE, sizeof(glm::vec3), nullptr);
+	glEnableVertexAttribArray(position_loc);
+
+	auto normal_loc = (GLuint)glGetAttribLocation(shader_program, "normal");
+	glBindBuffer(GL_ARRAY_BUFFER, leaf_buffers[1]);
+	glBufferData(GL_ARRAY_BUFFER, normals.size() * sizeof(glm::vec3), normals.data(), GL_STATIC_DRAW);
+	glVertexAttribPointer(normal_loc, 3, GL_FLOAT, GL_FALSE, sizeof(glm::vec3), nullptr);
+	glEnableVertexAttribArray(normal_loc);
+
+	auto uv_loc = (GLuint)glGetAttribLocation(shader_program, "tex_coord_in");
+	glBindBuffer(GL_ARRAY_BUFFER, leaf_buffers[2]);
+	glBufferData(GL_ARRAY_BUFFER, uvs.size() * sizeof(glm::vec2), uvs.data(), GL_STATIC_DRAW);
+	glVertexAttribPointer(uv_loc, 2, GL_FLOAT, GL_FALSE, sizeof(glm::vec2), nullptr);
+	glEnableVertexAttribArray(uv_loc);
+
+	glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, leaf_buffers[3]);
+	glBufferData(GL_ELEMENT_ARRAY_BUFFER, indices.size() * sizeof(GLuint), indices.data(), GL_STATIC_DRAW);
+}
+
+void TreePrototypeCache::bindLeaves(const GLuint& shader_program, const TreePrototype* prototype)
+{
+	bindLeafMesh(shader_program);
+	auto leaf_count_loc = (GLuint)glGetUniformLocation(shader_program, "leaf_count");
+	glUniform1i(leaf_count_loc, prototype->leaf_count);
+	// leaf_models is set to this unit in DrawableEntity::prepareDraw
+	glActiveTexture(leaf_texture_unit);
+	glBindTexture(GL_TEXTURE_BUFFER, prototype->leaf_texture);
+	glActiveTexture(GL_TEXTURE0);
+}
+
+size_t TreePrototypeCache::getPrototypeCount()
+{
+	return prototypes.size();
+}
+
+size_t TreePrototypeCache::getResidentBytes()
+{
+	size_t bytes = 0;
+	for (auto it = prototypes.begin(); it != prototypes.end(); ++it) {
+		bytes += it->second.prototype->bytes;
+	}
+	return bytes;
+}
+
+unsigned long TreePrototypeCache::getHits()
+{
+	return hits;
+}
+
+unsigned long TreePrototypeCache::getMisses()
+{
+	return misses;
+}
+
+size_t TreePrototypeCache::getSavedBytes()
+{
+	return saved_bytes;
+}
+
+double TreePrototypeCache::getSavedMilliseconds()
+{
+	return saved_ms;
+}
+
+void TreePrototypeCache::shutdown()
+{
+	instances.clear();
+	prototypes.clear();
+	glDeleteBuffers(1, &instance_buffer);
+	instance_buffer = 0;
+	glDeleteBuffers(4, leaf_buffers);
+	std::fill(leaf_buffers, leaf_buffers + 4, 0);
+	glDeleteVertexArrays(1, &leaf_vao);
+	leaf_vao = 0;
+	instance_capacity = 0;
+}
@@ -0,0 +1,130 @@
+#ifndef PROCEDURALWORLD_TREEPROTOTYPECACHE_HPP
+#define PROCEDURALWORLD_TREEPROTOTYPECACHE_HPP
+
+#ifdef __APPLE__
+#include <OpenGL/gl3.h>
+#include <OpenGL/gl3ext.h>
+#else
+#include <GL/glew.h> // include GL Extension Wrangler
+#endif
+
+#include <glm/glm.hpp>
+#include <map>
+#include <memory>
+#include <vector>
+#include <cstddef>
+
+#include "src/entities/Light.h"
+#include "src/MeshBounds.hpp"
+
+class Tree;
+
+// A generated tree mesh living on the GPU, shared by every tree with the same key.
+// Only a sliced outline of the vertices stays on the CPU, for hit box computation.
+class TreePrototype {
+public:
+	GLuint vao = 0;
+	GLuint vertex_buffer = 0;
+	GLuint element_buffer = 0;
+	GLuint normal_buffer = 0;
+	GLuint uv_buffer = 0;
+	GLsizei element_count = 0;
+	// the placement of each leaf as three rows of a mat4x3, read by the vertex shader through
+	// leaf_texture. the leaves are drawn over the shared leaf mesh
+	GLuint leaf_buffer = 0;
+	GLuint leaf_texture = 0;
+	GLsizei leaf_count = 0;
+	MeshBounds bounds;
+	// GPU and CPU memory held by this prototype
+	size_t bytes = 0;
+	// how long the generator took to build it
+	double build_ms = 0.0;
+	~TreePrototype();
+};
+
+typedef std::shared_ptr<TreePrototype> TreePrototypeHandle;
+
+// Trees that only differ by a few percent of trunk diameter or by seed look alike,
+// so they are generated once per (type, diameter step, seed class, alien, textured)
+// and drawn as instances of the same mesh with their own model matrix.
+class TreePrototypeCache {
+public:
+	// the texture unit of a prototype's leaf_texture
+	static constexpr GLenum leaf_texture_unit = GL_TEXTURE2;
+
+	struct Key {
+		char type;
+		int diameter_step;
+		int seed_class;
+		bool alien;
+		bool textured;
+		bool operator<(const Key& other) const;
+	};
+
+	static Key makeKey(const char& type, const float& trunk_diameter, const long& seed,
+	                   const bool& alien, const bool& textured);
+	// the diameter and seed a prototype for this key is generated with
+	static float getDiameter(const Key& key);
+	static int getSeed(const Key& key);
+
+	// returns an empty handle on a miss
+	static TreePrototypeHandle find(const Key& key);
+	static TreePrototypeHandle store(const Key& key, const TreePrototypeHandle& prototype);
+
+	// instances are collected while the world is drawn and drawn together in flush()
+	static void queue(Tree* tree);
+	static void flush(
+			const GLuint& shader_program,
+			const glm::mat4& view_matrix,
+			const glm::mat4& projection_matrix,
+			const Light& light
+	);
+
+	// the leaves of one tree that is drawn on its own, with the uniforms it was drawn with
+	static void drawLeaves(const GLuint& shader_program, const TreePrototype* prototype);
+
+	static size_t getPrototypeCount();
+	static size_t getResidentBytes();
+	static unsigned long getHits();
+	static unsigned long getMisses();
+	static size_t getSavedBytes();
+	static double getSavedMilliseconds();
+
+	static void shutdown();
+
+private:
+	// relative size of consecutive diameter steps, a tree is scaled by at most half of it
+	static constexpr float diameter_ratio = 1.25f;
+	// smaller diameters, 0 included, share the step of this one, see makeKey
+	static constexpr float min_diameter = 0.1f;
+	static constexpr int seed_classes = 4;
+	// unused prototypes kept around for tiles that come back into view
+	static constexpr size_t max_idle_prototypes = 16;
+
+	struct Entry {
+		TreePrototypeHandle prototype;
+		unsigned long last_used;
+	};
+	static std::map<Key, Entry> prototypes;
+	static unsigned long use_counter;
+	static unsigned long hits;
+	static unsigned long misses;
+	static size_t saved_bytes;
+	static double saved_ms;
+
+	static std::vector<Tree*> instances;
+	static std::vector<glm::mat4> instance_matrices;
+	static GLuint instance_buffer;
+	static size_t instance_capacity;
+
+	// the mesh every leaf is an instance of, see LeafAB::buildMesh
+	static GLuint leaf_vao;
+	static GLuint leaf_buffers[4];
+
+	static void evictIdle();
+	static void bindLeafMesh(const GLuint& shader_program);
+	// points leaf_models at the prototype's leaves
+	static void bindLeaves(const GLuint& shader_program, const TreePrototype* prototype);
+};
+
+#endif //PROCEDURALWORLD_TREEPROTOTYPECACHE_HPP
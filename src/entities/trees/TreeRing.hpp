@@ -0,0 +1,34 @@
+#ifndef PROCEDURALWORLD_TREERING_HPP
+#define PROCEDURALWORLD_TREERING_HPP
+
+#include <glm/glm.hpp>
+#include <cmath>
+
+//sin/cos of every point around a ring of the given size. the trunk builders ask for the same
+//handful of angles on every ring of every tree, so they are worked out once on first use
+//(thread safe static) with the same expression the builders used and kept in the same precision
+template<int points>
+class TreeRing {
+public:
+    static constexpr float itterations = 360.0f / points;
+
+    double sine[points];
+    double cosine[points];
+
+    static const TreeRing& get(){
+        static const TreeRing ring;
+        return ring;
+    }
+
+private:
+    TreeRing(){
+        for (int n = 0; n < points; n++) {
+            sine[n] = sin(glm::radians(itterations  * n));
+            cosine[n] = cos(glm::radians(itterations  * n));
+        }
+    }
+};
+
+template<int points> constexpr float TreeRing<points>::itterations;
+
+#endif //PROCEDURALWORLD_TREERING_HPP
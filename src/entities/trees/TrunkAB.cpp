@@ -1,9 +1,9 @@
 #include <cmath>
 #include "TrunkAB.hpp"
 
-bool TrunkAB::constructionFlowCounter = true;
-
-TrunkAB::TrunkAB(std::vector<glm::vec3>* trunkVertices, std::vector<glm::vec2>* trunkUVs,  const int& seed){
+TrunkAB::TrunkAB(std::vector<glm::vec3>* trunkVertices, std::vector<glm::vec2>* trunkUVs,  const int& seed,
+                 TreeBuildContext* context){
+    this->context = context;
     this->trunkVertices = trunkVertices;
     this->trunkUVs = trunkUVs;
     baseVerticesSize = trunkVertices->size();
@@ -23,24 +23,36 @@ bool TrunkAB::buildTrunk(const float& trunkDiameter, const float& lineSegments){
 int TrunkAB::buildVertices(const float& trunkDiameter, const float& lineSegments){
     //build points
     const int randomSeedValue = TreeRandom::treeRandom(trunkDiameter, seed, lineHeight);
+    const TreeRing<trunkPoints>& ring = TreeRing<trunkPoints>::get();
+    const bool hashed = TreeRandom::getMode() == TreeRandom::Mode::Hashed;
+    uint64_t jagged[3 * trunkPoints];
+    if (hashed) {
+        TreeRandom::hashBatch(TreeRandom::hash(randomSeedValue, TreeRandom::jaggednessStream), 0,
+                              jagged, 3 * trunkPoints);
+    }
     for (int y = 0; y < 3; y++) {
         for (int n = 0; n < trunkPoints; n++) {
-            int sign = -1;
-            const int jagednessRandom = randomSeedValue  * (((int)(n * 13.4) % 17) + 1 + y);
-            if (jagednessRandom % 2 == 0) sign *= -1;
-            float tempTrunkDiameter = trunkDiameter + sign * (jagednessRandom) % ((int)(ceil(trunkDiameter)))
-                                                      * jagednessFactor / (trunkDiameter);
+            float tempTrunkDiameter;
+            if (hashed) {
+                const int reach = (int)ceil(trunkDiameter);
+                tempTrunkDiameter = trunkDiameter + TreeRandom::hashRange(jagged[y * trunkPoints + n], 1 - reach, reach)
+                                                    * jagednessFactor / (trunkDiameter);
+            } else {
+                int sign = -1;
+                const int jagednessRandom = randomSeedValue  * (((int)(n * 13.4) % 17) + 1 + y);
+                if (jagednessRandom % 2 == 0) sign *= -1;
+                tempTrunkDiameter = trunkDiameter + sign * (jagednessRandom) % ((int)(ceil(trunkDiameter)))
+                                                    * jagednessFactor / (trunkDiameter);
+            }
             glm::vec3 circleEdge(
-                    tempTrunkDiameter * sin(glm::radians(itterations  * n)),
-                    lineHeight + 0, tempTrunkDiameter *  cos(glm::radians(itterations  * n)) );
+                    tempTrunkDiameter * ring.sine[n],
+                    lineHeight + 0, tempTrunkDiameter *  ring.cosine[n] );
             trunkVertices->push_back(circleEdge);
-            unsigned  long s = trunkVertices->size();
-            trunkUVs->resize(s);
-            trunkUVs->at(s - 1) = {(n) % 2, 1 - textureTrunkHeight * ((y + (!constructionFlowCounter)) % 2)};
+            trunkUVs->push_back({(n) % 2, 1 - textureTrunkHeight * ((y + (!context->constructionFlowCounter)) % 2)});
         }
         lineHeight += lineSegments;
     }
-    TrunkAB::constructionFlowCounter = !TrunkAB::constructionFlowCounter;
+    context->constructionFlowCounter = !context->constructionFlowCounter;
     return randomSeedValue;
 }
 //give both start point and end as the connection end point
@@ -12,6 +12,8 @@
 #include <vector>
 
 #include "src/TreeRandom.hpp"
+#include "TreeBuildContext.hpp"
+#include "TreeRing.hpp"
 
 #include <iostream>
 #include <cstdio>
@@ -19,8 +21,6 @@
 
 class TrunkAB{
 public:
-    static bool constructionFlowCounter;
-
     static constexpr int branchMod = 1;
     static constexpr int trunkPoints = 4;
     static constexpr float itterations = 360.0f / trunkPoints;
@@ -37,6 +37,7 @@ private:
     int baseVerticesSize = 0;
     int heightCount = 0;
     int seed = 0;
+    TreeBuildContext* context;
 
     int buildVertices(const float& trunkDiameter, const float& lineSegments);
 
@@ -44,7 +45,8 @@ public:
 
     float getLineHeight();
 
-    TrunkAB(std::vector<glm::vec3>* trunkVertices ,std::vector<glm::vec2>* trunkUVs, const int& seed);
+    TrunkAB(std::vector<glm::vec3>* trunkVertices ,std::vector<glm::vec2>* trunkUVs, const int& seed,
+            TreeBuildContext* context);
 
     static void buildConnectorElements(const int& segmentConnectStart,const int& start, const int& set, const char& lr,
                                        std::vector<GLuint>* trunkIndices, std::vector<glm::vec3>* trunkVert,
@@ -6,11 +6,11 @@
 #include <iostream>
 #include "TrunkC.hpp"
 
-bool TrunkC::constructionFlowCounter = true;
 
 TrunkC::TrunkC(std::vector<glm::vec3>* combinedVertices, std::vector<glm::vec2>* combinedUV, std::vector<glm::vec3>* combinedNormals,
                std::vector<GLuint>* combinedIndices,
-               float lineMax, float textureHeight){
+               float lineMax, float textureHeight, TreeBuildContext* context){
+    this->context = context;
     this->combinedVertices = combinedVertices;
     this->combinedNormals = combinedNormals;
     this->combinedUV = combinedUV;
@@ -42,9 +42,7 @@ float TrunkC::buildAllComponents(const float& trunkDiameter, const float& seed,
                         tempTrunkDiameter *  cos(glm::radians(itterations  * n))
                 );
                 combinedVertices->push_back(circleEdge);
-                unsigned  long s = combinedVertices->size();
-                combinedUV->resize(s);
-                combinedUV->at(s - 1) = {uCounter, 1 - textureHeight * ((y + (!TrunkC::constructionFlowCounter )) % 2) };
+                combinedUV->push_back({uCounter, 1 - textureHeight * ((y + (!context->constructionFlowCounter )) % 2) });
                 uCounter += 0.33;
             }
             lineHeight += lineSegments;
@@ -123,12 +121,12 @@ float TrunkC::buildAllComponents(const float& trunkDiameter, const float& seed,
             }
         }
         count += 3;
-        TrunkC::constructionFlowCounter = !TrunkC::constructionFlowCounter;
+        context->constructionFlowCounter = !context->constructionFlowCounter;
         if ((randomSeedValue * (count + 1)) % branchMod == 0) {
             loopInitialTrunk = false;
         }
     } while (loopInitialTrunk && lineHeight < lineMax);
-    //TrunkC::constructionFlowCounter = !TrunkC::constructionFlowCounter;
+    //context->constructionFlowCounter = !context->constructionFlowCounter;
     if (lineHeight >= lineMax)
         return -1;
     else if(!loopInitialTrunk)
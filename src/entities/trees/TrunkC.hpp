@@ -14,6 +14,7 @@
 
 
 #include "src/TreeRandom.hpp"
+#include "TreeBuildContext.hpp"
 
 class TrunkC {
     std::vector<glm::vec3>* combinedVertices;
@@ -29,11 +30,10 @@ class TrunkC {
 
     static constexpr float jagednessFactor = 0.20;
     float lineMax;
+    TreeBuildContext* context;
 public:
-    static bool constructionFlowCounter;
-
     TrunkC(std::vector<glm::vec3>* combinedVertices, std::vector<glm::vec2>* combinedUV, std::vector<glm::vec3>* combinedNormals, std::vector<GLuint>* combinedIndices, float textureHeight,
-           float lineMax);
+           float lineMax, TreeBuildContext* context);
     float buildAllComponents(const float& trunkDiameter, const float& seed, float lineHeight);
 };
 
@@ -6,165 +6,206 @@
 #endif
 
 #include <string>
+#include <cstring>
 #include <stdexcept>
 #define STB_IMAGE_IMPLEMENTATION
 #include <src/vendor/stb_image.h>
 
-static GLuint loadImage(std::string path, GLuint rock_texture);
+#include "loadTexture.hpp"
 
-GLuint loadTexture(
-	const std::string& path,
-	const GLint& min_filter,
-	const GLint& mag_filter
-) {
-	GLuint rock_texture;
-	glGenTextures(1, &rock_texture);
-	glBindTexture(GL_TEXTURE_2D, rock_texture);
-
-	//set wrapping params
-	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_MIRRORED_REPEAT);
-	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_MIRRORED_REPEAT);
-
-	//set texture filtering params
-	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, min_filter);
-	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, mag_filter);
+#ifndef GL_COMPRESSED_RGB_S3TC_DXT1_EXT
+#define GL_COMPRESSED_RGB_S3TC_DXT1_EXT 0x83F0
+#endif
+#ifndef GL_COMPRESSED_RGBA_S3TC_DXT5_EXT
+#define GL_COMPRESSED_RGBA_S3TC_DXT5_EXT 0x83F3
+#endif
 
-	//load image, create texture and generate mipmaps
-	int rock_tex_width, rock_tex_height, rock_tex_nrChannels;
+void decodeImage(
+		const std::string& path,
+		const bool vert_align_flip,
+		const bool allow_compressed,
+		DecodedImage* image
+) {
+	BakedTexture baked;
+	if (readBakedTexture(bakedTexturePath(path), &baked)
+	    && baked.flipped == vert_align_flip
+	    && (allow_compressed || !isCompressed(baked.format))) {
+		image->format = baked.format;
+		image->has_mipmaps = true;
+		image->levels.swap(baked.levels);
+		return;
+	}
 
-	unsigned char* rock_tex_data = stbi_load(
+	int width, height, channels;
+	unsigned char* data = stbi_load(
 			path.c_str(),
-			&rock_tex_width,
-			&rock_tex_height,
-			&rock_tex_nrChannels,
+			&width,
+			&height,
+			&channels,
 			0
 	);
-	if (rock_tex_data) {
-		glTexImage2D(
-				GL_TEXTURE_2D,
-				0,
-				GL_RGB,
-				rock_tex_width,
-				rock_tex_height,
-				0,
-				GL_RGB,
-				GL_UNSIGNED_BYTE,
-				rock_tex_data
-		);
-		glGenerateMipmap(GL_TEXTURE_2D);
-	} else {
+	if (!data) {
 		throw std::runtime_error("Failed to load image \'" + path + "\': ");
 	}
-	stbi_image_free(rock_tex_data);
 
-	return loadImage(path, rock_texture);
+	// grey images are widened to RGB(A) so the shaders see the same colour in
+	// every channel instead of a red texture
+	int out_channels = (channels == 2 || channels == 4) ? 4 : 3;
+	image->format = out_channels == 4 ? BAKED_RGBA8 : BAKED_RGB8;
+	image->has_mipmaps = false;
+	image->levels.resize(1);
+	BakedTextureLevel& level = image->levels.front();
+	level.width = width;
+	level.height = height;
+	level.data.resize((size_t)width * height * out_channels);
+
+	// stbi_set_flip_vertically_on_load is global state, so the flip is done here
+	// while copying out instead to keep decoding thread safe
+	for (int row = 0; row < height; row++) {
+		const unsigned char* src = data + (size_t)(vert_align_flip ? height - 1 - row : row) * width * channels;
+		unsigned char* dst = &level.data[(size_t)row * width * out_channels];
+		if (channels == out_channels) {
+			std::memcpy(dst, src, (size_t)width * channels);
+			continue;
+		}
+		for (int x = 0; x < width; x++, src += channels, dst += out_channels) {
+			dst[0] = dst[1] = dst[2] = src[0];
+			if (out_channels == 4) dst[3] = src[1];
+		}
+	}
+	stbi_image_free(data);
 }
 
+bool compressedTexturesSupported()
+{
+	GLint count = 0;
+	glGetIntegerv(GL_NUM_EXTENSIONS, &count);
+	for (GLint i = 0; i < count; i++) {
+		const char* extension = (const char*)glGetStringi(GL_EXTENSIONS, i);
+		if (extension != nullptr && std::strcmp(extension, "GL_EXT_texture_compression_s3tc") == 0) {
+			return true;
+		}
+	}
+	return false;
+}
 
+static bool isCompressed(const DecodedImage& image)
+{
+	return isCompressed(image.format);
+}
 
-GLuint loadTexture(
-		const std::string& path,
-		const GLint& min_filter,
-		const GLint& mag_filter,
-		const GLint& paramS,
-		const GLint& paramT
-) {
-	GLuint rock_texture;
-	glGenTextures(1, &rock_texture);
-	glBindTexture(GL_TEXTURE_2D, rock_texture);
+// internal format for glTexImage*/glCompressedTexImage*, also the pixel format
+// for the uncompressed ones
+static GLenum glFormat(const DecodedImage& image)
+{
+	switch (image.format) {
+		case BAKED_RGB8:
+			return GL_RGB;
+		case BAKED_RGBA8:
+			return GL_RGBA;
+		case BAKED_BC1:
+			return GL_COMPRESSED_RGB_S3TC_DXT1_EXT;
+		case BAKED_BC3:
+			return GL_COMPRESSED_RGBA_S3TC_DXT5_EXT;
+	}
+	return GL_RGB;
+}
+
+static void finishMipChain(const GLenum& target, const DecodedImage& image)
+{
+	if (image.has_mipmaps) {
+		glTexParameteri(target, GL_TEXTURE_BASE_LEVEL, 0);
+		glTexParameteri(target, GL_TEXTURE_MAX_LEVEL, image.levels.size() - 1);
+	} else {
+		glGenerateMipmap(target);
+	}
+}
 
-	//set wrapping params
-	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, paramS);
-	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, paramT);
+void uploadImage(const DecodedImage& image, const bool from_pixel_buffer)
+{
+	GLenum format = glFormat(image);
+	glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+	size_t offset = 0;
+	for (size_t i = 0; i < image.levels.size(); i++) {
+		const BakedTextureLevel& level = image.levels[i];
+		const void* data = from_pixel_buffer ? (const void*)offset : (const void*)level.data.data();
+		if (isCompressed(image)) {
+			glCompressedTexImage2D(GL_TEXTURE_2D, i, format, level.width, level.height, 0, level.data.size(), data);
+		} else {
+			glTexImage2D(GL_TEXTURE_2D, i, format, level.width, level.height, 0, format, GL_UNSIGNED_BYTE, data);
+		}
+		offset += level.data.size();
+	}
+	glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
 
-	//set texture filtering params
-	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, min_filter);
-	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, mag_filter);
+	finishMipChain(GL_TEXTURE_2D, image);
+}
 
-	return loadImage(path, rock_texture);
+void allocateImageArray(const DecodedImage& image, const GLsizei& layer_count)
+{
+	GLenum format = glFormat(image);
+	for (size_t i = 0; i < image.levels.size(); i++) {
+		const BakedTextureLevel& level = image.levels[i];
+		if (isCompressed(image)) {
+			GLsizei size = level.data.size() * layer_count;
+			glCompressedTexImage3D(GL_TEXTURE_2D_ARRAY, i, format, level.width, level.height, layer_count, 0, size, nullptr);
+		} else {
+			glTexImage3D(GL_TEXTURE_2D_ARRAY, i, format, level.width, level.height, layer_count, 0, format, GL_UNSIGNED_BYTE, nullptr);
+		}
+	}
 }
 
+void uploadImageLayer(
+		const DecodedImage& image,
+		const GLint& layer,
+		const bool from_pixel_buffer,
+		const size_t& buffer_offset
+) {
+	GLenum format = glFormat(image);
+	glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+	size_t offset = buffer_offset;
+	for (size_t i = 0; i < image.levels.size(); i++) {
+		const BakedTextureLevel& level = image.levels[i];
+		const void* data = from_pixel_buffer ? (const void*)offset : (const void*)level.data.data();
+		if (isCompressed(image)) {
+			glCompressedTexSubImage3D(GL_TEXTURE_2D_ARRAY, i, 0, 0, layer, level.width, level.height, 1, format, level.data.size(), data);
+		} else {
+			glTexSubImage3D(GL_TEXTURE_2D_ARRAY, i, 0, 0, layer, level.width, level.height, 1, format, GL_UNSIGNED_BYTE, data);
+		}
+		offset += level.data.size();
+	}
+	glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+}
 
-//reduction to the size of load texture
-static GLuint loadImage(std::string path, GLuint rock_texture){
-	//load image, create texture and generate mipmaps
-	int rock_tex_width, rock_tex_height, rock_tex_nrChannels;
+void finishImageArray(const DecodedImage& image)
+{
+	finishMipChain(GL_TEXTURE_2D_ARRAY, image);
+}
 
-	unsigned char* rock_tex_data = stbi_load(
-			path.c_str(),
-			&rock_tex_width,
-			&rock_tex_height,
-			&rock_tex_nrChannels,
-			0
-	);
-	if (rock_tex_data) {
-		glTexImage2D(
-				GL_TEXTURE_2D,
-				0,
-				GL_RGB,
-				rock_tex_width,
-				rock_tex_height,
-				0,
-				GL_RGB,
-				GL_UNSIGNED_BYTE,
-				rock_tex_data
-		);
-		glGenerateMipmap(GL_TEXTURE_2D);
-	} else {
-		throw std::runtime_error("Failed to load image \'" + path + "\': ");
+bool isSameShape(const DecodedImage& a, const DecodedImage& b)
+{
+	if (a.format != b.format || a.levels.size() != b.levels.size()) return false;
+	for (size_t i = 0; i < a.levels.size(); i++) {
+		if (a.levels[i].width != b.levels[i].width || a.levels[i].height != b.levels[i].height) return false;
 	}
-	stbi_image_free(rock_tex_data);
+	return true;
+}
 
-	return rock_texture;
+size_t imageUploadBytes(const DecodedImage& image)
+{
+	size_t bytes = 0;
+	for (const BakedTextureLevel& level : image.levels) {
+		bytes += level.data.size();
+	}
+	return bytes;
 }
 
-GLuint loadTexture(
-        const std::string& path,
-        const GLint& min_filter,
-        const GLint& mag_filter,
-        bool vert_align_flip
-) {
-    GLuint rock_texture;
-    glGenTextures(1, &rock_texture);
-    glBindTexture(GL_TEXTURE_2D, rock_texture);
-
-    //set wrapping params
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_MIRRORED_REPEAT);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_MIRRORED_REPEAT);
-
-    //set texture filtering params
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, min_filter);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, mag_filter);
-
-    //load image, create texture and generate mipmaps
-    int rock_tex_width, rock_tex_height, rock_tex_nrChannels;
-
-    stbi_set_flip_vertically_on_load(vert_align_flip);
-    unsigned char* rock_tex_data = stbi_load(
-            path.c_str(),
-            &rock_tex_width,
-            &rock_tex_height,
-            &rock_tex_nrChannels,
-            0
-    );
-	stbi_set_flip_vertically_on_load(false);
-	if (rock_tex_data) {
-        glTexImage2D(
-                GL_TEXTURE_2D,
-                0,
-                GL_RGBA,
-                rock_tex_width,
-                rock_tex_height,
-                0,
-                GL_RGBA,
-                GL_UNSIGNED_BYTE,
-                rock_tex_data
-        );
-        glGenerateMipmap(GL_TEXTURE_2D);
-    } else {
-        throw std::runtime_error("Failed to load image \'" + path + "\': ");
-    }
-    stbi_image_free(rock_tex_data);
-
-    return rock_texture;
-}
\ No newline at end of file
+size_t imageBytes(const DecodedImage& image)
+{
+	size_t bytes = imageUploadBytes(image);
+	if (image.has_mipmaps) {
+		return bytes;
+	}
+	// the generated mip chain adds roughly a third on top of the base level
+	return bytes + bytes / 3;
+}
@@ -9,28 +9,62 @@
 #endif
 
 #include <string>
+#include <vector>
+#include <cstddef>
 
-static GLuint loadImage(std::string path, GLuint rock_texture);
+#include "bakedTexture.hpp"
 
-GLuint loadTexture(
-	const std::string& path,
-	const GLint& min_filter,
-	const GLint& mag_filter
-);
+// Pixels ready for glTexImage2D/glCompressedTexImage2D, either read from a baked
+// file next to the source image or decoded from the source itself. Decoded sources
+// come as a single RGB8/RGBA8 level and need glGenerateMipmap after upload.
+struct DecodedImage {
+	BakedTextureFormat format;
+	bool has_mipmaps;
+	std::vector<BakedTextureLevel> levels;
+};
 
-GLuint loadTexture(
+// Safe to call from any thread, it does not touch GL or stb's global flip flag.
+// Prefers the baked sibling file when it matches the flip and, for compressed
+// bakes, when allow_compressed is set. Throws std::runtime_error when the image
+// can't be read.
+void decodeImage(
 		const std::string& path,
-		const GLint& min_filter,
-		const GLint& mag_filter,
-		const GLint& paramS,
-		const GLint& paramT
+		const bool vert_align_flip,
+		const bool allow_compressed,
+		DecodedImage* image
 );
 
-GLuint loadTexture(
-        const std::string& path,
-        const GLint& min_filter,
-        const GLint& mag_filter,
-        const bool vert_align_flip
+// Whether the context can take the block compressed formats bake_textures writes.
+// Must be called on the GL thread.
+bool compressedTexturesSupported();
+
+// Uploads every level into the bound GL_TEXTURE_2D. With from_pixel_buffer the
+// levels are read back to back from the start of the bound GL_PIXEL_UNPACK_BUFFER.
+void uploadImage(const DecodedImage& image, const bool from_pixel_buffer);
+
+// Allocates every level of the bound GL_TEXTURE_2D_ARRAY with room for layer_count
+// images shaped like image. No pixel buffer may be bound while doing so.
+void allocateImageArray(const DecodedImage& image, const GLsizei& layer_count);
+
+// Same as uploadImage but into one layer of the bound GL_TEXTURE_2D_ARRAY, reading
+// from buffer_offset in the bound pixel buffer when from_pixel_buffer is set.
+void uploadImageLayer(
+		const DecodedImage& image,
+		const GLint& layer,
+		const bool from_pixel_buffer,
+		const size_t& buffer_offset
 );
 
+// Generates or clamps the mip chain once every layer is in
+void finishImageArray(const DecodedImage& image);
+
+// Same format and level sizes, i.e. both fit in one texture array
+bool isSameShape(const DecodedImage& a, const DecodedImage& b);
+
+// Total bytes of all levels, i.e. what a pixel buffer has to hold
+size_t imageUploadBytes(const DecodedImage& image);
+
+// Video memory taken by the image once uploaded with its full mip chain
+size_t imageBytes(const DecodedImage& image);
+
 #endif //PROCEDURALWORLD_LOADTEXTURE_HPP
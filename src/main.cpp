@@ -24,15 +24,21 @@
 #include "glsetup.hpp"       // include gl context setup function
 #include "shaderprogram.hpp" // include the shader program compiler
 #include "src/entities/Entity.hpp"
+#include "src/entities/TransformSystem.hpp"
+#include "src/entities/TileArena.hpp"
 #include "src/entities/World.hpp"
 #include "src/entities/Player.hpp"
 #include "constants.hpp"
 #include "TreeDistributor.hpp"
 #include "src/entities/Skybox.hpp"
+#include "src/entities/TextRenderer.hpp"
+#include "src/entities/trees/TreePrototypeCache.hpp"
+#include "src/entities/Rock.hpp"
+#include "src/entities/RockB.hpp"
+#include "TextureManager.hpp"
 #include "utils.hpp"
 
 /////
-bool move_state;
 //////
 
 
@@ -125,26 +131,24 @@ void pollContinuousControls(GLFWwindow* window) {
     if (left_press && right_press) {
         left_press = right_press = false;
     }
-    if(!move_state) {
-	    float move_unit = PLAYER_MOVEMENT_SPEED * delta_time;
-        // first check compound then single movement button actions
-        if (up_press && left_press) {
-            world->movePlayerForwardLeft(getViewDirection(), up, move_unit);
-        } else if (up_press && right_press) {
-            world->movePlayerForwardRight(getViewDirection(), up, move_unit);
-        } else if (down_press && left_press) {
-            world->movePlayerBackLeft(getViewDirection(), up, move_unit);
-        } else if (down_press && right_press) {
-            world->movePlayerBackRight(getViewDirection(), up, move_unit);
-        } else if (up_press) {
-            world->movePlayerForward(getViewDirection(), up, move_unit);
-        } else if (down_press) {
-            world->movePlayerBack(getViewDirection(), up, move_unit);
-        } else if (left_press) {
-            world->movePlayerLeft(getViewDirection(), up, move_unit);
-        } else if (right_press) {
-            world->movePlayerRight(getViewDirection(), up, move_unit);
-        }
+    float move_unit = PLAYER_MOVEMENT_SPEED * delta_time;
+    // first check compound then single movement button actions
+    if (up_press && left_press) {
+        world->movePlayerForwardLeft(getViewDirection(), up, move_unit);
+    } else if (up_press && right_press) {
+        world->movePlayerForwardRight(getViewDirection(), up, move_unit);
+    } else if (down_press && left_press) {
+        world->movePlayerBackLeft(getViewDirection(), up, move_unit);
+    } else if (down_press && right_press) {
+        world->movePlayerBackRight(getViewDirection(), up, move_unit);
+    } else if (up_press) {
+        world->movePlayerForward(getViewDirection(), up, move_unit);
+    } else if (down_press) {
+        world->movePlayerBack(getViewDirection(), up, move_unit);
+    } else if (left_press) {
+        world->movePlayerLeft(getViewDirection(), up, move_unit);
+    } else if (right_press) {
+        world->movePlayerRight(getViewDirection(), up, move_unit);
     }
 }
 
@@ -328,9 +332,6 @@ int main()
         static glm::vec3 y_axis(0.0f, 1.0f, 0.0f);
 
         // Check if any events have been activated (key pressed, mouse moved etc.) and call corresponding response functions
-        /////////////
-        move_state = world->pollWorld(getViewDirection(), up, PLAYER_MOVEMENT_SPEED);
-        ////////////////
         glfwPollEvents();
 
         pollContinuousControls(window);
@@ -382,15 +383,41 @@ int main()
                 0.1f * player_scale,
                 1000000.0f * player_scale
         );
+        // swap in any textures that finished decoding since the last frame
+        TextureManager::update();
+        // carry on generating the trees of the tiles that came into view
+        world->buildTrees();
+        // every model matrix that moved since the last frame, in one pass
+        TransformSystem::update();
+
         skybox.draw(view_matrix, sky_projection_matrix, light);
 
         world->draw(view_matrix, projection_matrix, light);
+        // the trees queued by the world, one instanced draw per shared mesh
+        TreePrototypeCache::flush(shader_program, view_matrix, projection_matrix, light);
+        // every string queued by the world's Text entities, one draw per font
+        TextRenderer::flush(shader_program, view_matrix, projection_matrix);
         // Swap the screen buffers
         glfwSwapBuffers(window);
     }
 
     delete world;
 
+    std::cout << "Resident textures: " << TextureManager::getResidentCount()
+              << " (" << TextureManager::getResidentBytes() / 1024 << " KiB)" << std::endl;
+    unsigned long tree_lookups = TreePrototypeCache::getHits() + TreePrototypeCache::getMisses();
+    std::cout << "Tree prototypes: " << TreePrototypeCache::getPrototypeCount()
+              << " (" << TreePrototypeCache::getResidentBytes() / 1024 << " KiB), "
+              << TreePrototypeCache::getHits() << "/" << tree_lookups << " trees reused a mesh, saving "
+              << TreePrototypeCache::getSavedBytes() / 1024 << " KiB and "
+              << (long)TreePrototypeCache::getSavedMilliseconds() << " ms of generation" << std::endl;
+    TextRenderer::shutdown();
+    TreePrototypeCache::shutdown();
+    TileArena::shutdown();
+    Rock::shutdown();
+    RockB::shutdown();
+    TextureManager::shutdown();
+
     // Terminate GLFW, clearing any resources allocated by GLFW.
     glfwTerminate();
     return 0;
@@ -0,0 +1,88 @@
+// Offline texture baker. Writes a .pwtex file next to every image it is given,
+// holding the full mip chain, block compressed unless told otherwise. The game
+// picks these up in place of the source image when they exist.
+//
+// Usage: bake_textures [--uncompressed] [--flip] image...
+//   --uncompressed  keep RGB8/RGBA8 texels instead of BC1/BC3
+//   --flip          bake flipped vertically, for textures loaded with vert_align_flip
+//                   (the font maps)
+//
+// From bin/: ./bake_textures ../textures/*.jpg && ./bake_textures --flip ../textures/*.png
+
+#include <iostream>
+#include <string>
+#include <vector>
+#include <stdexcept>
+
+#define STB_IMAGE_IMPLEMENTATION
+#include <src/vendor/stb_image.h>
+
+#include "../bakedTexture.hpp"
+
+int main(int argc, char** argv)
+{
+	bool compress = true;
+	bool flip = false;
+	std::vector<std::string> paths;
+
+	for (int i = 1; i < argc; i++) {
+		std::string arg = argv[i];
+		if (arg == "--uncompressed") {
+			compress = false;
+		} else if (arg == "--flip") {
+			flip = true;
+		} else {
+			paths.push_back(arg);
+		}
+	}
+
+	if (paths.empty()) {
+		std::cerr << "Usage: " << argv[0] << " [--uncompressed] [--flip] image..." << std::endl;
+		return 1;
+	}
+
+	stbi_set_flip_vertically_on_load(flip);
+
+	int failures = 0;
+	for (const std::string& path : paths) {
+		int width, height, channels;
+		unsigned char* data = stbi_load(path.c_str(), &width, &height, &channels, 0);
+		if (!data) {
+			std::cerr << "Failed to load image '" << path << "': " << stbi_failure_reason() << std::endl;
+			failures++;
+			continue;
+		}
+
+		bool alpha = channels == 2 || channels == 4;
+		BakedTextureFormat format;
+		if (compress) {
+			format = alpha ? BAKED_BC3 : BAKED_BC1;
+		} else {
+			format = alpha ? BAKED_RGBA8 : BAKED_RGB8;
+		}
+
+		BakedTexture texture;
+		texture.flipped = flip;
+		bakeMipChain(data, width, height, channels, format, &texture);
+		stbi_image_free(data);
+
+		size_t bytes = 0;
+		for (const BakedTextureLevel& level : texture.levels) {
+			bytes += level.data.size();
+		}
+
+		std::string out_path = bakedTexturePath(path);
+		try {
+			writeBakedTexture(out_path, texture);
+		} catch (const std::runtime_error& e) {
+			std::cerr << e.what() << std::endl;
+			failures++;
+			continue;
+		}
+
+		std::cout << out_path << ": " << width << "x" << height << ", " << texture.levels.size()
+		          << " levels, " << bytes / 1024 << " KiB" << std::endl;
+	}
+
+	return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,180 @@
+// Hit box benchmark. Covers a 3 x 3 block of tiles in tree clusters laid out like TreeC's (about
+// a dozen small boxes, up to a tile and a bit around each cluster's center), then times the same
+// queries against every box one after the other, as the tiles used to, and against a HitBoxGrid.
+// Also times what a tile swap costs the grid: taking one tile's boxes out and putting them back.
+//
+// Usage: bench_hitboxes [clusters_per_tile...]
+//   defaults to 5 20 60, 60 being a dense forest tile
+//
+// From bin/: ./bench_hitboxes
+
+#include <glm/glm.hpp>
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <vector>
+#include <random>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <algorithm>
+
+#include "../HitBox2d.hpp"
+#include "../HitBoxGrid.hpp"
+
+namespace {
+
+typedef std::chrono::steady_clock Clock;
+
+const int tiles_per_side = 3;
+const int query_count = 200000;
+const float query_span = 0.01f;
+const int runs = 5;
+const int swaps = 100;
+
+// TreeC item boxes, as measured on generated clusters
+const int min_items = 8;
+const int max_items = 16;
+const float min_item_span = 0.015f;
+const float max_item_span = 0.03f;
+const float max_item_distance = 1.3f;
+
+double millisecondsSince(const Clock::time_point& start)
+{
+	return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+}
+
+std::vector<HitBox2d> makeTile(const int& x, const int& z, const int& clusters, std::mt19937& random)
+{
+	std::uniform_real_distribution<float> unit(0.0f, 1.0f);
+	std::uniform_int_distribution<int> items(min_items, max_items);
+	std::vector<HitBox2d> boxes;
+
+	for (int c = 0; c < clusters; c++) {
+		const float center_x = x + unit(random);
+		const float center_z = z + unit(random);
+		const int count = items(random);
+		for (int i = 0; i < count; i++) {
+			const float angle = unit(random) * 6.2831853f;
+			const float distance = unit(random) * max_item_distance;
+			const float span = min_item_span + unit(random) * (max_item_span - min_item_span);
+			boxes.emplace_back(
+				center_x + distance * std::cos(angle) - span / 2,
+				center_z + distance * std::sin(angle) - span / 2,
+				span,
+				span
+			);
+		}
+	}
+	return boxes;
+}
+
+bool scanCollides(const std::vector<std::vector<HitBox2d>>& tiles, const HitBox2d& box)
+{
+	for (const std::vector<HitBox2d>& tile : tiles) {
+		for (const HitBox2d& hb : tile) {
+			if (hb.collidesWith(box)) {
+				return true;
+			}
+		}
+	}
+	return false;
+}
+
+// false if the grid and the scan disagree on any query
+bool bench(const int& clusters)
+{
+	std::mt19937 random(7);
+	std::vector<std::vector<HitBox2d>> tiles;
+	HitBoxGrid grid;
+	size_t box_count = 0;
+	for (int z = 0; z < tiles_per_side; z++) {
+		for (int x = 0; x < tiles_per_side; x++) {
+			tiles.push_back(makeTile(x, z, clusters, random));
+			box_count += tiles.back().size();
+		}
+	}
+
+	Clock::time_point start = Clock::now();
+	for (const std::vector<HitBox2d>& tile : tiles) {
+		for (const HitBox2d& box : tile) {
+			grid.insert(box, &tile);
+		}
+	}
+	const double build_ms = millisecondsSince(start);
+
+	std::uniform_real_distribution<float> position(0.0f, (float)tiles_per_side);
+	std::vector<HitBox2d> queries;
+	for (int i = 0; i < query_count; i++) {
+		queries.emplace_back(position(random), position(random), query_span, query_span);
+	}
+
+	double scan_ms = 0, grid_ms = 0;
+	size_t scan_hits = 0, grid_hits = 0;
+	for (int r = 0; r < runs; r++) {
+		scan_hits = 0;
+		start = Clock::now();
+		for (const HitBox2d& query : queries) {
+			scan_hits += scanCollides(tiles, query);
+		}
+		const double scan_run = millisecondsSince(start);
+
+		grid_hits = 0;
+		start = Clock::now();
+		for (const HitBox2d& query : queries) {
+			grid_hits += grid.collidesWith(query);
+		}
+		const double grid_run = millisecondsSince(start);
+
+		scan_ms = r == 0 ? scan_run : std::min(scan_ms, scan_run);
+		grid_ms = r == 0 ? grid_run : std::min(grid_ms, grid_run);
+	}
+
+	// the middle tile, the one with the most cells shared with its neighbours
+	const std::vector<HitBox2d>& swapped = tiles[tiles.size() / 2];
+	start = Clock::now();
+	for (int s = 0; s < swaps; s++) {
+		grid.remove(&swapped);
+		for (const HitBox2d& box : swapped) {
+			grid.insert(box, &swapped);
+		}
+	}
+	const double swap_ms = millisecondsSince(start) / swaps;
+
+	std::cout << std::fixed << std::setprecision(1)
+	          << clusters << " clusters/tile: " << box_count << " boxes in " << grid.getCellCount() << " cells"
+	          << ", scan " << scan_ms << " ms, grid " << grid_ms << " ms (" << scan_ms / grid_ms << "x)"
+	          << ", " << grid_hits << " of " << query_count << " hit"
+	          << std::setprecision(3) << ", build " << build_ms << " ms, tile swap " << swap_ms << " ms"
+	          << std::endl;
+
+	if (scan_hits != grid_hits) {
+		std::cerr << "The grid found " << grid_hits << " hits, the scan " << scan_hits << std::endl;
+		return false;
+	}
+	return true;
+}
+
+}
+
+int main(int argc, char** argv)
+{
+	std::vector<int> cluster_counts;
+	for (int i = 1; i < argc; i++) {
+		const int clusters = std::atoi(argv[i]);
+		if (clusters <= 0) {
+			std::cerr << "Usage: " << argv[0] << " [clusters_per_tile...]" << std::endl;
+			return 1;
+		}
+		cluster_counts.push_back(clusters);
+	}
+	if (cluster_counts.empty()) {
+		cluster_counts = {5, 20, 60};
+	}
+
+	bool agree = true;
+	for (const int& clusters : cluster_counts) {
+		agree = bench(clusters) && agree;
+	}
+	return agree ? 0 : 1;
+}
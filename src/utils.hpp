@@ -8,6 +8,7 @@
 #include <glm/glm.hpp>
 #include <glm/gtc/type_ptr.hpp>
 #include <cstdlib>
+#include <cstdint>
 
 namespace utils {
 	// https://stackoverflow.com/a/30099727
@@ -26,6 +27,17 @@ namespace utils {
 		return float(r * (max - min) + min);
 	}
 
+	// the bits of both coordinates mixed (splitmix64's finaliser) down to 32, the same for the same place
+	inline uint32_t hashLocation(const float &x, const float &z) {
+		union { float f; uint32_t u; } a, b;
+		a.f = x;
+		b.f = z;
+		uint64_t h = ((uint64_t) a.u << 32) | b.u;
+		h = (h ^ (h >> 30)) * 0xBF58476D1CE4E5B9ULL;
+		h = (h ^ (h >> 27)) * 0x94D049BB133111EBULL;
+		return (uint32_t) (h ^ (h >> 31));
+	}
+
 	inline glm::vec3 getTranslationVector(const glm::mat4 &transform_matrix) {
 		const float *t = glm::value_ptr(transform_matrix);
 		return glm::vec3(t[12], t[13], t[14]);